@@ -4,14 +4,14 @@
 #include <string>
 #include <iostream>
 #include <list>
-#include "PKB.h"
+#include "QueryService.h"
 
 // include your other headers here
 #include "AbstractWrapper.h"
 
 class TestWrapper : public AbstractWrapper {
  public:
-     shared_ptr<PKB> pkb;
+     QueryService queryService;
 
   // default constructor
   TestWrapper();
@@ -13,6 +13,7 @@ void PKBStub::resetCounts() {
 }
 
 PKBStub::PKBStub() {
+	this->statistics = make_shared<StatisticsCatalog>();
 	this->resetCounts();
 }
 
@@ -125,6 +126,10 @@ string PKBStub::getNameFromStmtNum(string stmtNum) {
 	return this->stringValues.at(this->stringCount++);
 }
 
+shared_ptr<StatisticsCatalog> PKBStub::getStatistics() {
+	return this->statistics;
+}
+
 // setter methods to set the return values for each different test case
 void PKBStub::addBooleanResult(bool value) {
 	this->boolReturnValues.push_back(value);
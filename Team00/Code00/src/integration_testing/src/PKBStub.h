@@ -25,6 +25,8 @@ public:
 	vector<string> stringValues;
 	int stringCount;
 
+	shared_ptr<StatisticsCatalog> statistics;
+
 	// original api being stubbed
 
 	unordered_set<string> getEntities(const EntityType& type);
@@ -63,6 +65,8 @@ public:
 
 	string getNameFromStmtNum(string stmtNum);
 
+	shared_ptr<StatisticsCatalog> getStatistics();
+
 	// Methods to add the return values for each different test case
 	void addBooleanResult(bool value);
 
@@ -0,0 +1,94 @@
+// Synthetic SIMPLE program generator: writes a program of a given size and shape, and stress queries for it.
+//
+// usage: simple_gen [--seed <n>] [--statements <n>] [--procedures <n>] [--depth <n>] [--loops <p>]
+//                   [--branches <p>] [--calls chain|fanout|diamond] [--expression <n>] [--variables <n>]
+//                   [--queries <n>] [--output <prefix>]
+//
+// The program is written to <prefix>_source.txt and the queries to <prefix>_queries.txt, in the format of the
+// autotester, with empty expected answers. Without --output, only the program is written, to stdout.
+// The same arguments always give the same files.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "SimpleProgramGenerator.h"
+
+using namespace std;
+
+namespace {
+	void printUsage() {
+		cerr << "usage: simple_gen [--seed <n>] [--statements <n>] [--procedures <n>] [--depth <n>] [--loops <p>]"
+			<< " [--branches <p>] [--calls chain|fanout|diamond] [--expression <n>] [--variables <n>]"
+			<< " [--queries <n>] [--output <prefix>]" << endl;
+	}
+}
+
+int main(int argc, char** argv) {
+	GeneratorOptions options;
+	string outputPrefix;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		if (i + 1 >= argc) {
+			printUsage();
+			return 1;
+		}
+		string value = argv[++i];
+		if (argument == "--seed") {
+			options.seed = (unsigned int) strtoul(value.c_str(), nullptr, 10);
+		}
+		else if (argument == "--statements") {
+			options.statementCount = atoi(value.c_str());
+		}
+		else if (argument == "--procedures") {
+			options.procedureCount = atoi(value.c_str());
+		}
+		else if (argument == "--depth") {
+			options.maxNestingDepth = atoi(value.c_str());
+		}
+		else if (argument == "--loops") {
+			options.loopDensity = atof(value.c_str());
+		}
+		else if (argument == "--branches") {
+			options.branchDensity = atof(value.c_str());
+		}
+		else if (argument == "--expression") {
+			options.expressionLength = atoi(value.c_str());
+		}
+		else if (argument == "--variables") {
+			options.variableCount = atoi(value.c_str());
+		}
+		else if (argument == "--queries") {
+			options.queryCount = atoi(value.c_str());
+		}
+		else if (argument == "--output") {
+			outputPrefix = value;
+		}
+		else if (argument == "--calls" && (value == "chain" || value == "fanout" || value == "diamond")) {
+			options.callGraphShape = value == "chain" ? CallGraphShape::CHAIN
+				: value == "fanout" ? CallGraphShape::FAN_OUT : CallGraphShape::DIAMOND;
+		}
+		else {
+			printUsage();
+			return 1;
+		}
+	}
+
+	SimpleProgramGenerator generator(options);
+	if (outputPrefix.empty()) {
+		generator.writeProgram(cout);
+		return 0;
+	}
+
+	ofstream source((outputPrefix + "_source.txt").c_str());
+	ofstream queries((outputPrefix + "_queries.txt").c_str());
+	if (!source || !queries) {
+		cerr << "Cannot open the File : " << outputPrefix << "_source.txt" << endl;
+		return 1;
+	}
+	generator.writeProgram(source);
+	generator.writeQueries(queries, generator.getStatementCount());
+	cerr << "wrote " << generator.getStatementCount() << " statements and " << options.queryCount << " queries" << endl;
+	return 0;
+}
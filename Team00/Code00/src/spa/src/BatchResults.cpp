@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <limits>
+
+#include "BatchResults.h"
+#include "QueryOptimizer.h"
+
+double BatchStatistics::getQueriesPerSecond() const {
+	return this->elapsedSeconds <= 0 ? 0 : this->queryCount / this->elapsedSeconds;
+}
+
+BatchResults::BatchResults() {
+	this->aClauseResults = make_shared<ClauseResultCache>(numeric_limits<size_t>::max());
+}
+
+string BatchResults::getGroupKey(const vector<shared_ptr<OptionalClause>>& clauses, unordered_map<string, string>& canonicalNames,
+	const bool& isExistential) {
+	// clauses are named in the order of their own keys, so the evaluation order of the group does not matter
+	vector<pair<string, shared_ptr<OptionalClause>>> keyedClauses;
+	for (shared_ptr<OptionalClause> clause : clauses) {
+		string clauseKey = ClauseResultCache::getClauseKey(clause);
+		if (clauseKey.empty()) {
+			return "";
+		}
+		keyedClauses.push_back({ clauseKey, clause });
+	}
+	stable_sort(keyedClauses.begin(), keyedClauses.end(),
+		[](const pair<string, shared_ptr<OptionalClause>>& left, const pair<string, shared_ptr<OptionalClause>>& right) {
+			return left.first < right.first;
+		});
+
+	string key = isExistential ? "E" : "G";
+	canonicalNames.clear();
+	for (auto& keyedClause : keyedClauses) {
+		key += keyedClause.first + "[";
+		for (shared_ptr<QueryInput> input : { keyedClause.second->getLeftInput(), keyedClause.second->getRightInput() }) {
+			if (input->getQueryInputType() == QueryInputType::DECLARATION) {
+				auto it = canonicalNames.find(input->getValue());
+				if (it == canonicalNames.end()) {
+					it = canonicalNames.insert({ input->getValue(), "$" + to_string(canonicalNames.size()) }).first;
+				}
+				key += it->second;
+			}
+			key += ",";
+		}
+		key += "];";
+	}
+	return key;
+}
+
+void BatchResults::findSharedPieces(const vector<shared_ptr<Query>>& queries) {
+	unordered_map<string, int> clauseCounts;
+	unordered_map<string, int> groupCounts;
+	for (shared_ptr<Query> query : queries) {
+		vector<shared_ptr<OptionalClause>> clauses = query->getOptionalClauses();
+		for (shared_ptr<OptionalClause> clause : clauses) {
+			clauseCounts[ClauseResultCache::getClauseKey(clause)]++;
+		}
+
+		// groups only depend on the synonyms of the clauses, so they are known before evaluation
+		vector<string> selectedSynonyms = query->getSelectClause()->getSynonyms();
+		for (auto& group : QueryOptimizer::sortClausesIntoGroups(clauses)) {
+			bool isExistential = true;
+			for (shared_ptr<OptionalClause> clause : group) {
+				for (shared_ptr<QueryInput> input : { clause->getLeftInput(), clause->getRightInput() }) {
+					if (input->getQueryInputType() == QueryInputType::DECLARATION &&
+						find(selectedSynonyms.begin(), selectedSynonyms.end(), input->getValue()) != selectedSynonyms.end()) {
+						isExistential = false;
+					}
+				}
+			}
+			unordered_map<string, string> canonicalNames;
+			groupCounts[getGroupKey(group, canonicalNames, isExistential)]++;
+		}
+	}
+
+	for (auto& entry : clauseCounts) {
+		if (entry.second > 1 && !entry.first.empty()) {
+			this->aSharedClauseKeys.insert(entry.first);
+		}
+	}
+	for (auto& entry : groupCounts) {
+		if (entry.second > 1 && !entry.first.empty()) {
+			this->aSharedGroupKeys.insert(entry.first);
+		}
+	}
+}
+
+bool BatchResults::lookupClause(shared_ptr<OptionalClause> clause, bool& hasResults) {
+	if (this->aSharedClauseKeys.find(ClauseResultCache::getClauseKey(clause)) == this->aSharedClauseKeys.end()) {
+		return false;
+	}
+	bool isFound = this->aClauseResults->lookup(clause, hasResults);
+	if (isFound) {
+		this->aReusedClauseCount++;
+	}
+	return isFound;
+}
+
+void BatchResults::storeClause(shared_ptr<OptionalClause> clause, const bool& hasResults) {
+	if (this->aSharedClauseKeys.find(ClauseResultCache::getClauseKey(clause)) != this->aSharedClauseKeys.end()) {
+		this->aClauseResults->store(clause, hasResults);
+	}
+}
+
+bool BatchResults::lookupGroup(const vector<shared_ptr<OptionalClause>>& clauses, const bool& isExistential,
+	shared_ptr<ResultsTable>& table) {
+	unordered_map<string, string> canonicalNames;
+	auto it = this->aGroupResults.find(getGroupKey(clauses, canonicalNames, isExistential));
+	if (it == this->aGroupResults.end()) {
+		return false;
+	}
+
+	unordered_map<string, string> queryNames;
+	for (auto& entry : canonicalNames) {
+		queryNames[entry.second] = entry.first;
+	}
+	table = renameSynonyms(it->second, queryNames);
+	this->aReusedGroupCount++;
+	return true;
+}
+
+void BatchResults::storeGroup(const vector<shared_ptr<OptionalClause>>& clauses, const bool& isExistential,
+	shared_ptr<ResultsTable> table) {
+	unordered_map<string, string> canonicalNames;
+	string key = getGroupKey(clauses, canonicalNames, isExistential);
+	if (this->aSharedGroupKeys.find(key) != this->aSharedGroupKeys.end()) {
+		this->aGroupResults[key] = renameSynonyms(table, canonicalNames);
+	}
+}
+
+shared_ptr<ResultsTable> BatchResults::renameSynonyms(shared_ptr<ResultsTable> table, const unordered_map<string, string>& names) {
+	shared_ptr<ResultsTable> renamedTable = make_shared<ResultsTable>();
+	if (table->isNoResult()) {
+		renamedTable->setIsNoResult();
+		return renamedTable;
+	}
+	unordered_map<string, int> synonymIndex;
+	for (auto& entry : table->getSynonymIndexMap()) {
+		auto it = names.find(entry.first);
+		synonymIndex[it == names.end() ? entry.first : it->second] = entry.second;
+	}
+	renamedTable->setTable(move(synonymIndex), table->getTableValues());
+	return renamedTable;
+}
+
+int BatchResults::getSharedClauseCount() {
+	return this->aSharedClauseKeys.size();
+}
+
+int BatchResults::getSharedGroupCount() {
+	return this->aSharedGroupKeys.size();
+}
+
+int BatchResults::getReusedClauseCount() {
+	return this->aReusedClauseCount;
+}
+
+int BatchResults::getReusedGroupCount() {
+	return this->aReusedGroupCount;
+}
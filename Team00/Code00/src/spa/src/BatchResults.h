@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "OptionalClause.h"
+#include "ResultsTable.h"
+#include "ClauseResultCache.h"
+#include "Query.h"
+
+using namespace std;
+
+struct BatchStatistics {
+	int queryCount = 0;
+	int validQueryCount = 0;
+	int clauseCount = 0; // clauses in all valid queries
+	int sharedClauseCount = 0; // distinct clauses occurring more than once in the batch
+	int sharedGroupCount = 0; // distinct clause groups occurring more than once in the batch
+	int reusedClauseCount = 0; // clauses answered from an earlier query of the batch
+	int reusedGroupCount = 0; // clause groups answered from an earlier query of the batch
+	int timedOutQueryCount = 0; // valid queries stopped at the timeout, left without answers
+	int overBudgetQueryCount = 0; // valid queries stopped at their memory budget, left without answers
+	double elapsedSeconds = 0;
+
+	double getQueriesPerSecond() const;
+};
+
+// results of the clauses and clause groups that several queries of a batch have in common.
+// Each shared piece is evaluated by the first query using it and handed to the other queries.
+// Not safe to share between threads.
+class BatchResults {
+private:
+	unordered_set<string> aSharedClauseKeys;
+	unordered_set<string> aSharedGroupKeys;
+	shared_ptr<ClauseResultCache> aClauseResults;
+	unordered_map<string, shared_ptr<ResultsTable>> aGroupResults; // columns named by canonical synonyms
+	int aReusedClauseCount = 0;
+	int aReusedGroupCount = 0;
+
+	static shared_ptr<ResultsTable> renameSynonyms(shared_ptr<ResultsTable> table, const unordered_map<string, string>& names);
+
+public:
+	BatchResults();
+
+	/**
+	* Builds the key of a group of connected clauses, the same for groups differing only in synonym names
+	*
+	* @param canonicalNames set to the canonical name of each synonym in the group
+	* @param isExistential whether only the existence of results is needed
+	*/
+	static string getGroupKey(const vector<shared_ptr<OptionalClause>>& clauses, unordered_map<string, string>& canonicalNames,
+		const bool& isExistential);
+
+	// finds the clauses and clause groups occurring in more than one of the queries
+	void findSharedPieces(const vector<shared_ptr<Query>>& queries);
+
+	bool lookupClause(shared_ptr<OptionalClause> clause, bool& hasResults);
+
+	// only clauses shared with another query are kept
+	void storeClause(shared_ptr<OptionalClause> clause, const bool& hasResults);
+
+	/**
+	* Finds the merged results of an equivalent group evaluated by an earlier query
+	*
+	* @param table set to the results, with columns named by the synonyms of the given group
+	*/
+	bool lookupGroup(const vector<shared_ptr<OptionalClause>>& clauses, const bool& isExistential, shared_ptr<ResultsTable>& table);
+
+	// only groups shared with another query are kept
+	void storeGroup(const vector<shared_ptr<OptionalClause>>& clauses, const bool& isExistential, shared_ptr<ResultsTable> table);
+
+	int getSharedClauseCount();
+	int getSharedGroupCount();
+	int getReusedClauseCount();
+	int getReusedGroupCount();
+};
@@ -0,0 +1,11 @@
+#include "BindingOperator.h"
+
+BindingOperator::BindingOperator(size_t batchSize) {
+	this->aBatchSize = batchSize == 0 ? 1 : batchSize;
+}
+
+vector<string> BindingOperator::getColumns() {
+	return this->aColumns;
+}
+
+BindingOperator::~BindingOperator() {}
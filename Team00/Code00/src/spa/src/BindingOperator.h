@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// operator of the pipelined evaluator, pulled for rows of synonym bindings in batches
+class BindingOperator {
+protected:
+	vector<string> aColumns; // synonym of each value in a row
+	size_t aBatchSize;
+
+public:
+	BindingOperator(size_t batchSize);
+
+	vector<string> getColumns();
+
+	// replaces batch with at most the batch size of the next rows, returns false once there are no rows left
+	virtual bool next(vector<vector<string>>& batch) = 0;
+
+	virtual ~BindingOperator();
+};
@@ -0,0 +1,64 @@
+#include "CancellationToken.h"
+
+thread_local shared_ptr<CancellationToken> CancellationToken::aCurrent;
+thread_local unsigned int CancellationToken::aCheckCount = 0;
+
+CancellationToken::CancellationToken() {
+}
+
+void CancellationToken::setTimeout(int milliseconds) {
+	this->hasDeadline = milliseconds > 0;
+	this->aDeadline = chrono::steady_clock::now() + chrono::milliseconds(milliseconds);
+}
+
+void CancellationToken::setStopFlag(const volatile bool* stopFlag) {
+	this->aStopFlag = stopFlag;
+}
+
+void CancellationToken::cancel() {
+	this->isCancelRequested = true;
+}
+
+bool CancellationToken::isCancelled() {
+	if (this->isCancelRequested || (this->aStopFlag != nullptr && *this->aStopFlag)) {
+		return true;
+	}
+	if (this->hasDeadline && chrono::steady_clock::now() >= this->aDeadline) {
+		this->isCancelRequested = true;
+		return true;
+	}
+	return false;
+}
+
+void CancellationToken::check() {
+	if (isCancelled()) {
+		throw QueryTimeoutException("timeout");
+	}
+}
+
+shared_ptr<CancellationToken> CancellationToken::getCurrent() {
+	return aCurrent;
+}
+
+void CancellationToken::checkCurrent() {
+	CancellationToken* token = aCurrent.get();
+	if (token == nullptr) {
+		return;
+	}
+	// reading the clock costs more than the flags, so the deadline is only compared every few checks
+	if (++aCheckCount % CLOCK_CHECK_INTERVAL == 0) {
+		token->check();
+	}
+	else if (token->isCancelRequested || (token->aStopFlag != nullptr && *token->aStopFlag)) {
+		throw QueryTimeoutException("timeout");
+	}
+}
+
+CancellationToken::Scope::Scope(shared_ptr<CancellationToken> token) {
+	this->aPrevious = aCurrent;
+	aCurrent = token;
+}
+
+CancellationToken::Scope::~Scope() {
+	aCurrent = this->aPrevious;
+}
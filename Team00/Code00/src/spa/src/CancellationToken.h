@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include "QueryTimeoutException.h"
+
+using namespace std;
+
+// Cooperative cancellation of one query or program load. Long loops call checkCurrent, which throws
+// QueryTimeoutException once the token of the thread is cancelled, its deadline has passed or its stop flag is set.
+// A token may be checked from several threads at once, such as the workers of a parallel join.
+class CancellationToken {
+private:
+	atomic<bool> isCancelRequested{ false };
+	bool hasDeadline = false;
+	chrono::steady_clock::time_point aDeadline;
+	const volatile bool* aStopFlag = nullptr;
+
+	static thread_local shared_ptr<CancellationToken> aCurrent;
+	static thread_local unsigned int aCheckCount;
+
+public:
+	// checks between which the clock is not read, the flags are read on every check
+	static const unsigned int CLOCK_CHECK_INTERVAL = 64;
+
+	CancellationToken();
+
+	CancellationToken(const CancellationToken&) = delete;
+
+	CancellationToken& operator=(const CancellationToken&) = delete;
+
+	// the deadline is the given time from now, 0 or less removes it
+	void setTimeout(int milliseconds);
+
+	// a flag set by someone else to stop all work, such as AbstractWrapper::GlobalStop
+	void setStopFlag(const volatile bool* stopFlag);
+
+	void cancel();
+
+	bool isCancelled();
+
+	// @throws QueryTimeoutException if the token is cancelled
+	void check();
+
+	// token that checkCurrent checks on this thread, or nullptr if work on this thread cannot be cancelled
+	static shared_ptr<CancellationToken> getCurrent();
+
+	/**
+	* Checks the current token of this thread, if there is one
+	*
+	* @throws QueryTimeoutException if the token is cancelled
+	*/
+	static void checkCurrent();
+
+	// makes a token current on this thread until the end of the scope
+	class Scope {
+	private:
+		shared_ptr<CancellationToken> aPrevious;
+
+	public:
+		Scope(shared_ptr<CancellationToken> token);
+
+		Scope(const Scope&) = delete;
+
+		Scope& operator=(const Scope&) = delete;
+
+		~Scope();
+	};
+};
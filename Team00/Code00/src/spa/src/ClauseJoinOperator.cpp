@@ -0,0 +1,196 @@
+#include <algorithm>
+
+#include "ClauseJoinOperator.h"
+#include "CancellationToken.h"
+
+ClauseJoinOperator::ClauseJoinOperator(shared_ptr<BindingOperator> input, shared_ptr<OptionalClause> clause, size_t batchSize)
+	: BindingOperator(batchSize) {
+	this->aInput = input;
+	this->aClause = clause;
+	this->aColumns = input->getColumns();
+	vector<string> synonyms = clause->getResultSynonyms();
+
+	switch (clause->getClauseResultType()) {
+	case ClauseResultType::SET:
+		this->isSet = synonyms.size() == 1 || synonyms.at(0) == synonyms.at(1);
+		if (this->isSet) {
+			this->aSetResult = &clause->getSetResult();
+			synonyms.resize(1);
+		}
+		else { // eg. with v1 = v2, values common to both synonyms are paired with themselves
+			for (const string& value : clause->getSetResult()) {
+				this->aDerivedMapResult[value].insert(value);
+			}
+			this->aReservation.add(2 * this->aDerivedMapResult.size() * MemoryBudget::estimateStringBytes(0));
+			this->aMapResult = &this->aDerivedMapResult;
+		}
+		break;
+
+	case ClauseResultType::MAP:
+		this->isSet = synonyms.at(0) == synonyms.at(1);
+		if (this->isSet) { // eg. Next*(n, n), only the pairs of a value with itself
+			for (auto& entry : clause->getMapResult()) {
+				if (entry.second.find(entry.first) != entry.second.end()) {
+					this->aDerivedSetResult.insert(entry.first);
+				}
+			}
+			this->aReservation.add(this->aDerivedSetResult.size() * MemoryBudget::estimateStringBytes(0));
+			this->aSetResult = &this->aDerivedSetResult;
+			synonyms.pop_back();
+		}
+		else {
+			this->aMapResult = &clause->getMapResult();
+		}
+		break;
+
+	default: // boolean clauses pass their input through when true
+		this->isSet = true;
+		synonyms.clear();
+		break;
+	}
+	this->isEmpty = clause->getClauseResultType() == ClauseResultType::BOOL
+		? !clause->getBoolResult()
+		: this->isSet ? this->aSetResult->empty() : this->aMapResult->empty();
+
+	this->aLeftIndex = -1;
+	this->aRightIndex = -1;
+	for (size_t i = 0; i < synonyms.size(); i++) {
+		auto it = find(this->aColumns.begin(), this->aColumns.end(), synonyms.at(i));
+		int index = it == this->aColumns.end() ? -1 : it - this->aColumns.begin();
+		(i == 0 ? this->aLeftIndex : this->aRightIndex) = index;
+	}
+	for (size_t i = 0; i < synonyms.size(); i++) {
+		if ((i == 0 ? this->aLeftIndex : this->aRightIndex) == -1) {
+			this->aColumns.push_back(synonyms.at(i));
+		}
+	}
+	if (clause->getClauseResultType() == ClauseResultType::BOOL) {
+		this->aLeftIndex = -2; // nothing to look up
+	}
+}
+
+const unordered_set<string>& ClauseJoinOperator::findValues(const unordered_map<string, unordered_set<string>>& map, const string& key) {
+	static const unordered_set<string> noValues;
+	auto it = map.find(key);
+	return it == map.end() ? noValues : it->second;
+}
+
+// prepares the matches of an input row, returns false if the row has no matches
+bool ClauseJoinOperator::startRow(const vector<string>& row) {
+	this->isPairScan = false;
+	this->aValues = nullptr;
+
+	if (this->aLeftIndex == -2) { // boolean clause
+		return true;
+	}
+	if (this->isSet) {
+		if (this->aLeftIndex >= 0) {
+			return this->aSetResult->find(row.at(this->aLeftIndex)) != this->aSetResult->end();
+		}
+		this->aValues = this->aSetResult;
+	}
+	else if (this->aLeftIndex >= 0 && this->aRightIndex >= 0) {
+		const unordered_set<string>& values = findValues(*this->aMapResult, row.at(this->aLeftIndex));
+		return values.find(row.at(this->aRightIndex)) != values.end();
+	}
+	else if (this->aLeftIndex >= 0) {
+		this->aValues = &findValues(*this->aMapResult, row.at(this->aLeftIndex));
+	}
+	else if (this->aRightIndex >= 0) {
+		if (this->aReverseMapResult.empty()) {
+			size_t stringCount = 0;
+			for (auto& entry : *this->aMapResult) {
+				for (const string& value : entry.second) {
+					this->aReverseMapResult[value].insert(entry.first);
+				}
+				stringCount += entry.second.size();
+			}
+			this->aReservation.add((this->aReverseMapResult.size() + stringCount) * MemoryBudget::estimateStringBytes(0));
+		}
+		this->aValues = &findValues(this->aReverseMapResult, row.at(this->aRightIndex));
+	}
+	else { // neither synonym is bound, every pair extends the row
+		this->isPairScan = true;
+		this->aPairIt = this->aMapResult->begin();
+		while (this->aPairIt != this->aMapResult->end() && this->aPairIt->second.empty()) {
+			this->aPairIt++;
+		}
+		if (this->aPairIt == this->aMapResult->end()) {
+			return false;
+		}
+		this->aValueIt = this->aPairIt->second.begin();
+		return true;
+	}
+
+	if (this->aValues != nullptr) {
+		this->aValueIt = this->aValues->begin();
+		return this->aValueIt != this->aValues->end();
+	}
+	return true;
+}
+
+// produces the next match of the current row, returns false when the row has no more matches
+bool ClauseJoinOperator::nextMatch(const vector<string>& row, vector<string>& output) {
+	output = row;
+	if (this->isPairScan) {
+		if (this->aPairIt == this->aMapResult->end()) {
+			return false;
+		}
+		output.push_back(this->aPairIt->first);
+		output.push_back(*this->aValueIt);
+		this->aValueIt++;
+		while (this->aPairIt != this->aMapResult->end() && this->aValueIt == this->aPairIt->second.end()) {
+			this->aPairIt++;
+			if (this->aPairIt != this->aMapResult->end()) {
+				this->aValueIt = this->aPairIt->second.begin();
+			}
+		}
+		return true;
+	}
+	if (this->aValues == nullptr) { // filtered row, matched once
+		if (!this->hasCurrentRow) {
+			return false;
+		}
+		this->hasCurrentRow = false;
+		return true;
+	}
+	if (this->aValueIt == this->aValues->end()) {
+		return false;
+	}
+	output.push_back(*this->aValueIt);
+	this->aValueIt++;
+	return true;
+}
+
+bool ClauseJoinOperator::next(vector<vector<string>>& batch) {
+	batch.clear();
+	if (this->isEmpty) {
+		return false;
+	}
+
+	vector<string> output;
+	while (batch.size() < this->aBatchSize) {
+		CancellationToken::checkCurrent();
+		if (this->hasCurrentRow || this->aValues != nullptr || this->isPairScan) {
+			const vector<string>& row = this->aInputBatch.at(this->aInputPosition - 1);
+			if (nextMatch(row, output)) {
+				batch.push_back(output);
+				continue;
+			}
+			this->hasCurrentRow = false;
+			this->aValues = nullptr;
+			this->isPairScan = false;
+		}
+
+		if (this->aInputPosition >= this->aInputBatch.size()) {
+			if (this->isInputDone || !this->aInput->next(this->aInputBatch)) {
+				this->isInputDone = true;
+				break;
+			}
+			this->aInputPosition = 0;
+		}
+		const vector<string>& row = this->aInputBatch.at(this->aInputPosition++);
+		this->hasCurrentRow = startRow(row);
+	}
+	return !batch.empty();
+}
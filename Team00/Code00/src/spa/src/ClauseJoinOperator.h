@@ -0,0 +1,45 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include "BindingOperator.h"
+#include "OptionalClause.h"
+
+// joins each input row with the matching results of an evaluated clause.
+// Synonyms bound by the input are looked up in the clause results, the others extend the row,
+// and the matches of an input row are produced lazily so a row with many matches is never held at once.
+class ClauseJoinOperator : public BindingOperator {
+private:
+	shared_ptr<BindingOperator> aInput;
+	shared_ptr<OptionalClause> aClause; // keeps the clause results alive while they are joined
+	bool isSet;
+	bool isEmpty;
+	const unordered_set<string>* aSetResult = nullptr; // held by the clause, or by the derived results below
+	const unordered_map<string, unordered_set<string>>* aMapResult = nullptr;
+	unordered_set<string> aDerivedSetResult; // eg. Next*(n, n), only built when the clause results cannot be used as is
+	unordered_map<string, unordered_set<string>> aDerivedMapResult;
+	unordered_map<string, unordered_set<string>> aReverseMapResult; // built on the first lookup by the right synonym
+	MemoryBudget::Reservation aReservation; // the derived and reverse results
+	int aLeftIndex; // index of the clause's (left) synonym in the input row, -1 if not bound
+	int aRightIndex;
+
+	vector<vector<string>> aInputBatch;
+	size_t aInputPosition = 0;
+	bool isInputDone = false;
+
+	// matches of the current input row
+	bool hasCurrentRow = false;
+	const unordered_set<string>* aValues = nullptr;
+	unordered_set<string>::const_iterator aValueIt;
+	unordered_map<string, unordered_set<string>>::const_iterator aPairIt;
+	bool isPairScan = false;
+
+	const unordered_set<string>& findValues(const unordered_map<string, unordered_set<string>>& map, const string& key);
+	bool startRow(const vector<string>& row);
+	bool nextMatch(const vector<string>& row, vector<string>& output);
+
+public:
+	ClauseJoinOperator(shared_ptr<BindingOperator> input, shared_ptr<OptionalClause> clause, size_t batchSize);
+
+	bool next(vector<vector<string>>& batch);
+};
@@ -0,0 +1,195 @@
+#include "ClauseResultCache.h"
+#include "RelationshipClause.h"
+#include "PatternClause.h"
+#include "Declaration.h"
+
+namespace {
+	// rough heap cost of a string in a hash set: node, hash and characters outside the small string buffer
+	size_t getStringBytes(const string& value) {
+		size_t bytes = sizeof(string) + 2 * sizeof(void*);
+		if (value.capacity() > 15) {
+			bytes += value.capacity() + 1;
+		}
+		return bytes;
+	}
+}
+
+ClauseResultCache::ClauseResultCache(size_t byteBudget) {
+	this->aByteBudget = byteBudget;
+}
+
+string ClauseResultCache::getInputKey(shared_ptr<QueryInput> input) {
+	switch (input->getQueryInputType()) {
+	case QueryInputType::DECLARATION: {
+		shared_ptr<Declaration> declaration = dynamic_pointer_cast<Declaration>(input);
+		return "D" + to_string(static_cast<int>(declaration->getEntityType())) + (declaration->getIsAttribute() ? "." : "");
+	}
+	case QueryInputType::ANY:
+		return "_";
+	default:
+		return to_string(static_cast<int>(input->getQueryInputType())) + "\"" + input->getValue() + "\"";
+	}
+}
+
+string ClauseResultCache::getClauseKey(shared_ptr<OptionalClause> clause) {
+	string key;
+	shared_ptr<QueryInput> leftInput;
+	shared_ptr<QueryInput> rightInput;
+
+	switch (clause->getClauseType()) {
+	case ClauseType::RELATIONSHIP: {
+		shared_ptr<RelationshipClause> relationshipClause = dynamic_pointer_cast<RelationshipClause>(clause);
+		key = "R" + to_string(static_cast<int>(relationshipClause->getRelationshipType()));
+		leftInput = relationshipClause->getLeftInput();
+		rightInput = relationshipClause->getRightInput();
+		break;
+	}
+	case ClauseType::PATTERN: {
+		shared_ptr<PatternClause> patternClause = dynamic_pointer_cast<PatternClause>(clause);
+		key = "P";
+		if (patternClause->getExpression() != nullptr) {
+			shared_ptr<Expression> expression = patternClause->getExpression();
+			key += to_string(static_cast<int>(expression->getType())) + "\"" + expression->getValue() + "\"";
+		}
+		leftInput = patternClause->getSynonym();
+		rightInput = patternClause->getQueryInput();
+		break;
+	}
+	case ClauseType::WITH:
+		key = "W";
+		leftInput = clause->getLeftInput();
+		rightInput = clause->getRightInput();
+		break;
+
+	default:
+		return "";
+	}
+
+	key += "(" + getInputKey(leftInput) + "," + getInputKey(rightInput) + ")";
+	if (leftInput->getQueryInputType() == QueryInputType::DECLARATION && rightInput->getQueryInputType() == QueryInputType::DECLARATION &&
+		leftInput->getValue() == rightInput->getValue()) {
+		key += "=";
+	}
+	return key;
+}
+
+size_t ClauseResultCache::estimateBytes(const CachedClauseResult& result) {
+	size_t bytes = sizeof(CachedClauseResult);
+	for (const string& value : result.setResult) {
+		bytes += getStringBytes(value);
+	}
+	for (auto& entry : result.mapResult) {
+		bytes += getStringBytes(entry.first) + sizeof(unordered_set<string>);
+		for (const string& value : entry.second) {
+			bytes += getStringBytes(value);
+		}
+	}
+	return bytes;
+}
+
+bool ClauseResultCache::lookup(shared_ptr<OptionalClause> clause, bool& hasResults) {
+	string key = getClauseKey(clause);
+	shared_ptr<const CachedClauseResult> cached;
+	{
+		lock_guard<mutex> lock(this->aMutex);
+		auto it = this->aEntryIndex.find(key);
+		if (key.empty() || it == this->aEntryIndex.end()) {
+			this->aMissCount++;
+			return false;
+		}
+		this->aHitCount++;
+		this->aEntries.splice(this->aEntries.begin(), this->aEntries, it->second);
+		cached = it->second->second;
+	}
+
+	const CachedClauseResult& result = *cached;
+	hasResults = result.hasResults;
+	if (!hasResults) {
+		return true;
+	}
+	switch (result.resultType) {
+	case ClauseResultType::SET:
+		clause->addSetResult(result.setResult);
+		break;
+	case ClauseResultType::MAP:
+		clause->addMapResult(result.mapResult);
+		break;
+	default:
+		clause->setBoolResult(result.boolResult);
+		break;
+	}
+	return true;
+}
+
+void ClauseResultCache::store(shared_ptr<OptionalClause> clause, bool hasResults) {
+	string key = getClauseKey(clause);
+	if (key.empty()) {
+		return;
+	}
+
+	shared_ptr<CachedClauseResult> stored = make_shared<CachedClauseResult>();
+	CachedClauseResult& result = *stored;
+	result.hasResults = hasResults;
+	if (hasResults) {
+		result.resultType = clause->getClauseResultType();
+		switch (result.resultType) {
+		case ClauseResultType::SET:
+			result.setResult = clause->getSetResult();
+			break;
+		case ClauseResultType::MAP:
+			result.mapResult = clause->getMapResult();
+			break;
+		default:
+			result.boolResult = clause->getBoolResult();
+			break;
+		}
+	}
+	result.bytes = estimateBytes(result);
+	if (result.bytes > this->aByteBudget) {
+		return;
+	}
+
+	lock_guard<mutex> lock(this->aMutex);
+	auto it = this->aEntryIndex.find(key);
+	if (it != this->aEntryIndex.end()) {
+		this->aUsedBytes -= it->second->second->bytes;
+		this->aEntries.erase(it->second);
+		this->aEntryIndex.erase(it);
+	}
+	while (!this->aEntries.empty() && this->aUsedBytes + result.bytes > this->aByteBudget) {
+		this->aUsedBytes -= this->aEntries.back().second->bytes;
+		this->aEntryIndex.erase(this->aEntries.back().first);
+		this->aEntries.pop_back();
+	}
+
+	this->aUsedBytes += result.bytes;
+	this->aEntries.push_front({ key, stored });
+	this->aEntryIndex[key] = this->aEntries.begin();
+}
+
+void ClauseResultCache::clear() {
+	lock_guard<mutex> lock(this->aMutex);
+	this->aEntries.clear();
+	this->aEntryIndex.clear();
+	this->aUsedBytes = 0;
+}
+
+int ClauseResultCache::getHitCount() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aHitCount;
+}
+
+int ClauseResultCache::getMissCount() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aMissCount;
+}
+
+size_t ClauseResultCache::getSize() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aEntries.size();
+}
+
+size_t ClauseResultCache::getUsedBytes() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aUsedBytes;
+}
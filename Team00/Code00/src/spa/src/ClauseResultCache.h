@@ -0,0 +1,65 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "OptionalClause.h"
+
+using namespace std;
+
+// results of a clause fetched from the PKB, independent of the synonym names used by a query
+struct CachedClauseResult {
+	bool hasResults = false;
+	ClauseResultType resultType = ClauseResultType::BOOL;
+	unordered_set<string> setResult;
+	unordered_map<string, unordered_set<string>> mapResult;
+	bool boolResult = false;
+	size_t bytes = 0;
+};
+
+// LRU cache of clause results shared across the queries on one PKB, bounded by the estimated bytes of the stored results
+class ClauseResultCache {
+private:
+	size_t aByteBudget;
+	size_t aUsedBytes = 0;
+	// most recently used first; shared, so a lookup copies the results into its clause after releasing the lock
+	list<pair<string, shared_ptr<const CachedClauseResult>>> aEntries;
+	unordered_map<string, list<pair<string, shared_ptr<const CachedClauseResult>>>::iterator> aEntryIndex;
+	int aHitCount = 0;
+	int aMissCount = 0;
+	mutex aMutex;
+
+	static string getInputKey(shared_ptr<QueryInput> input);
+
+	static size_t estimateBytes(const CachedClauseResult& result);
+
+public:
+	ClauseResultCache(size_t byteBudget = 64 * 1024 * 1024);
+
+	/**
+	* Builds the canonical key of a clause: relationship, kinds of the inputs, constants and synonym types.
+	* Synonym names only matter in whether both inputs are the same synonym.
+	*/
+	static string getClauseKey(shared_ptr<OptionalClause> clause);
+
+	/**
+	* Fills the clause with the cached results of an equivalent clause
+	*
+	* @param hasResults set to whether the cached clause has any results
+	* @return true if the clause was found in the cache
+	*/
+	bool lookup(shared_ptr<OptionalClause> clause, bool& hasResults);
+
+	// stores the results of an evaluated clause, evicting the least recently used results when over budget
+	void store(shared_ptr<OptionalClause> clause, bool hasResults);
+
+	void clear();
+
+	int getHitCount();
+	int getMissCount();
+	size_t getSize();
+	size_t getUsedBytes();
+};
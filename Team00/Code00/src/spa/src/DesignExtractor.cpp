@@ -13,6 +13,8 @@ using namespace std;
 
 
 #include "PKB.h"
+#include "PKBBuilder.h"
+#include "Tracer.h"
 #include "EntityType.h"
 #include "DesignExtractor.h"
 #include "EntityType.h"
@@ -153,6 +155,7 @@ void DesignExtractor::buildCFG() {
 }
 
 void DesignExtractor::affectDFS(int startStmt, int curStmt, string var, vector<int>& visited){
+	CancellationToken::checkCurrent();
 	// cerr << visited << " " << curStmt << " traversing " << endl;
 	if (visited[curStmt] == startStmt) {
 		/// already visit the statement 
@@ -259,6 +262,7 @@ void DesignExtractor::buildNextBip() {
 	///now start to DFS
 	map<int, bool> was;
 	function<void(int,int)> dfsNextBip = [&](int startingStatement, int currentStatement) {
+		CancellationToken::checkCurrent();
 		if (was[currentStatement]) {
 			return;
 		}
@@ -284,6 +288,7 @@ void DesignExtractor::buildNextBip() {
 }
 
 void DesignExtractor::affectsBipDFS(int startStmt, int curStmt, string var, vector<int>& visited) {
+	CancellationToken::checkCurrent();
 	// cerr << visited << " " << curStmt << " traversing " << endl;
 	if (visited[curStmt] == startStmt) {
 		/// already visit the statement 
@@ -324,6 +329,7 @@ void DesignExtractor::buildAffectsBip() {
 }
 
 shared_ptr<PKB> DesignExtractor::extractToPKB() {
+	SPA_TRACE_SCOPE("extractToPKB");
 	auto result = make_shared<PKB>(this->numberOfStatement);
 	this->buildIndirectRelationships();
 
@@ -334,90 +340,52 @@ shared_ptr<PKB> DesignExtractor::extractToPKB() {
 		result->setStatementType(i, types[i]);
 	}
 	
-	///extract parent
-	sendInformation<int, int>(convertToMapForm<int, int>(parents, 1, numberOfStatement),
-		[&](int a, int b) {
-			result->insertParent(a, b);
-		}	
-	);
-
-	///extract parentStar
-	sendInformation<int, int>(parentStar, [&](int a, int b) {
-		result->insertParentStar(a, b);
-	});
-
-	///extract follow
-	sendInformation<int, int>(convertToMapForm<int, int>(follows, 1, numberOfStatement),
-		[&](int a, int b) {
-			result->insertFollow(a, b);
-		}
-	);
-
-	///extract followStar
-	sendInformation<int, int>(followStar, [&](int a, int b) {
-		result->insertFollowStar(a, b);
-	});
-
-	///extract next
-	sendInformation<int, int>(convertToMapForm<int, int>(nexts, 1, numberOfStatement), 
-		[&](int a, int b) {
-			result->insertNext(a, b);
-		}
-	);
-
-	//extract nextStar
-	sendInformation<int, int>(nextStar, [&](int a, int b) {
-		result->insertNextStar(a, b);
-	});
-
-	///extract affect
-	sendInformation<int, int>(convertToMapForm<int, int>(affects, 1, numberOfStatement), 
-		[&](int a, int b) {
-			result->insertAffect(a, b);
-		}
-	);
-
-	//extract affectStar
-	sendInformation<int, int>(affectStar, [&](int a, int b) {
-		result->insertAffectStar(a, b);
-	});
-
-
-	//extract nextbip
-	sendInformation<int,int>(nextBip, [&](int a, int b) {
-		result->insertNextBip(a, b);
-	});
-
-	//extract nextBipStar
-	sendInformation<int, int>(nextBipStar, [&](int a, int b) {
-		result->insertNextBipStar(a, b);
-	});
-
-	//extract affectBip
-	sendInformation<int, int>(affectsBip, [&](int a, int b) {
-		result->insertAffectBip(a, b);
-	});
-
-	//extract affectBipStar
-	sendInformation<int, int>(affectsBipStar, [&](int a, int b) {
-		result->insertAffectBipStar(a, b);
-	});
-
-	///extract uses
-	sendInformation<int, string>(indirectUses, [&](int a, string b){
-		result->insertUses(a, b);
-	});
+	///scratch state of the indirect relationships, not sent to the PKB
+	handOff(CFGBip);
+	handOff(endingProc);
+	handOff(directUses);
+	handOff(directModifies);
+	handOff(directProcedureUses);
+	handOff(directProcedureModifies);
+
+	///extract statement relationships and uses / modifies as whole adjacency lists,
+	///each freed once the builder holds its pairs when handing off
+	PKBBuilder builder(result);
+	builder.addRelationship(RelationshipType::PARENT, parents);
+	handOff(parents);
+	builder.addRelationship(RelationshipType::PARENT_T, parentStar);
+	handOff(parentStar);
+	builder.addRelationship(RelationshipType::FOLLOWS, follows);
+	handOff(follows);
+	builder.addRelationship(RelationshipType::FOLLOWS_T, followStar);
+	handOff(followStar);
+	builder.addRelationship(RelationshipType::NEXT, nexts);
+	handOff(nexts);
+	builder.addRelationship(RelationshipType::NEXT_T, nextStar);
+	handOff(nextStar);
+	builder.addRelationship(RelationshipType::AFFECTS, affects);
+	handOff(affects);
+	builder.addRelationship(RelationshipType::AFFECTS_T, affectStar);
+	handOff(affectStar);
+	builder.addRelationship(RelationshipType::NEXTBIP, nextBip);
+	handOff(nextBip);
+	builder.addRelationship(RelationshipType::NEXTBIP_T, nextBipStar);
+	handOff(nextBipStar);
+	builder.addRelationship(RelationshipType::AFFECTSBIP, affectsBip);
+	handOff(affectsBip);
+	builder.addRelationship(RelationshipType::AFFECTSBIP_T, affectsBipStar);
+	handOff(affectsBipStar);
+	builder.addRelationship(RelationshipType::USES, indirectUses);
+	handOff(indirectUses);
+	builder.addRelationship(RelationshipType::MODIFIES, indirectModifies);
+	handOff(indirectModifies);
+	builder.build();
 
 	///extract ProcUses
 	sendInformation<string, string>(indirectProcedureUses, [&](string a, string b) {
 		result->insertProcUses(a, b);
 	});
 
-	///extract modifies
-	sendInformation<int, string>(indirectModifies, [&](int a, string b) {
-		result->insertModifies(a, b);
-	});
-
 	///extract ProcUses
 	sendInformation<string, string>(indirectProcedureModifies, [&](string a, string b) {
 		result->insertProcModifies(a, b);
@@ -505,6 +473,18 @@ shared_ptr<PKB> DesignExtractor::extractToPKB() {
 	return result;
 }
 
+shared_ptr<PKB> DesignExtractor::handOffToPKB() {
+	SPA_TRACE_SCOPE("handOffToPKB");
+	this->isHandingOff = true;
+	shared_ptr<PKB> result = this->extractToPKB();
+
+	///the remaining structures are only needed while extracting; the phase times are kept for reporting
+	vector<pair<string, double>> times = move(this->phaseTimes);
+	*this = DesignExtractor();
+	this->phaseTimes = move(times);
+	return result;
+}
+
 vector<int> DesignExtractor::getFollows(int index) const {
 	return follows[index];
 }
@@ -600,12 +580,39 @@ void DesignExtractor::setProcedure(string name, int low, int high) {
 }
 
 void DesignExtractor::buildIndirectRelationships() {
+	SPA_TRACE_SCOPE("buildIndirectRelationships");
+	phaseTimes.clear();
+	///each phase is timed once, for getPhaseTimes and, in tracing builds, as a trace event
+	long long phaseStartMicros = Tracer::getMicros();
+	long long phaseStartResidentBytes = Tracer::isEnabled() ? Tracer::getResidentBytes() : 0;
+	long long phaseStartAllocationCount = Tracer::getAllocationCount();
+	long long phaseStartAllocatedBytes = Tracer::getAllocatedBytes();
+	auto recordPhase = [&](const char* phase) {
+		long long micros = Tracer::getMicros();
+		phaseTimes.push_back({ phase, (micros - phaseStartMicros) / 1e6 });
+		if (Tracer::isEnabled()) {
+			long long residentBytes = Tracer::getResidentBytes();
+			Tracer::record({ phase, phaseStartMicros, micros - phaseStartMicros, Tracer::getThreadId(),
+				residentBytes - phaseStartResidentBytes, Tracer::getAllocationCount() - phaseStartAllocationCount,
+				Tracer::getAllocatedBytes() - phaseStartAllocatedBytes });
+			phaseStartResidentBytes = residentBytes;
+		}
+		phaseStartMicros = micros;
+		phaseStartAllocationCount = Tracer::getAllocationCount();
+		phaseStartAllocatedBytes = Tracer::getAllocatedBytes();
+	};
+
 	this->buildCFG();
+	recordPhase("cfg");
 
 	callStar = extractStars<string>(calls);
+	recordPhase("callStar");
 	parentStar = extractStars<int>(convertToMapForm<int, int>(parents, 1, numberOfStatement));
+	recordPhase("parentStar");
 	followStar = extractStars<int>(convertToMapForm<int, int>(follows, 1, numberOfStatement));
+	recordPhase("followStar");
 	nextStar = extractStars<int>(convertToMapForm<int, int>(nexts, 1, numberOfStatement));
+	recordPhase("nextStar");
 	directUses = convertToMapForm<int, string>(uses, 1, numberOfStatement);
 	directModifies = convertToMapForm<int, string>(modifies, 1, numberOfStatement);
 	directProcedureUses = convolute<string, int, string>(procedures, directUses);
@@ -640,11 +647,18 @@ void DesignExtractor::buildIndirectRelationships() {
 		directModifies,
 		extractOwnerships(parentStar, directModifies)
 	);
+	recordPhase("usesModifies");
 
 	this->buildDirectAffect();
+	recordPhase("affects");
 	affectStar = extractStars<int>(convertToMapForm<int, int>(affects, 1, numberOfStatement));
+	recordPhase("affectStar");
 	this->buildNextBip();
+	recordPhase("nextBip");
 	this->buildAffectsBip();
+	recordPhase("affectsBip");
 }
 
-
+vector<pair<string, double>> DesignExtractor::getPhaseTimes() const {
+	return phaseTimes;
+}
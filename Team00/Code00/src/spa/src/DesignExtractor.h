@@ -49,6 +49,19 @@ private:
 	Ownership<int, string> controlVariables;
 	Ownership<string, int> endingProc;
 
+	///seconds spent in each phase of the last buildIndirectRelationships, in phase order
+	vector<pair<string, double>> phaseTimes;
+
+	///whether extractToPKB frees each structure once the PKB has taken it
+	bool isHandingOff = false;
+
+	template<typename T>
+	void handOff(T& structure) {
+		if (isHandingOff) {
+			T().swap(structure);
+		}
+	}
+
 
 	/// Return last statements of each block 
 	vector<int> buildCFGBlock(int stmt, int& maxLineStmt);
@@ -94,6 +107,10 @@ public:
 
 	shared_ptr<PKB> extractToPKB();
 
+	/// Like extractToPKB, but frees every structure as soon as the PKB has taken it and leaves the extractor empty,
+	/// so that the extracted relationships and the PKB are not both held in memory
+	shared_ptr<PKB> handOffToPKB();
+
 	vector<string> getUses(int index) const;
 
 	vector<string> getModifies(int index) const;
@@ -127,6 +144,8 @@ public:
 	vector<int> getEndingProcedure(string procName) const;
 
 	vector<Expression> getExpression(int index) const;
+
+	vector<pair<string, double>> getPhaseTimes() const;
 };
 
 #endif ///__DESIGN__EXTRACTOR__H__
\ No newline at end of file
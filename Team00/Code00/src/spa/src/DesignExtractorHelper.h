@@ -6,6 +6,9 @@
 #include <unordered_set>
 #include <functional>
 
+#include "Tracer.h"
+#include "CancellationToken.h"
+
 using namespace std;
 
 template<typename T>
@@ -37,6 +40,7 @@ unordered_set<K> extractVertices(const Ownership<K, V> edges) {
 */
 template<typename T>
 Indirect<T> extractStars(const Direct<T>& edges) {
+    SPA_TRACE_SCOPE("extractStars");
     Indirect<T> results;
     unordered_map<T, bool> was;
     unordered_set<T> collecting;
@@ -44,6 +48,7 @@ Indirect<T> extractStars(const Direct<T>& edges) {
     
 
     function<void(T, T)> dfs = [&](T u, T origin) {
+        CancellationToken::checkCurrent();
         if (edges.find(u) == edges.end()) return;
         for (auto &nxt: edges.at(u)) {
             collecting.insert(nxt);
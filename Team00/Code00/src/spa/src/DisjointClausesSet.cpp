@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <set>
+
 #include "DisjointClausesSet.h"
+#include "MonotonicArena.h"
 
 DisjointClausesSet::DisjointClausesSet(vector<shared_ptr<OptionalClause>> clauses) {
 	this->allClauses = clauses;
@@ -33,7 +37,7 @@ void DisjointClausesSet::init(unordered_set<string> synonyms) {
 	for (unordered_set<string>::iterator it = synonyms.begin(); it != synonyms.end(); it++) {
 		string synonym = *it;
 		this->parent.insert({ synonym, synonym }); // initially each synonym is its own disjoint set
-		this->disjointClauses.insert({ synonym, make_shared<ClauseList>() });
+		this->disjointClauses.insert({ synonym, MonotonicArena::makeShared<ClauseList>() });
 	}
 }
 
@@ -51,7 +55,7 @@ void DisjointClausesSet::addClause(shared_ptr<OptionalClause> clause) {
 
 		// add clause to left synonym root set first
 		shared_ptr<ClauseList> leftSynonymClauses = this->disjointClauses.find(leftSynonymRoot)->second;
-		leftSynonymClauses->appendNode(make_shared<ClauseNode>(clause));
+		leftSynonymClauses->appendNode(MonotonicArena::makeShared<ClauseNode>(clause));
 
 		// now consider to join right synonym root set to left synonym root set
 		shared_ptr<ClauseList> rightSynonymClauses = this->disjointClauses.find(rightSynonymRoot)->second;
@@ -92,7 +96,7 @@ void DisjointClausesSet::addClause(shared_ptr<OptionalClause> clause) {
 	string synonym = declarationQueryInput->getValue();
 	string synonymRoot = this->findRoot(synonym);
 
-	this->disjointClauses.find(synonymRoot)->second->appendNode(make_shared<ClauseNode>(clause));
+	this->disjointClauses.find(synonymRoot)->second->appendNode(MonotonicArena::makeShared<ClauseNode>(clause));
 }
 
 
@@ -126,4 +130,32 @@ string DisjointClausesSet::findRoot(string synonym) {
 	}
 
 	return this->findRoot(parentSynonym);
+}
+
+bool DisjointClausesSet::isCyclic(vector<shared_ptr<OptionalClause>> clauses) {
+	unordered_map<string, string> parent;
+	set<pair<string, string>> edges;
+	for (vector<shared_ptr<OptionalClause>>::iterator it = clauses.begin(); it != clauses.end(); it++) {
+		vector<string> synonyms = (*it)->getResultSynonyms();
+		if (synonyms.size() < 2 || synonyms.at(0) == synonyms.at(1)) {
+			continue;
+		}
+		if (!edges.insert(minmax(synonyms.at(0), synonyms.at(1))).second) {
+			continue;
+		}
+
+		string roots[2];
+		for (int i = 0; i < 2; i++) {
+			roots[i] = synonyms.at(i);
+			parent.insert({ roots[i], roots[i] });
+			while (parent.find(roots[i])->second != roots[i]) {
+				roots[i] = parent.find(roots[i])->second;
+			}
+		}
+		if (roots[0] == roots[1]) {
+			return true;
+		}
+		parent.find(roots[1])->second = roots[0];
+	}
+	return false;
 }
\ No newline at end of file
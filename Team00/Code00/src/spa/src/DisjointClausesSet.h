@@ -25,4 +25,8 @@ private:
 public:
 	DisjointClausesSet(vector<shared_ptr<OptionalClause>>);
 	vector<vector<shared_ptr<OptionalClause>>> getClauses();
+
+	// a group is cyclic if its clauses between two different synonyms connect some synonyms in more than one way,
+	// eg. Follows*(s1, s2), Parent*(s2, s3) and Next*(s3, s1); clauses between the same pair of synonyms do not count
+	static bool isCyclic(vector<shared_ptr<OptionalClause>> clauses);
 };
\ No newline at end of file
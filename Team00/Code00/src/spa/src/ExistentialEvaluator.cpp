@@ -0,0 +1,176 @@
+#include "ExistentialEvaluator.h"
+#include "CancellationToken.h"
+
+ExistentialEvaluator::ExistentialEvaluator(vector<shared_ptr<OptionalClause>> clauses) {
+	this->orderClauses(clauses);
+}
+
+// greedily visit next the smallest clause sharing the most synonyms with the clauses visited so far,
+// so that most clauses are probed with bound values rather than scanned
+void ExistentialEvaluator::orderClauses(vector<shared_ptr<OptionalClause>> clauses) {
+	unordered_set<string> boundSynonyms;
+	vector<bool> isVisited(clauses.size(), false);
+
+	for (size_t count = 0; count < clauses.size(); count++) {
+		int next = -1;
+		int nextBoundCount = -1;
+		for (size_t i = 0; i < clauses.size(); i++) {
+			if (isVisited[i]) {
+				continue;
+			}
+			int boundCount = 0;
+			for (string synonym : clauses[i]->getResultSynonyms()) {
+				boundCount += boundSynonyms.count(synonym);
+			}
+			if (boundCount > nextBoundCount ||
+				(boundCount == nextBoundCount && clauses[i]->getResultSize() < clauses[next]->getResultSize())) {
+				next = i;
+				nextBoundCount = boundCount;
+			}
+		}
+
+		isVisited[next] = true;
+		ClauseEntry entry;
+		entry.clause = clauses[next];
+		entry.synonyms = clauses[next]->getResultSynonyms();
+		if (entry.clause->getClauseResultType() == ClauseResultType::SET) {
+			entry.setResult = &entry.clause->getSetResult();
+		}
+		else if (entry.clause->getClauseResultType() == ClauseResultType::MAP) {
+			entry.mapResult = &entry.clause->getMapResult();
+		}
+		boundSynonyms.insert(entry.synonyms.begin(), entry.synonyms.end());
+		this->aEntries.push_back(entry);
+	}
+}
+
+bool ExistentialEvaluator::hasSatisfyingBinding() {
+	this->aBinding.clear();
+	return this->search(0);
+}
+
+bool ExistentialEvaluator::search(size_t index) {
+	CancellationToken::checkCurrent();
+	if (index == this->aEntries.size()) {
+		return true;
+	}
+
+	switch (this->aEntries[index].clause->getClauseResultType()) {
+	case ClauseResultType::SET:
+		return this->searchSet(index);
+
+	case ClauseResultType::MAP:
+		return this->searchMap(index);
+
+	case ClauseResultType::BOOL:
+		return this->aEntries[index].clause->getBoolResult() && this->search(index + 1);
+
+	default:
+		return false;
+	}
+}
+
+// all synonyms of a set result take the same value
+bool ExistentialEvaluator::searchSet(size_t index) {
+	ClauseEntry& entry = this->aEntries[index];
+
+	for (string synonym : entry.synonyms) {
+		auto bound = this->aBinding.find(synonym);
+		if (bound == this->aBinding.end()) {
+			continue;
+		}
+		string value = bound->second;
+		if (entry.setResult->find(value) == entry.setResult->end()) {
+			return false;
+		}
+		return this->bindAndSearch(index, entry.synonyms, vector<string>(entry.synonyms.size(), value));
+	}
+
+	for (const string& value : *entry.setResult) {
+		if (this->bindAndSearch(index, entry.synonyms, vector<string>(entry.synonyms.size(), value))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ExistentialEvaluator::searchMap(size_t index) {
+	ClauseEntry& entry = this->aEntries[index];
+	string leftSynonym = entry.synonyms[0];
+	string rightSynonym = entry.synonyms[1];
+	auto leftBound = this->aBinding.find(leftSynonym);
+	auto rightBound = this->aBinding.find(rightSynonym);
+
+	if (leftBound != this->aBinding.end()) {
+		auto it = entry.mapResult->find(leftBound->second);
+		if (it == entry.mapResult->end()) {
+			return false;
+		}
+		if (rightBound != this->aBinding.end()) { // point check
+			return it->second.find(rightBound->second) != it->second.end() && this->search(index + 1);
+		}
+		for (const string& rightValue : it->second) {
+			if (this->bindAndSearch(index, { rightSynonym }, { rightValue })) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	if (rightBound != this->aBinding.end()) {
+		if (!entry.hasReverseMapResult) {
+			for (auto& result : *entry.mapResult) {
+				for (const string& rightValue : result.second) {
+					entry.reverseMapResult[rightValue].insert(result.first);
+				}
+			}
+			entry.hasReverseMapResult = true;
+		}
+		auto it = entry.reverseMapResult.find(rightBound->second);
+		if (it == entry.reverseMapResult.end()) {
+			return false;
+		}
+		for (const string& leftValue : it->second) {
+			if (this->bindAndSearch(index, { leftSynonym }, { leftValue })) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	for (auto& result : *entry.mapResult) {
+		for (const string& rightValue : result.second) {
+			if (leftSynonym == rightSynonym && rightValue != result.first) {
+				continue;
+			}
+			if (this->bindAndSearch(index, { leftSynonym, rightSynonym }, { result.first, rightValue })) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool ExistentialEvaluator::bindAndSearch(size_t index, const vector<string>& synonyms, const vector<string>& values) {
+	vector<string> newlyBound;
+	for (size_t i = 0; i < synonyms.size(); i++) {
+		auto bound = this->aBinding.find(synonyms[i]);
+		if (bound != this->aBinding.end()) {
+			if (bound->second != values[i]) {
+				for (string synonym : newlyBound) {
+					this->aBinding.erase(synonym);
+				}
+				return false;
+			}
+			continue;
+		}
+		this->aBinding[synonyms[i]] = values[i];
+		newlyBound.push_back(synonyms[i]);
+	}
+
+	bool isSatisfied = this->search(index + 1);
+	for (string synonym : newlyBound) {
+		this->aBinding.erase(synonym);
+	}
+	return isSatisfied;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "OptionalClause.h"
+
+using namespace std;
+
+// Decides whether a group of evaluated clauses has at least one satisfying binding of its synonyms.
+// Clauses are visited depth-first, each one probing the results of the previous bindings,
+// and the search stops at the first witness instead of joining the full results.
+class ExistentialEvaluator {
+private:
+	struct ClauseEntry {
+		shared_ptr<OptionalClause> clause;
+		vector<string> synonyms;
+		const unordered_set<string>* setResult = nullptr; // results held by the clause, which outlives the search
+		const unordered_map<string, unordered_set<string>>* mapResult = nullptr;
+		unordered_map<string, unordered_set<string>> reverseMapResult; // built when the right synonym is bound first
+		bool hasReverseMapResult = false;
+	};
+
+	vector<ClauseEntry> aEntries;
+	unordered_map<string, string> aBinding;
+
+	void orderClauses(vector<shared_ptr<OptionalClause>> clauses);
+
+	bool search(size_t index);
+
+	bool searchSet(size_t index);
+
+	bool searchMap(size_t index);
+
+	bool bindAndSearch(size_t index, const vector<string>& synonyms, const vector<string>& values);
+
+public:
+	ExistentialEvaluator(vector<shared_ptr<OptionalClause>> clauses);
+
+	bool hasSatisfyingBinding();
+};
@@ -0,0 +1,209 @@
+#include <algorithm>
+
+#include "GenericJoinEvaluator.h"
+#include "IdSetUtil.h"
+#include "MonotonicArena.h"
+#include "CancellationToken.h"
+
+GenericJoinEvaluator::GenericJoinEvaluator(vector<shared_ptr<OptionalClause>> clauses) {
+	this->orderSynonyms(clauses);
+	this->aVariableRelations = vector<vector<int>>(this->aSynonyms.size());
+	for (vector<shared_ptr<OptionalClause>>::iterator it = clauses.begin(); it != clauses.end(); it++) {
+		this->addRelation(*it);
+	}
+}
+
+uint32_t GenericJoinEvaluator::getId(const string& value) {
+	auto it = this->aIds.find(value);
+	if (it != this->aIds.end()) {
+		return it->second;
+	}
+	uint32_t id = this->aDictionary.size();
+	this->aIds.insert({ value, id });
+	this->aDictionary.push_back(value);
+	return id;
+}
+
+// start from the synonym in the most clauses, then greedily take the synonym sharing the most clauses
+// with the synonyms taken so far, so that most of its values are looked up rather than scanned
+void GenericJoinEvaluator::orderSynonyms(const vector<shared_ptr<OptionalClause>>& clauses) {
+	vector<vector<string>> clauseSynonyms;
+	vector<string> synonyms;
+	for (const shared_ptr<OptionalClause>& clause : clauses) {
+		clauseSynonyms.push_back(clause->getResultSynonyms());
+		for (const string& synonym : clauseSynonyms.back()) {
+			if (find(synonyms.begin(), synonyms.end(), synonym) == synonyms.end()) {
+				synonyms.push_back(synonym);
+			}
+		}
+	}
+
+	unordered_map<string, bool> isOrdered;
+	while (this->aSynonyms.size() < synonyms.size()) {
+		string next;
+		pair<int, int> nextScore = { -1, -1 };
+		for (const string& synonym : synonyms) {
+			if (isOrdered[synonym]) {
+				continue;
+			}
+			pair<int, int> score = { 0, 0 }; // clauses with an ordered synonym, all clauses
+			for (const vector<string>& otherSynonyms : clauseSynonyms) {
+				if (find(otherSynonyms.begin(), otherSynonyms.end(), synonym) == otherSynonyms.end()) {
+					continue;
+				}
+				score.second++;
+				for (const string& other : otherSynonyms) {
+					if (other != synonym && isOrdered[other]) {
+						score.first++;
+						break;
+					}
+				}
+			}
+			if (score > nextScore) {
+				next = synonym;
+				nextScore = score;
+			}
+		}
+		isOrdered[next] = true;
+		this->aSynonyms.push_back(next);
+	}
+}
+
+void GenericJoinEvaluator::addRelation(shared_ptr<OptionalClause> clause) {
+	vector<string> synonyms = clause->getResultSynonyms();
+	if (clause->getClauseResultType() == ClauseResultType::BOOL) {
+		this->isEmpty = this->isEmpty || !clause->getBoolResult();
+		return;
+	}
+
+	Relation relation;
+	for (const string& synonym : synonyms) {
+		int variable = find(this->aSynonyms.begin(), this->aSynonyms.end(), synonym) - this->aSynonyms.begin();
+		if (find(relation.variables.begin(), relation.variables.end(), variable) == relation.variables.end()) {
+			relation.variables.push_back(variable);
+		}
+	}
+
+	if (clause->getClauseResultType() == ClauseResultType::SET) {
+		for (const string& value : clause->getSetResult()) {
+			uint32_t id = this->getId(value);
+			relation.leftValues.push_back(id);
+			if (relation.variables.size() == 2) { // eg. with v1 = v2, both synonyms take the same value
+				relation.forward[id].push_back(id);
+				relation.backward[id].push_back(id);
+			}
+		}
+	}
+	else {
+		for (auto& entry : clause->getMapResult()) {
+			uint32_t leftId = this->getId(entry.first);
+			for (const string& value : entry.second) {
+				uint32_t rightId = this->getId(value);
+				if (relation.variables.size() == 1) { // eg. Next*(n, n), only the pairs of a value with itself
+					if (leftId == rightId) {
+						relation.leftValues.push_back(leftId);
+					}
+					continue;
+				}
+				relation.forward[leftId].push_back(rightId);
+				relation.backward[rightId].push_back(leftId);
+			}
+		}
+	}
+
+	if (relation.variables.size() == 2) {
+		relation.leftValues.clear();
+		for (auto& entry : relation.forward) {
+			sort(entry.second.begin(), entry.second.end());
+			relation.leftValues.push_back(entry.first);
+		}
+		for (auto& entry : relation.backward) {
+			sort(entry.second.begin(), entry.second.end());
+			relation.rightValues.push_back(entry.first);
+		}
+		sort(relation.rightValues.begin(), relation.rightValues.end());
+	}
+	sort(relation.leftValues.begin(), relation.leftValues.end());
+	this->isEmpty = this->isEmpty || relation.leftValues.empty();
+
+	for (int variable : relation.variables) {
+		this->aVariableRelations.at(variable).push_back(this->aRelations.size());
+	}
+	this->aRelations.push_back(relation);
+}
+
+shared_ptr<ResultsTable> GenericJoinEvaluator::evaluate() {
+	this->aRows.clear();
+	this->aBinding = vector<uint32_t>(this->aSynonyms.size());
+	if (!this->isEmpty) {
+		this->join(0);
+	}
+
+	shared_ptr<ResultsTable> resultsTable = MonotonicArena::makeShared<ResultsTable>();
+	if (this->aRows.empty()) {
+		resultsTable->setIsNoResult();
+		return resultsTable;
+	}
+
+	unordered_map<string, int> synonymIndex;
+	for (size_t i = 0; i < this->aSynonyms.size(); i++) {
+		synonymIndex.insert({ this->aSynonyms.at(i), i });
+	}
+	resultsTable->setTable(move(synonymIndex), move(this->aRows)); // cleared again before the next evaluation
+	return resultsTable;
+}
+
+// binds the synonym at the given depth to each value allowed by all of its clauses, given the synonyms bound before
+void GenericJoinEvaluator::join(size_t depth) {
+	CancellationToken::checkCurrent();
+	if (depth == this->aSynonyms.size()) {
+		vector<string> row;
+		for (uint32_t id : this->aBinding) {
+			row.push_back(this->aDictionary.at(id));
+		}
+		this->aRows.push_back(row);
+		return;
+	}
+
+	vector<const vector<uint32_t>*> lists;
+	for (int index : this->aVariableRelations.at(depth)) {
+		const Relation& relation = this->aRelations.at(index);
+		if (relation.variables.size() == 1) {
+			lists.push_back(&relation.leftValues);
+			continue;
+		}
+
+		bool isLeft = relation.variables.at(0) == (int) depth;
+		int other = relation.variables.at(isLeft ? 1 : 0);
+		if (other > (int) depth) { // not bound yet
+			lists.push_back(isLeft ? &relation.leftValues : &relation.rightValues);
+			continue;
+		}
+		const unordered_map<uint32_t, vector<uint32_t>>& values = isLeft ? relation.backward : relation.forward;
+		auto it = values.find(this->aBinding.at(other));
+		if (it == values.end()) {
+			return;
+		}
+		lists.push_back(&it->second);
+	}
+
+	for (uint32_t value : intersect(lists)) {
+		this->aBinding.at(depth) = value;
+		this->join(depth + 1);
+	}
+}
+
+vector<uint32_t> GenericJoinEvaluator::intersect(vector<const vector<uint32_t>*> lists) {
+	if (lists.empty()) {
+		return {};
+	}
+	sort(lists.begin(), lists.end(), [](const vector<uint32_t>* list1, const vector<uint32_t>* list2) {
+		return list1->size() < list2->size();
+	});
+
+	vector<uint32_t> results = *lists.at(0);
+	for (size_t i = 1; i < lists.size() && !results.empty(); i++) {
+		results = IdSetUtil::intersect(results, *lists.at(i));
+	}
+	return results;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "OptionalClause.h"
+#include "ResultsTable.h"
+
+using namespace std;
+
+// Joins a group of evaluated clauses one synonym at a time instead of one clause at a time.
+// The values of each synonym are the intersection of the sorted values allowed by every clause
+// on it, given the synonyms bound before, so no intermediate result is larger than the final one.
+// Used for cyclic groups, where joining clause by clause can build intermediates far larger than the output.
+class GenericJoinEvaluator {
+private:
+	// results of one clause over one or two synonyms, with values replaced by dictionary ids
+	struct Relation {
+		vector<int> variables; // positions in the join order
+		vector<uint32_t> leftValues; // sorted, all values of the first synonym
+		vector<uint32_t> rightValues; // sorted, all values of the second synonym
+		unordered_map<uint32_t, vector<uint32_t>> forward; // first synonym value to sorted second synonym values
+		unordered_map<uint32_t, vector<uint32_t>> backward; // second synonym value to sorted first synonym values
+	};
+
+	vector<string> aDictionary;
+	unordered_map<string, uint32_t> aIds;
+	vector<string> aSynonyms; // in join order
+	vector<Relation> aRelations;
+	vector<vector<int>> aVariableRelations; // relations constraining each synonym
+	bool isEmpty = false;
+
+	vector<uint32_t> aBinding;
+	vector<vector<string>> aRows;
+
+	uint32_t getId(const string& value);
+
+	void orderSynonyms(const vector<shared_ptr<OptionalClause>>& clauses);
+
+	void addRelation(shared_ptr<OptionalClause> clause);
+
+	void join(size_t depth);
+
+public:
+	GenericJoinEvaluator(vector<shared_ptr<OptionalClause>> clauses);
+
+	// table over every synonym of the group, flagged as no result if nothing satisfies all clauses
+	shared_ptr<ResultsTable> evaluate();
+
+	// sorted values present in every list, intersecting the lists from the shortest
+	static vector<uint32_t> intersect(vector<const vector<uint32_t>*> lists);
+};
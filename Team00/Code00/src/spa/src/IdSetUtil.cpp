@@ -0,0 +1,371 @@
+#include <algorithm>
+
+#include "IdSetUtil.h"
+
+// the vector kernels are compiled for their instruction sets function by function,
+// and only called after checking that the processor supports them
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SPA_X86_SIMD
+#include <immintrin.h>
+#endif
+
+IdSetUtil::Kernel IdSetUtil::aKernel = IdSetUtil::getBestKernel();
+
+namespace {
+	// vector kernels store whole blocks, so the output may be written up to a block past its results
+	const size_t BLOCK_PADDING = 8;
+
+	// lane orders moving the selected lanes of a block to its front, indexed by the bit mask of selected lanes
+	struct CompressTables {
+		uint8_t sse[16][16];
+		uint32_t avx2[256][8];
+
+		CompressTables() {
+			for (int mask = 0; mask < 16; mask++) {
+				int next = 0;
+				for (int lane = 0; lane < 4; lane++) {
+					if (mask & (1 << lane)) {
+						for (int byte = 0; byte < 4; byte++) {
+							sse[mask][next * 4 + byte] = lane * 4 + byte;
+						}
+						next++;
+					}
+				}
+				for (int byte = next * 4; byte < 16; byte++) {
+					sse[mask][byte] = 0x80; // zeroed
+				}
+			}
+			for (int mask = 0; mask < 256; mask++) {
+				int next = 0;
+				for (int lane = 0; lane < 8; lane++) {
+					if (mask & (1 << lane)) {
+						avx2[mask][next++] = lane;
+					}
+				}
+				while (next < 8) {
+					avx2[mask][next++] = 0;
+				}
+			}
+		}
+	};
+
+	const CompressTables& getCompressTables() {
+		static const CompressTables tables;
+		return tables;
+	}
+
+	int countBits(unsigned int mask) {
+		int count = 0;
+		for (; mask != 0; mask &= mask - 1) {
+			count++;
+		}
+		return count;
+	}
+
+#ifdef SPA_X86_SIMD
+	// bit i is set if lane i of values1 is equal to any lane of values2
+	__attribute__((target("sse4.2")))
+	int matchSse(__m128i values1, __m128i values2) {
+		__m128i matches = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi32(values1, values2),
+				_mm_cmpeq_epi32(values1, _mm_shuffle_epi32(values2, _MM_SHUFFLE(0, 3, 2, 1)))),
+			_mm_or_si128(_mm_cmpeq_epi32(values1, _mm_shuffle_epi32(values2, _MM_SHUFFLE(1, 0, 3, 2))),
+				_mm_cmpeq_epi32(values1, _mm_shuffle_epi32(values2, _MM_SHUFFLE(2, 1, 0, 3)))));
+		return _mm_movemask_ps(_mm_castsi128_ps(matches));
+	}
+
+	__attribute__((target("sse4.2")))
+	size_t storeSse(__m128i values, int mask, uint32_t* output) {
+		__m128i order = _mm_loadu_si128((const __m128i*) getCompressTables().sse[mask]);
+		_mm_storeu_si128((__m128i*) output, _mm_shuffle_epi8(values, order));
+		return countBits(mask);
+	}
+
+	__attribute__((target("avx2")))
+	int matchAvx2(__m256i values1, __m256i values2) {
+		__m256i matches = _mm256_cmpeq_epi32(values1, values2);
+		for (int rotation = 1; rotation < 8; rotation++) {
+			__m256i order = _mm256_setr_epi32(rotation, (rotation + 1) % 8, (rotation + 2) % 8, (rotation + 3) % 8,
+				(rotation + 4) % 8, (rotation + 5) % 8, (rotation + 6) % 8, (rotation + 7) % 8);
+			matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(values1, _mm256_permutevar8x32_epi32(values2, order)));
+		}
+		return _mm256_movemask_ps(_mm256_castsi256_ps(matches));
+	}
+
+	__attribute__((target("avx2")))
+	size_t storeAvx2(__m256i values, int mask, uint32_t* output) {
+		__m256i order = _mm256_loadu_si256((const __m256i*) getCompressTables().avx2[mask]);
+		_mm256_storeu_si256((__m256i*) output, _mm256_permutevar8x32_epi32(values, order));
+		return countBits(mask);
+	}
+#endif
+}
+
+IdSetUtil::Kernel IdSetUtil::getBestKernel() {
+#ifdef SPA_X86_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return Kernel::AVX2;
+	}
+	if (__builtin_cpu_supports("sse4.2")) {
+		return Kernel::SSE;
+	}
+#endif
+	return Kernel::SCALAR;
+}
+
+void IdSetUtil::setKernel(Kernel kernel) {
+	aKernel = min(kernel, getBestKernel());
+}
+
+IdSetUtil::Kernel IdSetUtil::getKernel() {
+	return aKernel;
+}
+
+vector<uint32_t> IdSetUtil::intersect(const vector<uint32_t>& values1, const vector<uint32_t>& values2) {
+	const vector<uint32_t>& shorter = values1.size() <= values2.size() ? values1 : values2;
+	const vector<uint32_t>& longer = values1.size() <= values2.size() ? values2 : values1;
+	vector<uint32_t> results(shorter.size() + BLOCK_PADDING);
+	size_t size;
+	if (shorter.size() * GALLOPING_RATIO < longer.size()) {
+		size = intersectGalloping(shorter, longer, results.data());
+	}
+	else if (aKernel == Kernel::AVX2) {
+		size = intersectAvx2(values1.data(), values1.size(), values2.data(), values2.size(), results.data());
+	}
+	else if (aKernel == Kernel::SSE) {
+		size = intersectSse(values1.data(), values1.size(), values2.data(), values2.size(), results.data());
+	}
+	else {
+		size = intersectScalar(values1.data(), values1.size(), values2.data(), values2.size(), results.data());
+	}
+	results.resize(size);
+	return results;
+}
+
+vector<uint32_t> IdSetUtil::difference(const vector<uint32_t>& values1, const vector<uint32_t>& values2) {
+	vector<uint32_t> results(values1.size() + BLOCK_PADDING);
+	size_t size;
+	if (values1.size() * GALLOPING_RATIO < values2.size()) {
+		size = differenceGalloping(values1, values2, results.data());
+	}
+	else if (aKernel == Kernel::AVX2) {
+		size = differenceAvx2(values1.data(), values1.size(), values2.data(), values2.size(), results.data());
+	}
+	else if (aKernel == Kernel::SSE) {
+		size = differenceSse(values1.data(), values1.size(), values2.data(), values2.size(), results.data());
+	}
+	else {
+		size = differenceScalar(values1.data(), values1.size(), values2.data(), values2.size(), results.data());
+	}
+	results.resize(size);
+	return results;
+}
+
+// a branch-light scalar merge; unlike intersection, every value is written, so there is little to gain from wider compares
+vector<uint32_t> IdSetUtil::mergeUnion(const vector<uint32_t>& values1, const vector<uint32_t>& values2) {
+	vector<uint32_t> results(values1.size() + values2.size());
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+	while (i < values1.size() && j < values2.size()) {
+		uint32_t value1 = values1[i];
+		uint32_t value2 = values2[j];
+		results[size++] = min(value1, value2);
+		i += value1 <= value2;
+		j += value2 <= value1;
+	}
+	size = copy(values1.begin() + i, values1.end(), results.begin() + size) - results.begin();
+	size = copy(values2.begin() + j, values2.end(), results.begin() + size) - results.begin();
+	results.resize(size);
+	return results;
+}
+
+size_t IdSetUtil::gallopingSearch(const vector<uint32_t>& values, size_t begin, uint32_t target) {
+	size_t size = values.size();
+	if (begin >= size || values[begin] >= target) {
+		return begin;
+	}
+	// values[low] < target, and values[high] >= target if high is in range
+	size_t low = begin;
+	size_t step = 1;
+	while (low + step < size && values[low + step] < target) {
+		low += step;
+		step *= 2;
+	}
+	size_t high = min(size, low + step);
+	return lower_bound(values.begin() + low + 1, values.begin() + high, target) - values.begin();
+}
+
+size_t IdSetUtil::intersectScalar(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output) {
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+	while (i < size1 && j < size2) {
+		if (values1[i] < values2[j]) {
+			i++;
+		}
+		else if (values2[j] < values1[i]) {
+			j++;
+		}
+		else {
+			output[size++] = values1[i];
+			i++;
+			j++;
+		}
+	}
+	return size;
+}
+
+size_t IdSetUtil::intersectGalloping(const vector<uint32_t>& shorter, const vector<uint32_t>& longer, uint32_t* output) {
+	size_t position = 0;
+	size_t size = 0;
+	for (uint32_t value : shorter) {
+		position = gallopingSearch(longer, position, value);
+		if (position == longer.size()) {
+			break;
+		}
+		if (longer[position] == value) {
+			output[size++] = value;
+		}
+	}
+	return size;
+}
+
+size_t IdSetUtil::differenceGalloping(const vector<uint32_t>& shorter, const vector<uint32_t>& longer, uint32_t* output) {
+	size_t position = 0;
+	size_t size = 0;
+	for (uint32_t value : shorter) {
+		position = gallopingSearch(longer, position, value);
+		if (position == longer.size() || longer[position] != value) {
+			output[size++] = value;
+		}
+	}
+	return size;
+}
+
+size_t IdSetUtil::differenceScalar(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output) {
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+	while (i < size1) {
+		while (j < size2 && values2[j] < values1[i]) {
+			j++;
+		}
+		if (j == size2 || values2[j] != values1[i]) {
+			output[size++] = values1[i];
+		}
+		i++;
+	}
+	return size;
+}
+
+// each step compares a block of each list, all against all, and moves past the block ending first;
+// a value is matched at most once as the lists have no repeated values
+#ifdef SPA_X86_SIMD
+__attribute__((target("sse4.2")))
+#endif
+size_t IdSetUtil::intersectSse(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output) {
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+#ifdef SPA_X86_SIMD
+	while (i + 4 <= size1 && j + 4 <= size2) {
+		__m128i block1 = _mm_loadu_si128((const __m128i*) (values1 + i));
+		__m128i block2 = _mm_loadu_si128((const __m128i*) (values2 + j));
+		size += storeSse(block1, matchSse(block1, block2), output + size);
+		uint32_t last1 = values1[i + 3];
+		uint32_t last2 = values2[j + 3];
+		i += last1 <= last2 ? 4 : 0;
+		j += last2 <= last1 ? 4 : 0;
+	}
+#endif
+	return size + intersectScalar(values1 + i, size1 - i, values2 + j, size2 - j, output + size);
+}
+
+#ifdef SPA_X86_SIMD
+__attribute__((target("avx2")))
+#endif
+size_t IdSetUtil::intersectAvx2(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output) {
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+#ifdef SPA_X86_SIMD
+	while (i + 8 <= size1 && j + 8 <= size2) {
+		__m256i block1 = _mm256_loadu_si256((const __m256i*) (values1 + i));
+		__m256i block2 = _mm256_loadu_si256((const __m256i*) (values2 + j));
+		size += storeAvx2(block1, matchAvx2(block1, block2), output + size);
+		uint32_t last1 = values1[i + 7];
+		uint32_t last2 = values2[j + 7];
+		i += last1 <= last2 ? 8 : 0;
+		j += last2 <= last1 ? 8 : 0;
+	}
+#endif
+	return size + intersectScalar(values1 + i, size1 - i, values2 + j, size2 - j, output + size);
+}
+
+// each block of the first list is compared against every block of the second list overlapping its range,
+// and keeps the values matched by none of them
+#ifdef SPA_X86_SIMD
+__attribute__((target("sse4.2")))
+#endif
+size_t IdSetUtil::differenceSse(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output) {
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+#ifdef SPA_X86_SIMD
+	for (; i + 4 <= size1; i += 4) {
+		uint32_t first = values1[i];
+		uint32_t last = values1[i + 3];
+		while (j + 4 <= size2 && values2[j + 3] < first) {
+			j += 4;
+		}
+
+		__m128i block1 = _mm_loadu_si128((const __m128i*) (values1 + i));
+		int mask = 0;
+		size_t k = j;
+		for (; k + 4 <= size2 && values2[k] <= last; k += 4) {
+			mask |= matchSse(block1, _mm_loadu_si128((const __m128i*) (values2 + k)));
+		}
+		for (; k < size2 && k + 4 > size2 && values2[k] <= last; k++) { // fewer than a block left
+			for (int lane = 0; lane < 4; lane++) {
+				mask |= (values1[i + lane] == values2[k]) << lane;
+			}
+		}
+		size += storeSse(block1, ~mask & 0xF, output + size);
+	}
+#endif
+	return size + differenceScalar(values1 + i, size1 - i, values2 + j, size2 - j, output + size);
+}
+
+#ifdef SPA_X86_SIMD
+__attribute__((target("avx2")))
+#endif
+size_t IdSetUtil::differenceAvx2(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output) {
+	size_t i = 0;
+	size_t j = 0;
+	size_t size = 0;
+#ifdef SPA_X86_SIMD
+	for (; i + 8 <= size1; i += 8) {
+		uint32_t first = values1[i];
+		uint32_t last = values1[i + 7];
+		while (j + 8 <= size2 && values2[j + 7] < first) {
+			j += 8;
+		}
+
+		__m256i block1 = _mm256_loadu_si256((const __m256i*) (values1 + i));
+		int mask = 0;
+		size_t k = j;
+		for (; k + 8 <= size2 && values2[k] <= last; k += 8) {
+			mask |= matchAvx2(block1, _mm256_loadu_si256((const __m256i*) (values2 + k)));
+		}
+		for (; k < size2 && k + 8 > size2 && values2[k] <= last; k++) { // fewer than a block left
+			for (int lane = 0; lane < 8; lane++) {
+				mask |= (values1[i + lane] == values2[k]) << lane;
+			}
+		}
+		size += storeAvx2(block1, ~mask & 0xFF, output + size);
+	}
+#endif
+	return size + differenceScalar(values1 + i, size1 - i, values2 + j, size2 - j, output + size);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// Set operations over strictly increasing arrays of dictionary ids.
+// Intersection and difference compare blocks of 4 (SSE4.2) or 8 (AVX2) ids at a time when the processor
+// supports them, and fall back to scalar merges elsewhere; every kernel gives the same results.
+class IdSetUtil {
+public:
+	enum class Kernel { SCALAR, SSE, AVX2 };
+
+	// one list is this many times longer than the other before it is searched instead of merged
+	static const size_t GALLOPING_RATIO = 32;
+
+	static vector<uint32_t> intersect(const vector<uint32_t>& values1, const vector<uint32_t>& values2);
+
+	// values of the first list that are not in the second
+	static vector<uint32_t> difference(const vector<uint32_t>& values1, const vector<uint32_t>& values2);
+
+	static vector<uint32_t> mergeUnion(const vector<uint32_t>& values1, const vector<uint32_t>& values2);
+
+	// index of the first value not less than target at or after begin, found by doubling the step then bisecting
+	static size_t gallopingSearch(const vector<uint32_t>& values, size_t begin, uint32_t target);
+
+	// kernel used by the set operations, at most the best one supported by this processor
+	static void setKernel(Kernel kernel);
+
+	static Kernel getKernel();
+
+	static Kernel getBestKernel();
+
+private:
+	static Kernel aKernel;
+
+	static size_t intersectScalar(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output);
+
+	static size_t intersectGalloping(const vector<uint32_t>& shorter, const vector<uint32_t>& longer, uint32_t* output);
+
+	static size_t differenceGalloping(const vector<uint32_t>& shorter, const vector<uint32_t>& longer, uint32_t* output);
+
+	static size_t differenceScalar(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output);
+
+	static size_t intersectSse(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output);
+
+	static size_t intersectAvx2(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output);
+
+	static size_t differenceSse(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output);
+
+	static size_t differenceAvx2(const uint32_t* values1, size_t size1, const uint32_t* values2, size_t size2, uint32_t* output);
+};
@@ -0,0 +1,125 @@
+#include <string>
+#include <vector>
+
+#include "MemoryBudget.h"
+
+shared_ptr<MemoryBudget> MemoryBudget::aProcessBudget = make_shared<MemoryBudget>();
+thread_local shared_ptr<MemoryBudget> MemoryBudget::aCurrent;
+
+namespace {
+	// a string that fits in place, as most values of a SIMPLE program do
+	const size_t STRING_BYTES = sizeof(string);
+
+	// node and bucket of a hash set entry
+	const size_t HASH_NODE_BYTES = 32;
+}
+
+MemoryBudget::MemoryBudget(size_t limitBytes, shared_ptr<MemoryBudget> parent) : aLimitBytes(limitBytes) {
+	this->aParent = parent;
+}
+
+void MemoryBudget::setLimit(size_t limitBytes) {
+	this->aLimitBytes = limitBytes;
+}
+
+size_t MemoryBudget::getLimit() {
+	return this->aLimitBytes;
+}
+
+size_t MemoryBudget::getUsedBytes() {
+	return this->aUsedBytes;
+}
+
+size_t MemoryBudget::getPeakBytes() {
+	return this->aPeakBytes;
+}
+
+void MemoryBudget::charge(size_t bytes) {
+	size_t used = this->aUsedBytes.fetch_add(bytes) + bytes;
+	size_t limit = this->aLimitBytes;
+	if (limit != 0 && used > limit) {
+		this->aUsedBytes -= bytes;
+		throw MemoryBudgetExceededException("over the memory budget of " + to_string(limit) + " bytes");
+	}
+	if (this->aParent != nullptr) {
+		try {
+			this->aParent->charge(bytes);
+		}
+		catch (MemoryBudgetExceededException&) {
+			this->aUsedBytes -= bytes;
+			throw;
+		}
+	}
+
+	size_t peak = this->aPeakBytes;
+	while (used > peak && !this->aPeakBytes.compare_exchange_weak(peak, used)) {
+	}
+}
+
+void MemoryBudget::release(size_t bytes) {
+	this->aUsedBytes -= bytes;
+	if (this->aParent != nullptr) {
+		this->aParent->release(bytes);
+	}
+}
+
+size_t MemoryBudget::estimateRowBytes(size_t rowCount, size_t columnCount) {
+	return rowCount * (sizeof(vector<string>) + columnCount * STRING_BYTES);
+}
+
+size_t MemoryBudget::estimateStringBytes(size_t length) {
+	return HASH_NODE_BYTES + STRING_BYTES + (length < STRING_BYTES ? 0 : length + 1);
+}
+
+shared_ptr<MemoryBudget> MemoryBudget::getProcessBudget() {
+	return aProcessBudget;
+}
+
+shared_ptr<MemoryBudget> MemoryBudget::getCurrent() {
+	return aCurrent;
+}
+
+MemoryBudget::Scope::Scope(shared_ptr<MemoryBudget> budget) {
+	this->aPrevious = aCurrent;
+	aCurrent = budget;
+}
+
+MemoryBudget::Scope::~Scope() {
+	aCurrent = this->aPrevious;
+}
+
+MemoryBudget::Reservation::Reservation() {
+	this->aBudget = aCurrent;
+}
+
+MemoryBudget::Reservation::~Reservation() {
+	if (this->aBudget != nullptr) {
+		this->aBudget->release(this->aBytes);
+	}
+}
+
+void MemoryBudget::Reservation::add(size_t bytes) {
+	if (this->aBudget == nullptr || bytes == 0) {
+		return;
+	}
+	this->aBudget->charge(bytes);
+	this->aBytes += bytes;
+}
+
+void MemoryBudget::Reservation::resize(size_t bytes) {
+	if (this->aBudget == nullptr) {
+		return;
+	}
+	size_t reserved = this->aBytes;
+	if (bytes > reserved) {
+		add(bytes - reserved);
+	}
+	else if (bytes < reserved) {
+		this->aBudget->release(reserved - bytes);
+		this->aBytes -= reserved - bytes;
+	}
+}
+
+size_t MemoryBudget::Reservation::getBytes() {
+	return this->aBytes;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "MemoryBudgetExceededException.h"
+
+using namespace std;
+
+// Accounts the memory of intermediate results against a limit. Each query gets a budget whose parent is the
+// process budget, so a charge counts against both. Charges are estimates of the rows and strings held,
+// not of the heap itself. A budget may be charged from several threads at once, such as the workers of a parallel join.
+class MemoryBudget {
+private:
+	atomic<size_t> aLimitBytes;
+	atomic<size_t> aUsedBytes{ 0 };
+	atomic<size_t> aPeakBytes{ 0 };
+	shared_ptr<MemoryBudget> aParent;
+
+	static shared_ptr<MemoryBudget> aProcessBudget;
+	static thread_local shared_ptr<MemoryBudget> aCurrent;
+
+public:
+	// a limit of 0 is no limit
+	MemoryBudget(size_t limitBytes = 0, shared_ptr<MemoryBudget> parent = nullptr);
+
+	MemoryBudget(const MemoryBudget&) = delete;
+
+	MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+	void setLimit(size_t limitBytes);
+
+	size_t getLimit();
+
+	size_t getUsedBytes();
+
+	size_t getPeakBytes();
+
+	/**
+	* Adds bytes to this budget and its parents
+	*
+	* @throws MemoryBudgetExceededException if any of them would go over its limit, then nothing is charged
+	*/
+	void charge(size_t bytes);
+
+	void release(size_t bytes);
+
+	// estimated bytes of rows of short strings, such as the rows of a ResultsTable
+	static size_t estimateRowBytes(size_t rowCount, size_t columnCount);
+
+	// estimated bytes of a string kept in a hash set
+	static size_t estimateStringBytes(size_t length);
+
+	// shared by all queries, unlimited unless set
+	static shared_ptr<MemoryBudget> getProcessBudget();
+
+	// budget that reservations made on this thread charge, or nullptr if nothing is accounted
+	static shared_ptr<MemoryBudget> getCurrent();
+
+	// makes a budget current on this thread until the end of the scope
+	class Scope {
+	private:
+		shared_ptr<MemoryBudget> aPrevious;
+
+	public:
+		Scope(shared_ptr<MemoryBudget> budget);
+
+		Scope(const Scope&) = delete;
+
+		Scope& operator=(const Scope&) = delete;
+
+		~Scope();
+	};
+
+	// bytes held by one table or loop, charged to the budget current when it was made and released when it is destroyed
+	class Reservation {
+	private:
+		shared_ptr<MemoryBudget> aBudget;
+		atomic<size_t> aBytes{ 0 };
+
+	public:
+		Reservation();
+
+		Reservation(const Reservation&) = delete;
+
+		Reservation& operator=(const Reservation&) = delete;
+
+		~Reservation();
+
+		// @throws MemoryBudgetExceededException if the budget would go over its limit
+		void add(size_t bytes);
+
+		// charges or releases the difference to the given total; not to be mixed with add from other threads
+		void resize(size_t bytes);
+
+		size_t getBytes();
+	};
+};
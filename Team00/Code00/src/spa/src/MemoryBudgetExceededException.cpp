@@ -0,0 +1,6 @@
+#include "MemoryBudgetExceededException.h"
+
+MemoryBudgetExceededException::MemoryBudgetExceededException(const std::string& what_arg) : std::runtime_error(what_arg)
+{
+
+}
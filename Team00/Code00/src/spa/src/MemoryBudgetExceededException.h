@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdexcept>
+
+// thrown out of evaluation when the intermediate results of a query would take more memory than its budget allows
+class MemoryBudgetExceededException : public std::runtime_error {
+public:
+    MemoryBudgetExceededException(const std::string& what_arg);
+};
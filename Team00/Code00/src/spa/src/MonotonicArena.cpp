@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "MonotonicArena.h"
+
+thread_local shared_ptr<MonotonicArena> MonotonicArena::aCurrent;
+
+MonotonicArena::MonotonicArena(size_t initialBlockSize) {
+	this->aNextBlockSize = max(initialBlockSize, (size_t) 64);
+}
+
+void MonotonicArena::addBlock(size_t minimumSize) {
+	size_t size = max(this->aNextBlockSize, minimumSize);
+	this->aBlocks.push_back(unique_ptr<char[]>(new char[size]));
+	this->aNext = this->aBlocks.back().get();
+	this->aRemaining = size;
+	this->aReservedBytes += size;
+	this->aNextBlockSize = min(this->aNextBlockSize * 2, MAX_BLOCK_SIZE);
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+	size_t padding = (alignment - (uintptr_t) this->aNext % alignment) % alignment;
+	if (this->aNext == nullptr || padding + bytes > this->aRemaining) {
+		// new char[] is aligned for any fundamental type, larger alignments are padded within the block
+		this->addBlock(bytes + alignment);
+		padding = (alignment - (uintptr_t) this->aNext % alignment) % alignment;
+	}
+
+	void* pointer = this->aNext + padding;
+	this->aNext += padding + bytes;
+	this->aRemaining -= padding + bytes;
+	this->aUsedBytes += padding + bytes;
+	return pointer;
+}
+
+size_t MonotonicArena::getUsedBytes() {
+	return this->aUsedBytes;
+}
+
+size_t MonotonicArena::getReservedBytes() {
+	return this->aReservedBytes;
+}
+
+size_t MonotonicArena::getBlockCount() {
+	return this->aBlocks.size();
+}
+
+shared_ptr<MonotonicArena> MonotonicArena::getCurrent() {
+	return aCurrent;
+}
+
+MonotonicArena::Scope::Scope(shared_ptr<MonotonicArena> arena) {
+	this->aPrevious = aCurrent;
+	aCurrent = arena;
+}
+
+MonotonicArena::Scope::~Scope() {
+	aCurrent = this->aPrevious;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Bump allocator for the objects of one query. Memory is handed out from blocks of growing size and is never
+// freed piece by piece, only all at once when the arena is destroyed. An arena is used by one thread at a time.
+class MonotonicArena {
+private:
+	vector<unique_ptr<char[]>> aBlocks;
+	char* aNext = nullptr;
+	size_t aRemaining = 0;
+	size_t aNextBlockSize;
+	size_t aUsedBytes = 0;
+	size_t aReservedBytes = 0;
+
+	static thread_local shared_ptr<MonotonicArena> aCurrent;
+
+	void addBlock(size_t minimumSize);
+
+public:
+	static const size_t INITIAL_BLOCK_SIZE = 4096;
+	static const size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+	MonotonicArena(size_t initialBlockSize = INITIAL_BLOCK_SIZE);
+
+	MonotonicArena(const MonotonicArena&) = delete;
+
+	MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+	// alignment must be a power of two
+	void* allocate(size_t bytes, size_t alignment);
+
+	// bytes handed out, including padding for alignment
+	size_t getUsedBytes();
+
+	// bytes of all blocks taken from the heap
+	size_t getReservedBytes();
+
+	size_t getBlockCount();
+
+	// arena that makeShared allocates from on this thread, or nullptr to allocate from the heap
+	static shared_ptr<MonotonicArena> getCurrent();
+
+	/**
+	* Makes an object like make_shared, in the current arena of this thread if there is one.
+	* The object and its control block keep the arena alive, so it may safely outlive the query.
+	*/
+	template <typename T, typename... Args>
+	static shared_ptr<T> makeShared(Args&&... args);
+
+	// makes an arena current on this thread until the end of the scope
+	class Scope {
+	private:
+		shared_ptr<MonotonicArena> aPrevious;
+
+	public:
+		Scope(shared_ptr<MonotonicArena> arena);
+
+		Scope(const Scope&) = delete;
+
+		Scope& operator=(const Scope&) = delete;
+
+		~Scope();
+	};
+};
+
+// standard allocator over a MonotonicArena, deallocating is a no-op; without an arena it uses the heap
+template <typename T>
+class ArenaAllocator {
+private:
+	shared_ptr<MonotonicArena> aArena;
+
+public:
+	typedef T value_type;
+
+	ArenaAllocator(shared_ptr<MonotonicArena> arena) : aArena(arena) {}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : aArena(other.getArena()) {}
+
+	T* allocate(size_t count) {
+		if (this->aArena == nullptr) {
+			return static_cast<T*>(::operator new(count * sizeof(T)));
+		}
+		return static_cast<T*>(this->aArena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* pointer, size_t /*count*/) {
+		if (this->aArena == nullptr) {
+			::operator delete(pointer);
+		}
+	}
+
+	shared_ptr<MonotonicArena> getArena() const {
+		return this->aArena;
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& allocator1, const ArenaAllocator<U>& allocator2) {
+	return allocator1.getArena() == allocator2.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& allocator1, const ArenaAllocator<U>& allocator2) {
+	return !(allocator1 == allocator2);
+}
+
+template <typename T, typename... Args>
+shared_ptr<T> MonotonicArena::makeShared(Args&&... args) {
+	if (aCurrent == nullptr) {
+		return make_shared<T>(forward<Args>(args)...);
+	}
+	return allocate_shared<T>(ArenaAllocator<T>(aCurrent), forward<Args>(args)...);
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iterator>
+
+#include "MorselExecutor.h"
+#include "CancellationToken.h"
+#include "MemoryBudget.h"
+
+mutex MorselExecutor::aMutex;
+shared_ptr<ThreadPool> MorselExecutor::aPool;
+size_t MorselExecutor::aThreadCount = max(1u, thread::hardware_concurrency());
+size_t MorselExecutor::aParallelThreshold = 1 << 18;
+
+namespace {
+	// shared with the pool tasks, which may only start after the loop has finished
+	struct MorselLoop {
+		MorselExecutor::MorselWork work;
+		shared_ptr<CancellationToken> cancellationToken; // of the thread running the loop, checked by every morsel
+		MemoryBudget::Reservation reservation; // rows of finished morsels, charged to the budget of the thread running the loop
+		size_t itemCount = 0;
+		size_t morselSize = 0;
+		size_t morselCount = 0;
+		atomic<size_t> nextMorsel{ 0 };
+		vector<vector<vector<string>>> outputs;
+
+		mutex doneMutex;
+		condition_variable allDone;
+		size_t doneCount = 0;
+		exception_ptr error;
+
+		// claims and runs morsels until none are left
+		void runMorsels() {
+			CancellationToken::Scope cancellationScope(this->cancellationToken);
+			while (true) {
+				size_t morsel = this->nextMorsel++;
+				if (morsel >= this->morselCount) {
+					return;
+				}
+				size_t begin = morsel * this->morselSize;
+				size_t end = min(this->itemCount, begin + this->morselSize);
+				exception_ptr morselError;
+				try {
+					CancellationToken::checkCurrent();
+					vector<vector<string>>& output = this->outputs.at(morsel);
+					this->work(begin, end, output);
+					this->reservation.add(MemoryBudget::estimateRowBytes(output.size(), output.empty() ? 0 : output.front().size()));
+				}
+				catch (...) {
+					morselError = current_exception();
+				}
+
+				lock_guard<mutex> lock(this->doneMutex);
+				if (morselError && !this->error) {
+					this->error = morselError;
+				}
+				if (++this->doneCount == this->morselCount) {
+					this->allDone.notify_all();
+				}
+			}
+		}
+	};
+
+	// runs the morsels of the loop on the calling thread and the workers of the pool, rethrowing the first error
+	void runOnPool(shared_ptr<MorselLoop> loop, shared_ptr<ThreadPool> pool) {
+		size_t helperCount = min(pool->getThreadCount(), loop->morselCount - 1);
+		for (size_t i = 0; i < helperCount; i++) {
+			pool->submit([loop] { loop->runMorsels(); });
+		}
+		loop->runMorsels();
+		{
+			unique_lock<mutex> lock(loop->doneMutex);
+			loop->allDone.wait(lock, [&loop] { return loop->doneCount == loop->morselCount; });
+		}
+		if (loop->error) {
+			rethrow_exception(loop->error);
+		}
+	}
+}
+
+vector<vector<string>> MorselExecutor::run(size_t itemCount, size_t itemCost, MorselWork work) {
+	vector<vector<string>> rows;
+	size_t parallelThreshold;
+	{
+		lock_guard<mutex> lock(aMutex);
+		parallelThreshold = aParallelThreshold;
+	}
+	size_t totalCost = itemCount * max((size_t) 1, itemCost);
+	shared_ptr<ThreadPool> pool = itemCount < 2 || totalCost < parallelThreshold ? nullptr : getPool();
+	size_t morselSize = max((size_t) 1, MORSEL_COST / max((size_t) 1, itemCost));
+	if (pool == nullptr) {
+		// still in morsels, so that a cancelled query or one over its memory budget stops within one morsel
+		MemoryBudget::Reservation reservation;
+		for (size_t begin = 0; begin < itemCount; begin += morselSize) {
+			CancellationToken::checkCurrent();
+			work(begin, min(itemCount, begin + morselSize), rows);
+			reservation.resize(MemoryBudget::estimateRowBytes(rows.size(), rows.empty() ? 0 : rows.front().size()));
+		}
+		return rows;
+	}
+
+	shared_ptr<MorselLoop> loop = make_shared<MorselLoop>();
+	loop->work = work;
+	loop->cancellationToken = CancellationToken::getCurrent();
+	loop->itemCount = itemCount;
+	loop->morselSize = morselSize;
+	loop->morselCount = (itemCount + loop->morselSize - 1) / loop->morselSize;
+	loop->outputs = vector<vector<vector<string>>>(loop->morselCount);
+
+	runOnPool(loop, pool);
+
+	size_t rowCount = 0;
+	for (const vector<vector<string>>& output : loop->outputs) {
+		rowCount += output.size();
+	}
+	rows.reserve(rowCount);
+	for (vector<vector<string>>& output : loop->outputs) {
+		move(output.begin(), output.end(), back_inserter(rows));
+	}
+	loop->reservation.resize(0); // the rows are the caller's to account from here
+	return rows;
+}
+
+// each task is a morsel of its own, producing no rows
+void MorselExecutor::runTasks(const vector<function<void()>>& tasks) {
+	shared_ptr<ThreadPool> pool = tasks.size() < 2 ? nullptr : getPool();
+	if (pool == nullptr) {
+		for (const function<void()>& task : tasks) {
+			task();
+		}
+		return;
+	}
+
+	shared_ptr<MorselLoop> loop = make_shared<MorselLoop>();
+	loop->work = [tasks](size_t begin, size_t end, vector<vector<string>>&) {
+		for (size_t i = begin; i < end; i++) {
+			tasks[i]();
+		}
+	};
+	loop->cancellationToken = CancellationToken::getCurrent();
+	loop->itemCount = tasks.size();
+	loop->morselSize = 1;
+	loop->morselCount = tasks.size();
+	loop->outputs = vector<vector<vector<string>>>(loop->morselCount);
+	runOnPool(loop, pool);
+}
+
+void MorselExecutor::setThreadCount(size_t threadCount) {
+	lock_guard<mutex> lock(aMutex);
+	aThreadCount = max((size_t) 1, threadCount);
+	aPool = nullptr; // loops still running keep the old pool alive
+}
+
+size_t MorselExecutor::getThreadCount() {
+	lock_guard<mutex> lock(aMutex);
+	return aThreadCount;
+}
+
+void MorselExecutor::setParallelThreshold(size_t threshold) {
+	lock_guard<mutex> lock(aMutex);
+	aParallelThreshold = threshold;
+}
+
+// the calling thread runs morsels too, so the pool has one thread fewer than a loop uses
+shared_ptr<ThreadPool> MorselExecutor::getPool() {
+	lock_guard<mutex> lock(aMutex);
+	if (aThreadCount <= 1) {
+		return nullptr;
+	}
+	if (aPool == nullptr) {
+		aPool = make_shared<ThreadPool>(aThreadCount - 1);
+	}
+	return aPool;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ThreadPool.h"
+
+using namespace std;
+
+// Runs the outer loop of a join over many threads. The loop is cut into morsels of consecutive items,
+// which the calling thread and the workers of a shared pool claim one at a time until none are left,
+// so a worker that finishes early takes over the remaining work of the others.
+// Each morsel fills its own output buffer, and the buffers are concatenated in morsel order,
+// giving the same rows in the same order as running the loop on one thread.
+class MorselExecutor {
+public:
+	// appends the rows of items [begin, end); may be called again with the following items and the same rows
+	typedef function<void(size_t begin, size_t end, vector<vector<string>>& rows)> MorselWork;
+
+	// rough number of row comparisons per morsel
+	static const size_t MORSEL_COST = 1 << 14;
+
+	// runs work over [0, itemCount), where each item costs about itemCost row comparisons;
+	// loops cheaper than the parallel threshold run on the calling thread only
+	static vector<vector<string>> run(size_t itemCount, size_t itemCost, MorselWork work);
+
+	// runs independent tasks, each claimed by the calling thread or a worker of the shared pool, whatever their cost
+	static void runTasks(const vector<function<void()>>& tasks);
+
+	// number of threads used for one loop, including the calling thread; 1 disables parallel loops
+	static void setThreadCount(size_t threadCount);
+
+	static size_t getThreadCount();
+
+	// least total cost of a loop to be run in parallel
+	static void setParallelThreshold(size_t threshold);
+
+private:
+	static mutex aMutex;
+	static shared_ptr<ThreadPool> aPool;
+	static size_t aThreadCount;
+	static size_t aParallelThreshold;
+
+	static shared_ptr<ThreadPool> getPool();
+};
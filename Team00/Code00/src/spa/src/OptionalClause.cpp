@@ -15,19 +15,29 @@ ClauseResultType OptionalClause::getClauseResultType() {
 	return this->clauseResultType;
 }
 
+// charges the estimated bytes of the results about to be stored, the results they replace are released once replaced
+void OptionalClause::reserveResults(size_t stringCount) {
+	shared_ptr<MemoryBudget::Reservation> reservation = make_shared<MemoryBudget::Reservation>();
+	reservation->add(stringCount * MemoryBudget::estimateStringBytes(0));
+	this->aReservation = reservation;
+}
+
 void OptionalClause::addSetResult(unordered_set<string> results) {
+	reserveResults(results.size());
 	this->clauseResultType = ClauseResultType::SET;
-	this->setResult = results;
 	this->resultSize = results.size();
+	this->setResult = move(results);
 }
 
 void OptionalClause::addMapResult(unordered_map<string, unordered_set<string>> results) {
-	this->clauseResultType = ClauseResultType::MAP;
-	this->mapResult = results;
-	this->resultSize = 0;
-	for (auto result : results) {
-		this->resultSize += result.second.size();
+	int size = 0;
+	for (const auto& result : results) {
+		size += result.second.size();
 	}
+	reserveResults(results.size() + size);
+	this->clauseResultType = ClauseResultType::MAP;
+	this->resultSize = size;
+	this->mapResult = move(results);
 }
 
 void OptionalClause::setBoolResult(bool result) {
@@ -36,22 +46,56 @@ void OptionalClause::setBoolResult(bool result) {
 	this->boolResult = result;
 }
 
-unordered_set<string> OptionalClause::getSetResult() {
+const unordered_set<string>& OptionalClause::getSetResult() {
 	return this->setResult;
 }
 
-unordered_map<string, unordered_set<string>> OptionalClause::getMapResult() {
+const unordered_map<string, unordered_set<string>>& OptionalClause::getMapResult() {
 	return this->mapResult;
 }
 
+unordered_set<string> OptionalClause::takeSetResult() {
+	unordered_set<string> results = move(this->setResult);
+	this->setResult.clear();
+	this->aReservation.reset(); // the taker accounts for the results from here
+	return results;
+}
+
+unordered_map<string, unordered_set<string>> OptionalClause::takeMapResult() {
+	unordered_map<string, unordered_set<string>> results = move(this->mapResult);
+	this->mapResult.clear();
+	this->aReservation.reset(); // the taker accounts for the results from here
+	return results;
+}
+
 int OptionalClause::getResultSize() {
 	return this->resultSize;
 }
 
+void OptionalClause::setEstimatedResultSize(int size) {
+	this->resultSize = size;
+}
+
 bool OptionalClause::getBoolResult() {
 	return this->boolResult;
 }
 
+vector<string> OptionalClause::getResultSynonyms() {
+	switch (this->clauseResultType) {
+	case ClauseResultType::MAP:
+		return { this->getLeftInput()->getValue(), this->getRightInput()->getValue() };
+
+	case ClauseResultType::SET:
+		if (this->getLeftInput()->getQueryInputType() == QueryInputType::DECLARATION) {
+			return { this->getLeftInput()->getValue() };
+		}
+		return { this->getRightInput()->getValue() };
+
+	default:
+		return {};
+	}
+}
+
 //bool OptionalClause::operator < (const OptionalClause& other) const {
 //	return this->resultSize < other.resultSize;
 //}
@@ -1,11 +1,13 @@
 #pragma once
 #include "ClauseType.h"
 #include "ClauseResultType.h"
+#include "MemoryBudget.h"
 #include "QueryInput.h"
 #include <memory>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 class OptionalClause {
 protected:
@@ -18,6 +20,9 @@ protected:
 	unordered_map<string, unordered_set<string>> mapResult;
 	bool boolResult;
 	int resultSize;
+	shared_ptr<MemoryBudget::Reservation> aReservation; // charges the stored results to the budget current when they were added
+
+	void reserveResults(size_t stringCount);
 
 public:
 	ClauseType getClauseType();
@@ -25,13 +30,27 @@ public:
 	virtual shared_ptr<QueryInput> getRightInput();
 
 	ClauseResultType getClauseResultType();
+	// the results are taken by value, callers done with theirs move them in
 	void addSetResult(unordered_set<string> results);
 	void addMapResult(unordered_map<string, unordered_set<string>> results);
 	void setBoolResult(bool result);
-	unordered_set<string> getSetResult();
-	unordered_map<string, unordered_set<string>> getMapResult();
+	const unordered_set<string>& getSetResult();
+	const unordered_map<string, unordered_set<string>>& getMapResult();
+
+	// moves the results out of the clause once they are merged into a table, leaving the clause without them
+	unordered_set<string> takeSetResult();
+	unordered_map<string, unordered_set<string>> takeMapResult();
 	bool getBoolResult();
 	int getResultSize();
 
+	// size used to order the clause among the others before its results are fetched
+	void setEstimatedResultSize(int size);
+
+	// synonyms of the stored results, in the order they are merged into a results table
+	virtual vector<string> getResultSynonyms();
+
+	// copy of the clause with the same inputs and no results
+	virtual shared_ptr<OptionalClause> clone() = 0;
+
 	virtual ~OptionalClause();
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "PKB.h"
+#include "Tracer.h"
 #include "EntityType.h"
 #include "RelationshipType.h"
 #include "QueryInputType.h"
@@ -14,50 +15,128 @@
 
 using namespace std;
 
-PKB::PKB(const int& n) : number(n) {
-	for (int i = 1; i <= n; i++) {
-		this->entities[EntityType::STMT].insert(to_string(i));
-		this->entities[EntityType::PROGLINE].insert(to_string(i));
+namespace {
+	// strings of the statement numbers, each converted once per load
+	class StatementNames {
+	private:
+		vector<string> aNames;
+
+	public:
+		StatementNames(const int& number) : aNames(max(number, 0) + 1) {}
+
+		const string& get(const int& index) {
+			if (this->aNames[index].empty()) {
+				this->aNames[index] = to_string(index);
+			}
+			return this->aNames[index];
+		}
+
+		const string& get(const string& name) {
+			return name;
+		}
+	};
+
+	void insertStatement(StatementBitmap& bitmap, const int& index) {
+		if (index > 0) { // 0 is not a statement, eg. the number of a variable or procedure name
+			bitmap.insert(index);
+		}
+	}
+
+	void insertStatement(StatementBitmap&, const string&) {} // variable names are not statements
+
+	// keeps the first pair of each key that is not taken yet, from pairs sorted by their keys
+	void keepFirstOfEachKey(vector<pair<int, int>>& pairs, const bool& isKeyFirst, const StatementBitmap& takenKeys) {
+		size_t keptCount = 0;
+		int lastKey = 0;
+		for (size_t i = 0; i < pairs.size(); i++) {
+			int key = isKeyFirst ? pairs[i].first : pairs[i].second;
+			if (key != lastKey && !takenKeys.contains(key)) {
+				pairs[keptCount++] = pairs[i];
+			}
+			lastKey = key;
+		}
+		pairs.resize(keptCount);
+	}
+
+	// indexes pairs sorted by key run by run, so each key is converted and hashed once
+	template <typename K, typename V>
+	void indexSortedPairs(const vector<pair<K, V>>& pairs, StatementNames& names,
+		unordered_map<string, unordered_set<string>>& map, unordered_set<string>& keys, StatementBitmap& keyBitmap) {
+		size_t keyCount = 0;
+		for (size_t i = 0; i < pairs.size(); i++) {
+			keyCount += i == 0 || pairs[i].first != pairs[i - 1].first;
+		}
+		map.reserve(map.size() + keyCount);
+		keys.reserve(keys.size() + keyCount);
+
+		size_t end = 0;
+		for (size_t begin = 0; begin < pairs.size(); begin = end) {
+			end = begin + 1;
+			while (end < pairs.size() && pairs[end].first == pairs[begin].first) {
+				end++;
+			}
+			const string& key = names.get(pairs[begin].first);
+			unordered_set<string>& values = map[key];
+			values.reserve(values.size() + end - begin);
+			for (size_t i = begin; i < end; i++) {
+				values.insert(names.get(pairs[i].second));
+			}
+			keys.insert(key);
+			insertStatement(keyBitmap, pairs[begin].first);
+		}
 	}
 }
 
+PKB::PKB(const int& n) : number(n) {
+	this->isStatisticsBuilt.reset(new once_flag());
+	this->statementTypes.assign(max(n, 0) + 1, EntityType::NONETYPE);
+	this->typeBitmaps.assign((int) EntityType::PROGLINE + 1, StatementBitmap(max(n, 0) + 1));
+}
+
 void PKB::init() {
-	// init proc-var table
-	unordered_set<string> varTable = this->entities[EntityType::VAR];
-	for (string name : this->entities[EntityType::PROC]) {
-		if (varTable.find(name) != varTable.end()) { // identical names
-			this->procVarName[name].insert(name);
-		}
+	SPA_TRACE_SCOPE("PKB::init");
+	call_once(*this->isStatisticsBuilt, [this]() { this->buildStatistics(); });
+}
+
+void PKB::buildStatistics() {
+	this->statistics = make_shared<StatisticsCatalog>();
+	if (this->number > 0) {
+		this->statistics->setEntityCount(EntityType::STMT, this->number);
+		this->statistics->setEntityCount(EntityType::PROGLINE, this->number);
 	}
-	// init const-stmt# table
-	for (string val : this->entities[EntityType::CONST]) {
-		if (types.find(val) != types.end()) { // identical values
-			EntityType t = types[val];
-			this->constStmtNum[t][val].insert(val);
-			this->constStmtNum[EntityType::STMT][val].insert(val);
-			this->constStmtNum[EntityType::PROGLINE][val].insert(val);
+	for (size_t t = 0; t < this->typeBitmaps.size(); t++) {
+		if (!this->typeBitmaps[t].isEmpty()) {
+			this->statistics->setEntityCount(static_cast<EntityType>(t), this->typeBitmaps[t].count());
 		}
 	}
+	for (auto& entry : this->entities) {
+		this->statistics->setEntityCount(entry.first, entry.second.size());
+	}
+	for (int t = RelationshipType::FOLLOWS; t <= RelationshipType::AFFECTSBIP_T; t++) {
+		RelationshipType type = static_cast<RelationshipType>(t);
+		this->statistics->setRelationStatistics(type,
+			StatisticsCatalog::computeStatistics(this->relations[t], this->relationsBy[t]));
+	}
+	this->statistics->setProcRelationStatistics(RelationshipType::USES,
+		StatisticsCatalog::computeStatistics(this->procUses, this->usedByProc));
+	this->statistics->setProcRelationStatistics(RelationshipType::MODIFIES,
+		StatisticsCatalog::computeStatistics(this->procModifies, this->modifiedByProc));
 }
 
 bool PKB::setStatementType(const int& index, const EntityType& type) {
-	if (type == EntityType::STMT || type == EntityType::VAR ||
-		type == EntityType::CONST || type == EntityType::PROC) {
+	if (!this->isStatementType(type)) {
 		return false;
 	}
 	else if (index > this->number || index <= 0) {
 		return false;
 	}
+	else if (this->statementTypes[index] != EntityType::NONETYPE) { // type already set
+		return false;
+	}
 	else {
-		string indexString = to_string(index);
-		if (this->types.find(indexString) != types.end()) { // key exists
-			return false;
-		}
-		else {
-			this->types[indexString] = type;
-			this->entities[type].insert(indexString);
-			return true;
-		}
+		this->statementTypes[index] = type;
+		this->typeBitmaps[(int) type].insert(index);
+		return true;
 	}
 }
 
@@ -67,6 +146,8 @@ bool PKB::insertRelationship(const RelationshipType& type, const string& e1, con
 	this->relationsBy[t][e2].insert(e1);
 	this->relationKeys[t].insert(e1);
 	this->relationByKeys[t].insert(e2);
+	insertStatement(this->relationKeyBitmaps[t], toStatementNumber(e1));
+	insertStatement(this->relationByKeyBitmaps[t], toStatementNumber(e2));
 	return true;
 }
 
@@ -168,8 +249,8 @@ bool PKB::insertAffect(const int& former, const int& latter) {
 	else {
 		string formerString = to_string(former);
 		string latterString = to_string(latter);
-		if (types[formerString] != EntityType::ASSIGN || 
-			types[latterString] != EntityType::ASSIGN) {
+		if (this->statementTypes[former] != EntityType::ASSIGN ||
+			this->statementTypes[latter] != EntityType::ASSIGN) {
 			return false;
 		}
 		return this->insertRelationship(
@@ -187,8 +268,8 @@ bool PKB::insertAffectStar(const int& former, const int& latter) {
 	else {
 		string formerString = to_string(former);
 		string latterString = to_string(latter);
-		if (types[formerString] != EntityType::ASSIGN ||
-			types[latterString] != EntityType::ASSIGN) {
+		if (this->statementTypes[former] != EntityType::ASSIGN ||
+			this->statementTypes[latter] != EntityType::ASSIGN) {
 			return false;
 		}
 		return this->insertRelationship(
@@ -206,8 +287,8 @@ bool PKB::insertAffectBip(const int& former, const int& latter) {
 	else {
 		string formerString = to_string(former);
 		string latterString = to_string(latter);
-		if (types[formerString] != EntityType::ASSIGN ||
-			types[latterString] != EntityType::ASSIGN) {
+		if (this->statementTypes[former] != EntityType::ASSIGN ||
+			this->statementTypes[latter] != EntityType::ASSIGN) {
 			return false;
 		}
 		return this->insertRelationship(
@@ -225,8 +306,8 @@ bool PKB::insertAffectBipStar(const int& former, const int& latter) {
 	else {
 		string formerString = to_string(former);
 		string latterString = to_string(latter);
-		if (types[formerString] != EntityType::ASSIGN ||
-			types[latterString] != EntityType::ASSIGN) {
+		if (this->statementTypes[former] != EntityType::ASSIGN ||
+			this->statementTypes[latter] != EntityType::ASSIGN) {
 			return false;
 		}
 		return this->insertRelationship(
@@ -364,8 +445,8 @@ bool PKB::setControlVariable(const int& index, const string& variable) {
 	}
 	else {
 		string indexString = to_string(index);
-		int t = this->types[indexString] == EntityType::IF ? 0
-			: this->types[indexString] == EntityType::WHILE ? 1 : -1;
+		int t = this->statementTypes[index] == EntityType::IF ? 0
+			: this->statementTypes[index] == EntityType::WHILE ? 1 : -1;
 		if (t == -1) {
 			return false;
 		}
@@ -397,19 +478,111 @@ bool PKB::insertUsedName(const int& index, const string& name) {
 	if (index <= 0 || index > this->number) {
 		return false;
 	}
-	string indexString = to_string(index);
-	EntityType type = this->types[indexString];
-	int t = type == EntityType::CALL ? 0 : type == EntityType::PRINT ? 1 : type == EntityType::READ ? 2 : -1;
-	if (t == -1) {
+	EntityType type = this->statementTypes[index];
+	if (!this->isSecondaryAttribute(type)) {
 		return false;
 	}
+	string indexString = to_string(index);
 	this->nameUsed[indexString] = name;
-	this->nameUsedBy[t][name].insert(indexString);
+	this->attributeIndex[type][name].insert(indexString);
 	return true;
 }
 
+int PKB::loadRelationship(const RelationshipType& type, vector<pair<int, int>> pairs) {
+	SPA_TRACE_SCOPE("PKB::loadRelationship");
+	pairs.erase(remove_if(pairs.begin(), pairs.end(), [&](const pair<int, int>& p) {
+		return !this->isValidPair(type, p.first, p.second);
+	}), pairs.end());
+
+	int t = type;
+	if (type == RelationshipType::PARENT) { // a statement has at most one parent, the first one kept
+		sort(pairs.begin(), pairs.end(), [](const pair<int, int>& a, const pair<int, int>& b) {
+			return a.second != b.second ? a.second < b.second : a.first < b.first;
+		});
+		keepFirstOfEachKey(pairs, false, this->relationByKeyBitmaps[t]);
+	}
+	else if (type == RelationshipType::FOLLOWS) { // a statement is followed by at most one statement
+		sort(pairs.begin(), pairs.end());
+		keepFirstOfEachKey(pairs, true, this->relationKeyBitmaps[t]);
+	}
+	return this->loadPairs(type, pairs);
+}
+
+int PKB::loadRelationship(const RelationshipType& type, vector<pair<int, string>> pairs) {
+	SPA_TRACE_SCOPE("PKB::loadRelationship");
+	if (type != RelationshipType::USES && type != RelationshipType::MODIFIES) {
+		return 0;
+	}
+	pairs.erase(remove_if(pairs.begin(), pairs.end(), [&](const pair<int, string>& p) {
+		return p.first <= 0 || p.first > this->number;
+	}), pairs.end());
+	for (const pair<int, string>& p : pairs) {
+		this->insertVariable(p.second);
+	}
+	return this->loadPairs(type, pairs);
+}
+
+bool PKB::isValidPair(const RelationshipType& type, const int& former, const int& latter) {
+	if (former <= 0 || former > this->number || latter <= 0 || latter > this->number) {
+		return false;
+	}
+	switch (type) {
+	case RelationshipType::FOLLOWS:
+	case RelationshipType::FOLLOWS_T:
+	case RelationshipType::PARENT:
+	case RelationshipType::PARENT_T:
+		return former < latter;
+
+	case RelationshipType::NEXT:
+	case RelationshipType::NEXT_T:
+	case RelationshipType::NEXTBIP:
+	case RelationshipType::NEXTBIP_T:
+		return true;
+
+	case RelationshipType::AFFECTS:
+	case RelationshipType::AFFECTS_T:
+	case RelationshipType::AFFECTSBIP:
+	case RelationshipType::AFFECTSBIP_T:
+		return this->statementTypes[former] == EntityType::ASSIGN && this->statementTypes[latter] == EntityType::ASSIGN;
+
+	default:
+		return false;
+	}
+}
+
+// the reverse index is built from the swapped pairs sorted again, rather than by a hash insert per pair
+template <typename V>
+int PKB::loadPairs(const RelationshipType& type, vector<pair<int, V>>& pairs) {
+	int t = type;
+	sort(pairs.begin(), pairs.end());
+	pairs.erase(unique(pairs.begin(), pairs.end()), pairs.end());
+	StatementNames names(this->number);
+	indexSortedPairs(pairs, names, this->relations[t], this->relationKeys[t], this->relationKeyBitmaps[t]);
+
+	vector<pair<V, int>> reversed;
+	reversed.reserve(pairs.size());
+	for (const pair<int, V>& p : pairs) {
+		reversed.emplace_back(p.second, p.first);
+	}
+	sort(reversed.begin(), reversed.end());
+	indexSortedPairs(reversed, names, this->relationsBy[t], this->relationByKeys[t], this->relationByKeyBitmaps[t]);
+	return pairs.size();
+}
+
 unordered_set<string> PKB::getEntities(const EntityType& type) {
-	return this->entities[type];
+	if (type == EntityType::STMT || type == EntityType::PROGLINE) { // the range 1 to number, only made into strings here
+		unordered_set<string> statements;
+		statements.reserve(max(this->number, 0));
+		for (int i = 1; i <= this->number; i++) {
+			statements.insert(to_string(i));
+		}
+		return statements;
+	}
+	if (this->isStatementType(type)) {
+		return this->typeBitmaps[(int) type].toStrings();
+	}
+	auto it = this->entities.find(type);
+	return it == this->entities.end() ? unordered_set<string>() : it->second;
 }
 
 // retrieval results for such that clauses
@@ -422,23 +595,23 @@ bool PKB::getBooleanResultOfRS(const RelationshipType& type,
 		return !this->relations[type].empty();
 	}
 	else if (t1 == QueryInputType::ANY) { // eg. follows(_, 3). can't be uses/modifies
-		return !this->relationsBy[type][input2->getValue()].empty();
+		return !findValues(this->relationsBy[type], input2->getValue()).empty();
 	}
 	else if (t1 != QueryInputType::ANY) {
 		unordered_set<string> results;
 		if (t1 == QueryInputType::IDENT) { // input1 is a procedure
 			if (type == RelationshipType::USES) { // procedure uses
-				results = this->procUses[input1->getValue()];
+				results = findValues(this->procUses, input1->getValue());
 			}
 			else if (type == RelationshipType::MODIFIES) { // procedure modifies
-				results = this->procModifies[input1->getValue()];
+				results = findValues(this->procModifies, input1->getValue());
 			}
 			else { // call or call*
-				results = this->relations[type][input1->getValue()];
+				results = findValues(this->relations[type], input1->getValue());
 			}
 		}
 		else { // does not involve procedures
-			results = this->relations[type][input1->getValue()];
+			results = findValues(this->relations[type], input1->getValue());
 		}
 		if (t2 == QueryInputType::ANY) { // eg. parent(2, _); uses(1, _)
 			return !results.empty();
@@ -462,7 +635,7 @@ unordered_set<string> PKB::getSetResultsOfRS(const RelationshipType& type,
 		if (d->getEntityType() == EntityType::PROC) {
 			if (type == RelationshipType::USES) {
 				if (t2 == QueryInputType::IDENT) { // eg. uses(p, "x")
-					return this->usedByProc[input2->getValue()];
+					return findValues(this->usedByProc, input2->getValue());
 				}
 				else if (t2 == QueryInputType::ANY) { // eg. uses(p, _)
 					return this->procUsesKeys;
@@ -473,7 +646,7 @@ unordered_set<string> PKB::getSetResultsOfRS(const RelationshipType& type,
 			}
 			else if (type == RelationshipType::MODIFIES) {
 				if (t2 == QueryInputType::IDENT) { // eg. modifies(p, "x")
-					return this->modifiedByProc[input2->getValue()];
+					return findValues(this->modifiedByProc, input2->getValue());
 				}
 				else if (t2 == QueryInputType::ANY) { // eg. modifies(p, _)
 					return this->procModifiesKeys;
@@ -485,14 +658,17 @@ unordered_set<string> PKB::getSetResultsOfRS(const RelationshipType& type,
 		}
 		switch (t2) {
 		case QueryInputType::STMT_NUM: { // eg. parent*(s, 3)
-			ans = this->relationsBy[type][input2->getValue()];
+			ans = findValues(this->relationsBy[type], input2->getValue());
 			break;
 		}
 		case QueryInputType::IDENT: { // eg. modifies(s, "x")
-			ans = this->relationsBy[type][input2->getValue()];
+			ans = findValues(this->relationsBy[type], input2->getValue());
 			break;
 		}
 		case QueryInputType::ANY: { // eg. follows*(s, _)
+			if (this->isStatementType(d->getEntityType())) { // eg. follows*(a, _), the keys that are assignments
+				return this->relationKeyBitmaps[type].intersect(this->typeBitmaps[(int) d->getEntityType()]).toStrings();
+			}
 			ans = this->relationKeys[type];
 			break;
 		}
@@ -503,22 +679,26 @@ unordered_set<string> PKB::getSetResultsOfRS(const RelationshipType& type,
 	else if (t2 == QueryInputType::DECLARATION) {
 		switch (t1) {
 		case QueryInputType::STMT_NUM: { // eg. parent*(3, s)
-			ans = this->relations[type][input1->getValue()];
+			ans = findValues(this->relations[type], input1->getValue());
 			break;
 		}
 		case QueryInputType::IDENT: {
 			if (type == RelationshipType::USES) { // eg. uses("main", v)
-				ans = this->procUses[input1->getValue()];
+				ans = findValues(this->procUses, input1->getValue());
 			}
 			else if (type == RelationshipType::MODIFIES) { // eg. modifies("main", v)
-				ans = this->procModifies[input1->getValue()];
+				ans = findValues(this->procModifies, input1->getValue());
 			}
 			else { // eg. calls*("main", p)
-				ans = this->relations[type][input1->getValue()];
+				ans = findValues(this->relations[type], input1->getValue());
 			}
 			break;
 		}
 		case QueryInputType::ANY: { // eg. follows*(_, s)
+			shared_ptr<Declaration> d = dynamic_pointer_cast<Declaration>(input2);
+			if (this->isStatementType(d->getEntityType())) {
+				return this->relationByKeyBitmaps[type].intersect(this->typeBitmaps[(int) d->getEntityType()]).toStrings();
+			}
 			ans = this->relationByKeys[type];
 			break;
 		}
@@ -577,7 +757,8 @@ unordered_map<string, unordered_set<string>> PKB::getMapResultsOfRS(const Relati
 
 unordered_set<string> PKB::getSetResultsOfAssignPattern(
 	shared_ptr<QueryInput> input, Expression& exp) {
-	unordered_set<string> res = this->expressions[exp];
+	auto it = this->expressions.find(exp);
+	unordered_set<string> res = it == this->expressions.end() ? unordered_set<string>() : it->second;
 	unordered_set<string> ans;
 	if (exp.getType() == ExpressionType::EMPTY) { // any expression
 		res = this->getEntities(EntityType::ASSIGN);
@@ -588,7 +769,7 @@ unordered_set<string> PKB::getSetResultsOfAssignPattern(
 		break;
 	}
 	case QueryInputType::IDENT: { // eg. pattern a("x", _"x"_)
-		unordered_set<string> mod = this->relationsBy[MODIFIES][input->getValue()];
+		unordered_set<string> mod = findValues(this->relationsBy[MODIFIES], input->getValue());
 		for (string x : res) {
 			if (mod.find(x) != mod.end()) {
 				ans.insert(x);
@@ -604,14 +785,15 @@ unordered_set<string> PKB::getSetResultsOfAssignPattern(
 
 unordered_map<string, unordered_set<string>> PKB::getMapResultsOfAssignPattern(
 	shared_ptr<QueryInput> input, Expression& exp) {
-	unordered_set<string> res = this->expressions[exp];
+	auto it = this->expressions.find(exp);
+	unordered_set<string> res = it == this->expressions.end() ? unordered_set<string>() : it->second;
 	unordered_map<string, unordered_set<string>> ans;
 	if (exp.getType() == ExpressionType::EMPTY) { // any expression
 		res = this->getEntities(EntityType::ASSIGN);
 	}
 	// eg. pattern a(v, _"x"_)
 	for (string s : res) {
-		ans[s] = this->relations[MODIFIES][s];
+		ans[s] = findValues(this->relations[MODIFIES], s);
 	}
 	return ans;
 }
@@ -627,7 +809,7 @@ unordered_set<string> PKB::getSetResultsOfContainerPattern(
 		return this->contPatternKeys[t];
 	}
 	case QueryInputType::IDENT: { // eg. pattern w("x", _)
-		return this->contPatternBy[t][input->getValue()];
+		return findValues(this->contPatternBy[t], input->getValue());
 	}
 	default: { } // STMT_NUM
 	}
@@ -648,80 +830,140 @@ unordered_map<string, unordered_set<string>> PKB::getMapResultsOfContainerPatter
 
 unordered_map<string, unordered_set<string>> PKB::getDeclarationsMatchResults(
 	shared_ptr<Declaration> left, shared_ptr<Declaration> right) {
-	EntityType t1 = left->getEntityType();
-	EntityType t2 = right->getEntityType();
-	if ((t1 == EntityType::PROC && t2 == EntityType::VAR) || // eg. p.procName = v.varName
-		(t2 == EntityType::PROC && t1 == EntityType::VAR)) { // eg. v.varName = p.procName
-		return this->procVarName;
-	}
-	else if (t1 == EntityType::CONST) { // eg. c.value = s.stmt#
-		return this->constStmtNum[t2];
-	}
-	else if (t2 == EntityType::CONST) { // eg. s.stmt# = c.value 
-		return this->constStmtNum[t1];
-	}
-	else { // otherwise
-		return unordered_map<string, unordered_set<string>>();
-	}
+	// eg. p.procName = v.varName or c.value = s.stmt#
+	return this->joinAttributes(left->getEntityType(), false, right->getEntityType(), false);
 }
 
 unordered_map<string, unordered_set<string>> PKB::getDeclarationMatchAttributeResults(
 	shared_ptr<Declaration> declaration, EntityType type) {
-	EntityType td = declaration->getEntityType();
-	unordered_map<string, unordered_set<string>> ans;
-	int t = type == EntityType::CALL ? 0 : type == EntityType::PRINT ? 1 : type == EntityType::READ ? 2 : -1;
-	if (t == -1) {
-		return ans;
+	// eg. v.varName = print.varName or p.procName = call.procName
+	return this->joinAttributes(declaration->getEntityType(), false, type, true);
+}
+
+unordered_map<string, unordered_set<string>> PKB::getAttributesMatchResults(
+	EntityType leftEntityType, EntityType rightEntityType) {
+	// eg. call.procName = read.varName
+	return this->joinAttributes(leftEntityType, true, rightEntityType, true);
+}
+
+unordered_set<string> PKB::getAttributeMatchNameResults(EntityType type, shared_ptr<Ident> name) {
+	return this->getEntitiesWithAttribute(type, true, name->getValue());
+}
+
+string PKB::getNameFromStmtNum(string stmtNum) {
+	auto it = this->nameUsed.find(stmtNum);
+	return it == this->nameUsed.end() ? "" : it->second;
+}
+
+const unordered_set<string>& PKB::findValues(
+	const unordered_map<string, unordered_set<string>>& map, const string& key) {
+	static const unordered_set<string> noValues;
+	auto it = map.find(key);
+	return it == map.end() ? noValues : it->second;
+}
+
+int PKB::toStatementNumber(const string& value) {
+	// statement numbers are written without leading zeros, and fit in an int
+	if (value.empty() || value.size() > 9 || value[0] == '0') {
+		return 0;
 	}
-	else if (td != EntityType::PROC && td != EntityType::VAR) {
-		return ans;
+	int index = 0;
+	for (char c : value) {
+		if (c < '0' || c > '9') {
+			return 0;
+		}
+		index = index * 10 + (c - '0');
 	}
-	else if (t != 0 && td == EntityType::VAR) { // eg. v = print.varName
-		return this->nameUsedBy[t];
+	return index;
+}
+
+bool PKB::isStatementType(const EntityType& type) {
+	return type == EntityType::ASSIGN || type == EntityType::WHILE || type == EntityType::IF ||
+		type == EntityType::READ || type == EntityType::PRINT || type == EntityType::CALL;
+}
+
+bool PKB::isEntity(const EntityType& type, const string& value) {
+	if (type == EntityType::STMT || type == EntityType::PROGLINE) {
+		int statement = toStatementNumber(value);
+		return statement > 0 && statement <= this->number;
 	}
-	else if (t == 0 && td == EntityType::PROC) { // eg. p = call.procName
-		return this->nameUsedBy[t];
+	if (this->isStatementType(type)) {
+		return this->typeBitmaps[(int) type].contains(toStatementNumber(value));
 	}
-	else { // eg. v = call.procName or p = read.varName
-		for (string name : this->entities[td]) {
-			if (!this->nameUsedBy[t][name].empty()) {
-				ans[name] = this->nameUsedBy[t][name];
+	auto it = this->entities.find(type);
+	return it != this->entities.end() && it->second.find(value) != it->second.end();
+}
+
+// attribute index
+
+bool PKB::isSecondaryAttribute(const EntityType& type) {
+	return type == EntityType::CALL || type == EntityType::PRINT || type == EntityType::READ;
+}
+
+vector<string> PKB::getAttributeValues(const EntityType& type, const bool& isAttribute) {
+	vector<string> values;
+	if (isAttribute) {
+		auto index = this->attributeIndex.find(type);
+		if (index != this->attributeIndex.end()) {
+			for (auto& entry : index->second) {
+				values.push_back(entry.first);
 			}
 		}
-		return ans;
 	}
+	else {
+		unordered_set<string> entitiesOfType = this->getEntities(type);
+		values.assign(entitiesOfType.begin(), entitiesOfType.end());
+	}
+	return values;
 }
 
-unordered_map<string, unordered_set<string>> PKB::getAttributesMatchResults(
-	EntityType leftEntityType, EntityType rightEntityType) {
-	int t = rightEntityType == EntityType::CALL ? 0 
-		: rightEntityType == EntityType::PRINT ? 1 
-		: rightEntityType == EntityType::READ ? 2 : -1;
-	unordered_map<string, unordered_set<string>> ans;
-	if (t == -1) {
-		return ans;
-	}
-	for (string s : this->entities[leftEntityType]) {
-		string name = this->nameUsed[s];
-		if (!this->nameUsedBy[t][name].empty()) {
-			ans[s] = this->nameUsedBy[t][name];
+unordered_set<string> PKB::getEntitiesWithAttribute(const EntityType& type, const bool& isAttribute, const string& value) {
+	if (isAttribute) {
+		auto index = this->attributeIndex.find(type);
+		if (index == this->attributeIndex.end()) {
+			return unordered_set<string>();
 		}
+		auto it = index->second.find(value);
+		return it == index->second.end() ? unordered_set<string>() : it->second;
 	}
-	return ans;
-}
-
-unordered_set<string> PKB::getAttributeMatchNameResults(EntityType type, shared_ptr<Ident> name) {
-	int t = type == EntityType::CALL ? 0 : type == EntityType::PRINT ? 1 : type == EntityType::READ ? 2 : -1;
-	if (t == -1) {
+	if (!this->isEntity(type, value)) {
 		return unordered_set<string>();
 	}
-	else {
-		return this->nameUsedBy[t][name->getValue()];
-	}
+	return unordered_set<string>{ value };
 }
 
-string PKB::getNameFromStmtNum(string stmtNum) {
-	return this->nameUsed[stmtNum];
+// iterates the distinct attribute values of the smaller side and probes the index of the other side
+unordered_map<string, unordered_set<string>> PKB::joinAttributes(
+	const EntityType& leftType, const bool& leftIsAttribute,
+	const EntityType& rightType, const bool& rightIsAttribute) {
+	unordered_map<string, unordered_set<string>> ans;
+	if ((leftIsAttribute && !this->isSecondaryAttribute(leftType)) ||
+		(rightIsAttribute && !this->isSecondaryAttribute(rightType))) {
+		return ans;
+	}
+	vector<string> leftValues = this->getAttributeValues(leftType, leftIsAttribute);
+	vector<string> rightValues = this->getAttributeValues(rightType, rightIsAttribute);
+	bool probeLeft = leftValues.size() <= rightValues.size();
+	for (const string& value : probeLeft ? leftValues : rightValues) {
+		unordered_set<string> matches = probeLeft
+			? this->getEntitiesWithAttribute(rightType, rightIsAttribute, value)
+			: this->getEntitiesWithAttribute(leftType, leftIsAttribute, value);
+		if (matches.empty()) {
+			continue;
+		}
+		if (probeLeft) {
+			for (const string& leftEntity : this->getEntitiesWithAttribute(leftType, leftIsAttribute, value)) {
+				ans[leftEntity] = matches;
+			}
+		}
+		else {
+			unordered_set<string> rightEntities = this->getEntitiesWithAttribute(rightType, rightIsAttribute, value);
+			for (const string& leftEntity : matches) {
+				ans[leftEntity] = rightEntities;
+			}
+		}
+	}
+	return ans;
 }
 
 // filtering result
@@ -731,42 +973,47 @@ void PKB::filterSetOfType(const EntityType& type, unordered_set<string>* res) {
 		type == EntityType::STMT || type == EntityType::PROC) {
 		return;
 	}
-	unordered_set<string> ans = *res;
-	for (auto& x : *res) {
-		if (this->types[x] != type) {
-			ans.erase(x);
+	// a bit test of each statement against the bitmap of the type
+	const StatementBitmap& bitmap = this->typeBitmaps[(int) type];
+	for (auto it = res->begin(); it != res->end();) {
+		if (bitmap.contains(toStatementNumber(*it))) {
+			it++;
+		}
+		else {
+			it = res->erase(it);
 		}
 	}
-	*res = ans;
 }
 
 void PKB::filterMapOfType(
 	const EntityType& t1, const EntityType& t2,
 	unordered_map<string, unordered_set<string>>* res) {
 	if (t1 == EntityType::STMT || t1 == EntityType::PROC || t1 == EntityType::PROGLINE) {
-		for (auto& x : *res) filterSetOfType(t2, &((*res)[x.first]));
+		for (auto& x : *res) filterSetOfType(t2, &x.second);
 	}
 	else if (t2 == EntityType::VAR || t2 == EntityType::CONST ||
 		t2 == EntityType::STMT || t2 == EntityType::PROC) {
-		unordered_map<string, unordered_set<string>> ans = *res;
-		for (auto& x : *res) {
-			if (this->types[x.first] != t1) {
-				ans.erase(x.first);
-			}
+		const StatementBitmap& bitmap = this->typeBitmaps[(int) t1];
+		for (auto it = res->begin(); it != res->end();) {
+			it = bitmap.contains(toStatementNumber(it->first)) ? next(it) : res->erase(it);
 		}
-		*res = ans;
 	}
 	else {
-		unordered_map<string, unordered_set<string>> ans = *res;
-		for (auto& x : *res) {
-			if (this->types[x.first] != t1) {
-				ans.erase(x.first);
+		const StatementBitmap& bitmap = this->typeBitmaps[(int) t1];
+		for (auto it = res->begin(); it != res->end();) {
+			if (bitmap.contains(toStatementNumber(it->first))) {
+				filterSetOfType(t2, &it->second);
+				it++;
 			}
 			else {
-				filterSetOfType(t2, &ans[x.first]);
+				it = res->erase(it);
 			}
 		}
-		*res = ans;
 	}
 
-}
\ No newline at end of file
+}
+
+shared_ptr<StatisticsCatalog> PKB::getStatistics() {
+	call_once(*this->isStatisticsBuilt, [this]() { this->buildStatistics(); }); // not initialized yet
+	return this->statistics;
+}
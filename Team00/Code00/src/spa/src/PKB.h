@@ -2,9 +2,12 @@
 
 #include <stdio.h>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 #include "PKBInterface.h"
 #include "EntityType.h"
@@ -13,17 +16,12 @@
 #include "Declaration.h"
 #include "Expression.h"
 #include "Ident.h"
+#include "EnumClassHash.h"
+#include "StatisticsCatalog.h"
+#include "StatementBitmap.h"
 
 using namespace std;
 
-struct EnumClassHash {
-	template <typename T>
-	std::size_t operator()(T t) const
-	{
-		return static_cast<std::size_t>(t);
-	}
-};
-
 struct KeyHasher {
 	std::size_t operator()(const Expression& e) const {
 		using std::size_t;
@@ -203,6 +201,22 @@ public:
 	*/
 	bool insertUsedName(const int& index, const string& name);
 
+	/**
+	* Loads all pairs of a relationship into PKB at once, in place of inserting them one by one.
+	* The pairs are sorted so that each key is converted to a string and hashed only once,
+	* and pairs refused by the matching insert method are skipped.
+	* Different relationships are stored apart and may be loaded in parallel, except uses and modifies,
+	* which both insert their variables.
+	*
+	* @param type
+	* @param pairs the related statements, or statements and variables for uses and modifies
+	*
+	* @return the number of distinct pairs loaded
+	*/
+	int loadRelationship(const RelationshipType& type, vector<pair<int, int>> pairs);
+
+	int loadRelationship(const RelationshipType& type, vector<pair<int, string>> pairs);
+
 	/**
 	* Retrieves indices of all statements of some type as string
 	*
@@ -310,14 +324,24 @@ public:
 	*/
 	string getNameFromStmtNum(string stmtNum);
 
+	/**
+	* Retrieves the statistics collected when PKB is initialized
+	*
+	* @return catalog of entity cardinalities and relationship statistics
+	*/
+	shared_ptr<StatisticsCatalog> getStatistics();
+
 
 private:
 
 	const int number; // number of statement
 
-	unordered_map<string, EntityType> types; // map from index to type
+	vector<EntityType> statementTypes; // type of each statement number, NONETYPE until it is set
+
+	vector<StatementBitmap> typeBitmaps; // statement numbers of each statement type, indexed by EntityType
 
-	unordered_map<EntityType, unordered_set<string>, EnumClassHash> entities; // map from type to indices
+	// names of the VAR, CONST and PROC entities; STMT and PROGLINE are the range 1 to number
+	unordered_map<EntityType, unordered_set<string>, EnumClassHash> entities;
 
 	unordered_map<string, unordered_set<string>> relations[17]; // relationship maps
 
@@ -327,6 +351,8 @@ private:
 
 	unordered_set<string> relationByKeys[17]; // key unordered_set for by-relationships 
 
+	StatementBitmap relationKeyBitmaps[RELATIONSHIP_TYPE_COUNT], relationByKeyBitmaps[RELATIONSHIP_TYPE_COUNT]; // statement numbers among the keys
+
 	// procedure uses / modifies
 
 	unordered_map<string, unordered_set<string>> procUses, procModifies;
@@ -351,19 +377,55 @@ private:
 
 	// with clause
 
-	unordered_map<string, unordered_set<string>> procVarName; // identical procedure and variable names
-
-	unordered_map<EntityType, unordered_map<string, unordered_set<string>>, EnumClassHash> 
-		constStmtNum; // identical constant values and stmt#
-	
 	unordered_map<string, string> nameUsed; // varName for PRINT/READ and procName for CALL 
-	
-	unordered_map<string, unordered_set<string>> nameUsedBy[3]; // set of stmts using a name 
+
+	// attribute index from secondary attribute value to entities, ie. CALL -> procName and READ/PRINT -> varName;
+	// primary attributes (procName, varName, value, stmt#) are the entities themselves and are looked up in entities
+	unordered_map<EntityType, unordered_map<string, unordered_set<string>>, EnumClassHash> attributeIndex;
+
+	// statistics
+
+	shared_ptr<StatisticsCatalog> statistics;
+
+	// statistics are built once, by init or by the first query; query threads may call getStatistics concurrently
+	unique_ptr<once_flag> isStatisticsBuilt;
 
 	// utility methods
 
 	bool insertRelationship(const RelationshipType& type, const string& e1, const string& e2);
 
+	// the checks of the insert method of a relationship between two statements
+	bool isValidPair(const RelationshipType& type, const int& former, const int& latter);
+
+	// indexes the valid pairs of a relationship both ways
+	template <typename V>
+	int loadPairs(const RelationshipType& type, vector<pair<int, V>>& pairs);
+
+	void buildStatistics();
+
+	// lookups used by queries never insert into the maps, so a loaded PKB can answer queries concurrently
+
+	static const unordered_set<string>& findValues(
+		const unordered_map<string, unordered_set<string>>& map, const string& key);
+
+	// statement number written in the string, or 0 if it is not one
+	static int toStatementNumber(const string& value);
+
+	// a statement type with a bitmap of its own, ie. not STMT or PROGLINE
+	bool isStatementType(const EntityType& type);
+
+	bool isEntity(const EntityType& type, const string& value);
+
+	bool isSecondaryAttribute(const EntityType& type);
+
+	vector<string> getAttributeValues(const EntityType& type, const bool& isAttribute);
+
+	unordered_set<string> getEntitiesWithAttribute(const EntityType& type, const bool& isAttribute, const string& value);
+
+	unordered_map<string, unordered_set<string>> joinAttributes(
+		const EntityType& leftType, const bool& leftIsAttribute,
+		const EntityType& rightType, const bool& rightIsAttribute);
+
 	void filterSetOfType(const EntityType& type, unordered_set<string>* res);
 
 	void filterMapOfType(
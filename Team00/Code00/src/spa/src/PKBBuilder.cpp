@@ -0,0 +1,58 @@
+#include <functional>
+
+#include "PKBBuilder.h"
+#include "MorselExecutor.h"
+#include "Tracer.h"
+
+PKBBuilder::PKBBuilder(shared_ptr<PKB> pkb) {
+	this->aPKB = pkb;
+}
+
+void PKBBuilder::addRelationship(const RelationshipType& type, const unordered_map<int, vector<int>>& adjacency) {
+	vector<pair<int, int>>& pairs = this->aStatementPairs[type];
+	for (auto& entry : adjacency) {
+		for (int latter : entry.second) {
+			pairs.emplace_back(entry.first, latter);
+		}
+	}
+}
+
+void PKBBuilder::addRelationship(const RelationshipType& type, const vector<vector<int>>& adjacency) {
+	vector<pair<int, int>>& pairs = this->aStatementPairs[type];
+	for (size_t former = 0; former < adjacency.size(); former++) {
+		for (int latter : adjacency[former]) {
+			pairs.emplace_back(former, latter);
+		}
+	}
+}
+
+void PKBBuilder::addRelationship(const RelationshipType& type, const unordered_map<int, vector<string>>& adjacency) {
+	vector<pair<int, string>>& pairs = this->aVariablePairs[type];
+	for (auto& entry : adjacency) {
+		for (const string& variable : entry.second) {
+			pairs.emplace_back(entry.first, variable);
+		}
+	}
+}
+
+void PKBBuilder::build() {
+	SPA_TRACE_SCOPE("PKBBuilder::build");
+	vector<function<void()>> loads;
+	for (auto& relation : this->aStatementPairs) {
+		RelationshipType type = static_cast<RelationshipType>(relation.first);
+		vector<pair<int, int>>* pairs = &relation.second;
+		loads.push_back([this, type, pairs]() { this->aPKB->loadRelationship(type, move(*pairs)); });
+	}
+	// uses and modifies both insert into the variables, so they are loaded one after the other
+	if (!this->aVariablePairs.empty()) {
+		loads.push_back([this]() {
+			for (auto& relation : this->aVariablePairs) {
+				this->aPKB->loadRelationship(static_cast<RelationshipType>(relation.first), move(relation.second));
+			}
+		});
+	}
+
+	MorselExecutor::runTasks(loads);
+	this->aStatementPairs.clear();
+	this->aVariablePairs.clear();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PKB.h"
+
+using namespace std;
+
+// Bulk-loads whole relationships into a PKB. Each relationship is added as adjacency lists and later
+// loaded by PKB::loadRelationship in one sort-based pass; relationships are stored apart in the PKB,
+// so they are loaded on different threads of MorselExecutor.
+class PKBBuilder {
+private:
+	shared_ptr<PKB> aPKB;
+	map<int, vector<pair<int, int>>> aStatementPairs; // by relationship type
+	map<int, vector<pair<int, string>>> aVariablePairs; // by relationship type
+
+public:
+	PKBBuilder(shared_ptr<PKB> pkb);
+
+	// the statements related to each statement
+	void addRelationship(const RelationshipType& type, const unordered_map<int, vector<int>>& adjacency);
+
+	// the statements related to each statement, indexed by statement number
+	void addRelationship(const RelationshipType& type, const vector<vector<int>>& adjacency);
+
+	// the variables used or modified by each statement
+	void addRelationship(const RelationshipType& type, const unordered_map<int, vector<string>>& adjacency);
+
+	// loads the relationships added so far, on as many threads as MorselExecutor uses for a loop
+	void build();
+};
@@ -10,6 +10,7 @@
 #include "Expression.h"
 #include "Declaration.h"
 #include "Ident.h"
+#include "StatisticsCatalog.h"
 
 using namespace std;
 
@@ -52,4 +53,6 @@ public:
 	virtual unordered_set<string> getAttributeMatchNameResults(EntityType attributeEntityType, shared_ptr<Ident> name) = 0;
 
 	virtual string getNameFromStmtNum(string stmtNum) = 0;
+
+	virtual shared_ptr<StatisticsCatalog> getStatistics() = 0;
 };
\ No newline at end of file
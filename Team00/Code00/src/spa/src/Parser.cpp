@@ -3,6 +3,7 @@ using namespace std;
 #include "Parser.h"
 #include "ExpressionType.h"
 #include "ParserHelper.h"
+#include "Tracer.h"
 
 Parser::Parser(DesignExtractor& extractor) : designExtractor(extractor) {
 	this->numberOfStatements = 0;
@@ -174,6 +175,7 @@ ParseError consumeTerminal(const string& value, SIMPLETokenStream& stream) {
 }
 
 ParseError Parser::parseProgram(SIMPLETokenStream &stream) {
+	SPA_TRACE_SCOPE("parseProgram");
 	while (!stream.isEmpty()) {
 		auto error = parseProcedure(stream);
 		if (error.hasError()) {
@@ -1,4 +1,5 @@
 #include "PatternClause.h"
+#include "MonotonicArena.h"
 
 PatternClause::PatternClause(shared_ptr<Declaration> synonym, shared_ptr<QueryInput> queryInput, shared_ptr<Expression> expression) {
 	this->aLeftInput = dynamic_pointer_cast<QueryInput>(synonym);
@@ -31,4 +32,11 @@ shared_ptr<QueryInput> PatternClause::getLeftInput() {
 
 shared_ptr<QueryInput> PatternClause::getRightInput() {
 	return this->aRightInput;
-}
\ No newline at end of file
+}
+
+shared_ptr<OptionalClause> PatternClause::clone() {
+	if (this->aExpression == nullptr) { // container pattern
+		return MonotonicArena::makeShared<PatternClause>(this->getSynonym(), this->aRightInput);
+	}
+	return MonotonicArena::makeShared<PatternClause>(this->getSynonym(), this->aRightInput, this->aExpression);
+}
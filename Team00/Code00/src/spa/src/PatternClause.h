@@ -17,4 +17,5 @@ public:
 
 	shared_ptr<QueryInput> getLeftInput();
 	shared_ptr<QueryInput> getRightInput();
+	shared_ptr<OptionalClause> clone();
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <iterator>
+
+#include "PipelinedQueryEvaluator.h"
+#include "QueryEvaluator.h"
+#include "SingleRowOperator.h"
+#include "ClauseJoinOperator.h"
+#include "ProjectOperator.h"
+#include "MonotonicArena.h"
+#include "MemoryBudget.h"
+#include "Tracer.h"
+
+PipelinedQueryEvaluator::PipelinedQueryEvaluator(shared_ptr<QueryInterface> query, shared_ptr<PKBInterface> pkb,
+	shared_ptr<ClauseResultCache> clauseCache, size_t batchSize) {
+	this->aQuery = query;
+	this->aPKB = pkb;
+	this->aClauseCache = clauseCache;
+	this->aBatchSize = batchSize;
+}
+
+void PipelinedQueryEvaluator::setLimit(size_t limit) {
+	this->aLimit = limit;
+}
+
+shared_ptr<BindingOperator> PipelinedQueryEvaluator::buildPipeline(vector<shared_ptr<OptionalClause>> clauses) {
+	shared_ptr<BindingOperator> pipeline = MonotonicArena::makeShared<SingleRowOperator>();
+	while (!clauses.empty()) {
+		// the first clause joining on a bound synonym, otherwise the first remaining clause
+		vector<string> boundSynonyms = pipeline->getColumns();
+		auto next = find_if(clauses.begin(), clauses.end(), [&boundSynonyms](shared_ptr<OptionalClause> clause) {
+			for (const string& synonym : clause->getResultSynonyms()) {
+				if (find(boundSynonyms.begin(), boundSynonyms.end(), synonym) != boundSynonyms.end()) {
+					return true;
+				}
+			}
+			return false;
+		});
+		if (next == clauses.end()) {
+			next = clauses.begin();
+		}
+		pipeline = MonotonicArena::makeShared<ClauseJoinOperator>(pipeline, *next, this->aBatchSize);
+		clauses.erase(next);
+	}
+	return pipeline;
+}
+
+vector<shared_ptr<ResultsTable>> PipelinedQueryEvaluator::evaluateProjectedGroups() {
+	SPA_TRACE_SCOPE("evaluateQuery");
+	shared_ptr<ResultsTable> noResults = MonotonicArena::makeShared<ResultsTable>();
+	noResults->setIsNoResult();
+
+	vector<vector<shared_ptr<OptionalClause>>> clauseGroups;
+	QueryEvaluator clauseEvaluator = QueryEvaluator(this->aQuery, this->aPKB, this->aClauseCache);
+	if (!clauseEvaluator.evaluateClauseGroups(clauseGroups)) {
+		return { noResults };
+	}
+
+	vector<string> selectedSynonyms = this->aQuery->getSelectClause()->getSynonyms();
+	vector<shared_ptr<ResultsTable>> groupResults;
+	vector<vector<string>> batch;
+	for (auto& clauseGroup : clauseGroups) {
+		shared_ptr<BindingOperator> pipeline = MonotonicArena::makeShared<ProjectOperator>(buildPipeline(clauseGroup), selectedSynonyms, this->aBatchSize);
+		vector<string> columns = pipeline->getColumns();
+
+		// a group without selected synonyms only needs its first binding
+		if (columns.empty()) {
+			if (!pipeline->next(batch)) {
+				return { noResults };
+			}
+			continue;
+		}
+
+		vector<vector<string>> rows;
+		MemoryBudget::Reservation reservation; // until the rows are held by the table of the group
+		while ((this->aLimit == 0 || rows.size() < this->aLimit) && pipeline->next(batch)) {
+			rows.insert(rows.end(), make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+			reservation.resize(MemoryBudget::estimateRowBytes(rows.size(), columns.size()));
+		}
+		if (rows.empty()) {
+			return { noResults };
+		}
+		if (this->aLimit != 0 && rows.size() > this->aLimit) {
+			rows.resize(this->aLimit);
+		}
+
+		unordered_map<string, int> synonymIndex;
+		for (size_t i = 0; i < columns.size(); i++) {
+			synonymIndex[columns.at(i)] = i;
+		}
+		shared_ptr<ResultsTable> table = MonotonicArena::makeShared<ResultsTable>();
+		table->setTable(move(synonymIndex), move(rows));
+		groupResults.push_back(table);
+	}
+	return groupResults;
+}
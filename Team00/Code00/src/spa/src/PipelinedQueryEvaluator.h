@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "QueryInterface.h"
+#include "PKBInterface.h"
+#include "ResultsTable.h"
+#include "ClauseResultCache.h"
+#include "BindingOperator.h"
+
+// evaluates queries by pulling bindings through a pipeline of operators instead of materializing every
+// intermediate results table. Only the clause results and the distinct selected rows are held in full,
+// and groups without a selected synonym stop at their first binding.
+class PipelinedQueryEvaluator {
+private:
+	shared_ptr<QueryInterface> aQuery;
+	shared_ptr<PKBInterface> aPKB;
+	shared_ptr<ClauseResultCache> aClauseCache;
+	size_t aBatchSize;
+	size_t aLimit = 0;
+
+public:
+	PipelinedQueryEvaluator(shared_ptr<QueryInterface> query, shared_ptr<PKBInterface> pkb,
+		shared_ptr<ClauseResultCache> clauseCache = nullptr, size_t batchSize = 1024);
+
+	// stops each group after the given number of distinct selected rows, 0 for no limit
+	void setLimit(size_t limit);
+
+	/**
+	* Builds the pipeline of a group of evaluated clauses, joining each clause on the synonyms bound before it.
+	* Clauses sharing a synonym with the earlier clauses are joined first.
+	*/
+	shared_ptr<BindingOperator> buildPipeline(vector<shared_ptr<OptionalClause>> clauses);
+
+	// evaluates each group of connected clauses into its distinct selected rows, to be combined by ResultsProjector
+	vector<shared_ptr<ResultsTable>> evaluateProjectedGroups();
+};
@@ -0,0 +1,36 @@
+#include <algorithm>
+
+#include "ProjectOperator.h"
+
+ProjectOperator::ProjectOperator(shared_ptr<BindingOperator> input, const vector<string>& synonyms, size_t batchSize)
+	: BindingOperator(batchSize) {
+	this->aInput = input;
+	vector<string> inputColumns = input->getColumns();
+	for (const string& synonym : synonyms) {
+		auto it = find(inputColumns.begin(), inputColumns.end(), synonym);
+		if (it == inputColumns.end() || find(this->aColumns.begin(), this->aColumns.end(), synonym) != this->aColumns.end()) {
+			continue;
+		}
+		this->aColumns.push_back(synonym);
+		this->aIndices.push_back(it - inputColumns.begin());
+	}
+}
+
+bool ProjectOperator::next(vector<vector<string>>& batch) {
+	batch.clear();
+	// the rows of an input batch are all projected, so an output batch may be up to one input batch larger
+	while (batch.size() < this->aBatchSize && this->aInput->next(this->aInputBatch)) {
+		for (const vector<string>& row : this->aInputBatch) {
+			vector<string> projectedRow;
+			projectedRow.reserve(this->aIndices.size());
+			for (int index : this->aIndices) {
+				projectedRow.push_back(row.at(index));
+			}
+			if (this->aSeenRows.insert(projectedRow).second) {
+				this->aReservation.add(MemoryBudget::estimateRowBytes(1, projectedRow.size()));
+				batch.push_back(projectedRow);
+			}
+		}
+	}
+	return !batch.empty();
+}
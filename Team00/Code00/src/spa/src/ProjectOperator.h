@@ -0,0 +1,21 @@
+#pragma once
+
+#include <set>
+#include "BindingOperator.h"
+#include "MemoryBudget.h"
+
+// keeps the given synonyms of the input rows and drops repeated rows
+class ProjectOperator : public BindingOperator {
+private:
+	shared_ptr<BindingOperator> aInput;
+	vector<int> aIndices; // index of each kept synonym in the input row
+	set<vector<string>> aSeenRows;
+	MemoryBudget::Reservation aReservation; // the seen rows
+	vector<vector<string>> aInputBatch;
+
+public:
+	// synonyms not in the input are left out
+	ProjectOperator(shared_ptr<BindingOperator> input, const vector<string>& synonyms, size_t batchSize);
+
+	bool next(vector<vector<string>>& batch);
+};
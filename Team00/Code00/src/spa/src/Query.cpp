@@ -1,8 +1,9 @@
 #include "Query.h"
+#include "MonotonicArena.h"
 
 Query::Query() {
 	this->aOptionalClauses = vector<shared_ptr<OptionalClause>>();
-	this->aSelectClause = make_shared<SelectClause>();
+	this->aSelectClause = MonotonicArena::makeShared<SelectClause>();
     this->isBooleanQuery = false;
 }
 
@@ -11,22 +12,22 @@ void Query::addDeclarationToSelectClause(shared_ptr<Declaration> declaration) {
 }
 
 void Query::addRelationshipClause(RelationshipType relationshipType, shared_ptr<QueryInput> leftQueryInput, shared_ptr<QueryInput> rightQueryInput) {
-	shared_ptr<RelationshipClause> relationshipClause = make_shared<RelationshipClause>(relationshipType, leftQueryInput, rightQueryInput);
+	shared_ptr<RelationshipClause> relationshipClause = MonotonicArena::makeShared<RelationshipClause>(relationshipType, leftQueryInput, rightQueryInput);
 	this->aOptionalClauses.push_back(dynamic_pointer_cast<OptionalClause>(relationshipClause));
 }
 
 void Query::addAssignPatternClause(shared_ptr<Declaration> synonym, shared_ptr<QueryInput> queryInput, shared_ptr<Expression> expression) {
-	shared_ptr<PatternClause> patternClause = make_shared<PatternClause>(synonym, queryInput, expression);
+	shared_ptr<PatternClause> patternClause = MonotonicArena::makeShared<PatternClause>(synonym, queryInput, expression);
 	this->aOptionalClauses.push_back(dynamic_pointer_cast<OptionalClause>(patternClause));
 }
 
 void Query::addContainerPatternClause(shared_ptr<Declaration> synonym, shared_ptr<QueryInput> queryInput) {
-	shared_ptr<PatternClause> patternClause = make_shared<PatternClause>(synonym, queryInput);
+	shared_ptr<PatternClause> patternClause = MonotonicArena::makeShared<PatternClause>(synonym, queryInput);
 	this->aOptionalClauses.push_back(dynamic_pointer_cast<OptionalClause>(patternClause));
 }
 
 void Query::addWithClause(shared_ptr<QueryInput> leftQueryInput, shared_ptr<QueryInput> rightQueryInput) {
-	shared_ptr<WithClause> withClause = make_shared<WithClause>(leftQueryInput, rightQueryInput);
+	shared_ptr<WithClause> withClause = MonotonicArena::makeShared<WithClause>(leftQueryInput, rightQueryInput);
 	this->aOptionalClauses.push_back(dynamic_pointer_cast<OptionalClause>(withClause));
 }
 
@@ -35,6 +36,10 @@ vector<shared_ptr<OptionalClause>>  Query::getOptionalClauses() {
 	return this->aOptionalClauses;
 }
 
+void Query::setOptionalClauses(vector<shared_ptr<OptionalClause>> optionalClauses) {
+	this->aOptionalClauses = optionalClauses;
+}
+
 shared_ptr<SelectClause> Query::getSelectClause() {
 	return this->aSelectClause;
 }
@@ -49,3 +54,12 @@ bool Query::getIsBooleanQuery()
     return isBooleanQuery;
 }
 
+shared_ptr<Query> Query::clone() {
+	shared_ptr<Query> query = MonotonicArena::makeShared<Query>();
+	query->aSelectClause = this->aSelectClause;
+	query->isBooleanQuery = this->isBooleanQuery;
+	for (shared_ptr<OptionalClause> clause : this->aOptionalClauses) {
+		query->aOptionalClauses.push_back(clause->clone());
+	}
+	return query;
+}
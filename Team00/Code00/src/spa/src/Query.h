@@ -27,7 +27,11 @@ public:
 
 	shared_ptr<SelectClause> getSelectClause();
 	vector<shared_ptr<OptionalClause>> getOptionalClauses();
+	void setOptionalClauses(vector<shared_ptr<OptionalClause>> optionalClauses);
     void setIsBooleanQuery();
     bool getIsBooleanQuery();
 
+	// copy sharing the select clause and query inputs, with fresh clauses to hold results
+	shared_ptr<Query> clone();
+
 };
\ No newline at end of file
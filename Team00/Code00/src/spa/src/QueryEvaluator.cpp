@@ -1,59 +1,56 @@
 #include "QueryEvaluator.h"
+#include "MonotonicArena.h"
+#include "Tracer.h"
+#include "CancellationToken.h"
 
 QueryEvaluator::QueryEvaluator(shared_ptr<QueryInterface> query, shared_ptr<PKBInterface> pkb) {
 	this->aQuery = query;
 	this->aPKB = pkb;
 }
 
-shared_ptr<ResultsTable> QueryEvaluator::evaluate() {
-	vector<shared_ptr<OptionalClause>> clauses = aQuery->getOptionalClauses();
+QueryEvaluator::QueryEvaluator(shared_ptr<QueryInterface> query, shared_ptr<PKBInterface> pkb, shared_ptr<ClauseResultCache> clauseCache) {
+	this->aQuery = query;
+	this->aPKB = pkb;
+	this->aClauseCache = clauseCache;
+}
 
-	// return this if any of the clauses has empty results
-	shared_ptr<ResultsTable> noResults = make_shared<ResultsTable>(); 
-	noResults->setIsNoResult();
+void QueryEvaluator::setExistentialMode(bool isExistential) {
+	this->isExistentialMode = isExistential;
+}
 
-	// evaluate the results for each clause first, results from PKB will be stored in each clause object
-	for (vector<shared_ptr<OptionalClause>>::iterator iterator = clauses.begin(); iterator != clauses.end(); iterator++) {
-		shared_ptr<OptionalClause> clause = *iterator;
-		ClauseType clauseType = clause->getClauseType();
+void QueryEvaluator::setBatchResults(shared_ptr<BatchResults> batchResults) {
+	this->aBatchResults = batchResults;
+}
 
-		switch (clauseType) {
-		case ClauseType::RELATIONSHIP: 
-			if (!evaluateRelationshipClause(clause)) {
-				return noResults;
-			}
-			break;
-		
-		case ClauseType::PATTERN:
-			if (!evaluatePatternClause(clause)) {
-				return noResults;
-			}
-			break;
-	
-		case ClauseType::WITH:
-			if (!evaluateWithClause(clause)) {
-				return noResults;
-			}
-			break;
+void QueryEvaluator::setProfile(shared_ptr<QueryProfile> profile) {
+	this->aProfile = profile;
+}
 
-		default:
-			break;
-		}
-	}
+shared_ptr<ResultsTable> QueryEvaluator::evaluate() {
+	// return this if any of the clauses has empty results
+	shared_ptr<ResultsTable> noResults = MonotonicArena::makeShared<ResultsTable>(); 
+	noResults->setIsNoResult();
 
-	// Optimization steps:
-	// sort clauses by non-decreasing result size, and then 
-	// seperate them into groups in which a clause has at least one synonym that has been in a previous clause
-	clauses = QueryOptimizer::sortClausesByResultSize(clauses);
-	vector<vector<shared_ptr<OptionalClause>>> clauseGroups = QueryOptimizer::sortClausesIntoGroups(clauses);
+	vector<vector<shared_ptr<OptionalClause>>> clauseGroups;
+	this->canDeferClauses = true;
+	if (!evaluateClauseGroups(clauseGroups)) {
+		return noResults;
+	}
 
-	
 	// Merge the results of the clauses within each group
 	vector<shared_ptr<ResultsTable>> groupResults = {};
 	for (vector<vector<shared_ptr<OptionalClause>>>::iterator it = clauseGroups.begin(); it != clauseGroups.end(); it++) {
 		vector<shared_ptr<OptionalClause>> clauseGroup = *it;
-		shared_ptr<ResultsTable> resultsTable = make_shared<ResultsTable>();
-		resultsTable = mergeClauses(clauseGroup, resultsTable);
+
+		// a group that is not projected only needs a witness, not its joined results
+		if (this->isExistentialMode && !hasSelectedSynonym(clauseGroup)) {
+			if (!evaluateExistentialGroup(clauseGroup)) {
+				return noResults;
+			}
+			continue;
+		}
+
+		shared_ptr<ResultsTable> resultsTable = evaluateClauseGroup(clauseGroup);
 
 		if (resultsTable->isNoResult()) {
 			return noResults;
@@ -66,10 +63,21 @@ shared_ptr<ResultsTable> QueryEvaluator::evaluate() {
 	groupResults = QueryOptimizer::sortTablesBySize(groupResults);
 
 	// Merge the results of all clause group to get final results
-	shared_ptr<ResultsTable> currentResults = make_shared<ResultsTable>();
+	shared_ptr<ResultsTable> currentResults = MonotonicArena::makeShared<ResultsTable>();
 	for (vector<shared_ptr<ResultsTable>>::iterator it = groupResults.begin(); it != groupResults.end(); it++) {
 		shared_ptr<ResultsTable> groupResult = *it;
+		auto start = chrono::steady_clock::now();
+		int inputRows = groupResult->getTableSize() + currentResults->getTableSize();
 		currentResults = mergeResultTables(groupResult, currentResults);
+		if (aProfile != nullptr) {
+			GroupProfile group;
+			group.step = "merge tables";
+			group.joinAlgorithm = this->aJoinAlgorithm;
+			group.inputRows = inputRows;
+			group.outputRows = currentResults->isNoResult() ? 0 : currentResults->getTableSize();
+			group.millis = QueryProfile::getMillisSince(start);
+			aProfile->recordGroup(group);
+		}
 
 		if (currentResults->isNoResult()) {
 			return noResults;
@@ -79,6 +87,239 @@ shared_ptr<ResultsTable> QueryEvaluator::evaluate() {
 	return currentResults;
 }
 
+vector<shared_ptr<ResultsTable>> QueryEvaluator::evaluateProjectedGroups() {
+	SPA_TRACE_SCOPE("evaluateQuery");
+	shared_ptr<ResultsTable> noResults = MonotonicArena::makeShared<ResultsTable>();
+	noResults->setIsNoResult();
+
+	vector<vector<shared_ptr<OptionalClause>>> clauseGroups;
+	this->canDeferClauses = true;
+	if (!evaluateClauseGroups(clauseGroups)) {
+		return { noResults };
+	}
+
+	vector<string> selectedSynonyms = aQuery->getSelectClause()->getSynonyms();
+	vector<shared_ptr<ResultsTable>> groupResults = {};
+	for (vector<vector<shared_ptr<OptionalClause>>>::iterator it = clauseGroups.begin(); it != clauseGroups.end(); it++) {
+		vector<shared_ptr<OptionalClause>> clauseGroup = *it;
+
+		bool isExistential = !hasSelectedSynonym(clauseGroup);
+		shared_ptr<ResultsTable> resultsTable;
+		if (aBatchResults == nullptr || !aBatchResults->lookupGroup(clauseGroup, isExistential, resultsTable)) {
+			// a group that is not projected only needs a witness
+			if (isExistential) {
+				resultsTable = MonotonicArena::makeShared<ResultsTable>();
+				if (!evaluateExistentialGroup(clauseGroup)) {
+					resultsTable->setIsNoResult();
+				}
+			}
+			else {
+				resultsTable = evaluateClauseGroup(clauseGroup);
+			}
+
+			if (aBatchResults != nullptr) {
+				aBatchResults->storeGroup(clauseGroup, isExistential, resultsTable);
+			}
+		}
+
+		if (resultsTable->isNoResult()) {
+			return { noResults };
+		}
+		if (isExistential) {
+			continue;
+		}
+
+		// the groups are independent, so only their distinct selected values matter for the final combination
+		groupResults.push_back(ResultUtil::getProjectedTable(resultsTable, selectedSynonyms));
+	}
+
+	return groupResults;
+}
+
+bool QueryEvaluator::evaluateClauseGroups(vector<vector<shared_ptr<OptionalClause>>>& clauseGroups) {
+	vector<shared_ptr<OptionalClause>> clauses = aQuery->getOptionalClauses();
+
+	// evaluate the results for each clause first, results from PKB will be stored in each clause object
+	for (vector<shared_ptr<OptionalClause>>::const_iterator iterator = clauses.begin(); iterator != clauses.end(); iterator++) {
+		shared_ptr<OptionalClause> clause = *iterator;
+		bool hasResults = true;
+		auto start = chrono::steady_clock::now();
+		CancellationToken::checkCurrent();
+
+		// an equivalent clause may have been fetched by an earlier query
+		bool isInBatch = aBatchResults != nullptr && aBatchResults->lookupClause(clause, hasResults);
+		if (isInBatch || (aClauseCache != nullptr && aClauseCache->lookup(clause, hasResults))) {
+			if (aProfile != nullptr) {
+				aProfile->recordFetch(clause, isInBatch ? "batch" : "cache", QueryProfile::getMillisSince(start));
+			}
+			if (!hasResults) {
+				return false;
+			}
+			continue;
+		}
+
+		// a large relation may be cheaper to look up per value once the clauses before it are joined
+		if (isDeferrable(clause)) {
+			aDeferredClauses.insert(clause);
+			if (aProfile != nullptr) {
+				aProfile->recordFetch(clause, "deferred", QueryProfile::getMillisSince(start));
+			}
+			continue;
+		}
+
+		if (!fetchClause(clause)) {
+			return false;
+		}
+	}
+
+	// Optimization steps:
+	// sort clauses by non-decreasing result size, and then 
+	// seperate them into groups in which a clause has at least one synonym that has been in a previous clause
+	clauses = QueryOptimizer::sortClausesByResultSize(clauses);
+	clauseGroups = QueryOptimizer::sortClausesIntoGroups(clauses);
+	return true;
+}
+
+bool QueryEvaluator::fetchClause(shared_ptr<OptionalClause> clause) {
+	bool hasResults = true;
+	auto start = chrono::steady_clock::now();
+	switch (clause->getClauseType()) {
+	case ClauseType::RELATIONSHIP: 
+		hasResults = evaluateRelationshipClause(clause);
+		break;
+	
+	case ClauseType::PATTERN:
+		hasResults = evaluatePatternClause(clause);
+		break;
+
+	case ClauseType::WITH:
+		hasResults = evaluateWithClause(clause);
+		break;
+
+	default:
+		break;
+	}
+
+	if (aBatchResults != nullptr) {
+		aBatchResults->storeClause(clause, hasResults);
+	}
+	if (aClauseCache != nullptr) {
+		aClauseCache->store(clause, hasResults);
+	}
+	if (aProfile != nullptr) {
+		aProfile->recordFetch(clause, "pkb", QueryProfile::getMillisSince(start));
+	}
+	return hasResults;
+}
+
+// only relationships between two different synonyms, when joining clauses one by one,
+// and not in a batch whose queries share whole clause results
+bool QueryEvaluator::isDeferrable(shared_ptr<OptionalClause> clause) {
+	if (!this->canDeferClauses || aBatchResults != nullptr || clause->getClauseType() != ClauseType::RELATIONSHIP) {
+		return false;
+	}
+	shared_ptr<QueryInput> leftQueryInput = clause->getLeftInput();
+	shared_ptr<QueryInput> rightQueryInput = clause->getRightInput();
+	if (leftQueryInput->getQueryInputType() != QueryInputType::DECLARATION ||
+		rightQueryInput->getQueryInputType() != QueryInputType::DECLARATION ||
+		leftQueryInput->getValue() == rightQueryInput->getValue()) {
+		return false;
+	}
+
+	shared_ptr<StatisticsCatalog> statistics = aPKB->getStatistics();
+	if (statistics == nullptr) {
+		return false;
+	}
+	RelationshipType relationshipType = dynamic_pointer_cast<RelationshipClause>(clause)->getRelationshipType();
+	double estimatedSize = statistics->estimateResultSize(relationshipType, leftQueryInput, rightQueryInput);
+	if (estimatedSize < MIN_DEFERRED_SIZE) {
+		return false;
+	}
+	clause->addMapResult({}); // a map result of two synonyms, filled in when it is fetched
+	clause->setEstimatedResultSize((int) estimatedSize);
+	return true;
+}
+
+// fetches a deferred clause just before it is joined: if few enough values of one of its synonyms
+// are in the current results, only the pairs of those values are looked up, otherwise the whole relation is read
+bool QueryEvaluator::fetchDeferredClause(shared_ptr<OptionalClause> clause, shared_ptr<ResultsTable> currentResults) {
+	auto start = chrono::steady_clock::now();
+	this->aDeferredClauses.erase(clause);
+	shared_ptr<RelationshipClause> relationshipClause = dynamic_pointer_cast<RelationshipClause>(clause);
+	RelationshipType relationshipType = relationshipClause->getRelationshipType();
+	shared_ptr<Declaration> leftDeclaration = dynamic_pointer_cast<Declaration>(clause->getLeftInput());
+	shared_ptr<Declaration> rightDeclaration = dynamic_pointer_cast<Declaration>(clause->getRightInput());
+	const RelationStatistics& statistics = aPKB->getStatistics()->getClauseRelationStatistics(relationshipType, leftDeclaration);
+
+	// distinct values of each synonym of the clause in the current results
+	const unordered_map<string, int>& synonymIndex = currentResults->getSynonymIndexMap();
+	const vector<vector<string>>& tableValues = currentResults->getTableValues();
+	unordered_set<string> boundValues[2];
+	bool isBound[2] = { false, false };
+	shared_ptr<Declaration> declarations[2] = { leftDeclaration, rightDeclaration };
+	for (int i = 0; i < 2; i++) {
+		auto indexIt = synonymIndex.find(declarations[i]->getValue());
+		if (indexIt == synonymIndex.end()) {
+			continue;
+		}
+		isBound[i] = true;
+		for (const vector<string>& row : tableValues) {
+			boundValues[i].insert(row.at(indexIt->second));
+		}
+	}
+
+	int side = -1;
+	double lookupCost = 0;
+	for (int i = 0; i < 2; i++) {
+		double degree = i == 0 ? statistics.getAverageOutDegree() : statistics.getAverageInDegree();
+		double cost = boundValues[i].size() * (LOOKUP_COST + degree);
+		if (isBound[i] && (side == -1 || cost < lookupCost)) {
+			side = i;
+			lookupCost = cost;
+		}
+	}
+	if (side == -1 || lookupCost >= statistics.pairCount) {
+		return fetchClause(clause);
+	}
+
+	unordered_map<string, unordered_set<string>> results;
+	for (const string& value : boundValues[side]) {
+		CancellationToken::checkCurrent();
+		EntityType boundType = declarations[side]->getEntityType();
+		shared_ptr<QueryInput> boundInput = boundType == EntityType::PROC || boundType == EntityType::VAR
+			? dynamic_pointer_cast<QueryInput>(MonotonicArena::makeShared<Ident>(value))
+			: dynamic_pointer_cast<QueryInput>(MonotonicArena::makeShared<StmtNum>(value));
+
+		if (side == 0) {
+			unordered_set<string> rightValues = aPKB->getSetResultsOfRS(relationshipType, boundInput, rightDeclaration);
+			if (!rightValues.empty()) {
+				results[value] = move(rightValues);
+			}
+		}
+		else {
+			for (const string& leftValue : aPKB->getSetResultsOfRS(relationshipType, leftDeclaration, boundInput)) {
+				results[leftValue].insert(value);
+			}
+		}
+	}
+	bool hasResults = !results.empty();
+	clause->addMapResult(move(results));
+	if (aProfile != nullptr) {
+		aProfile->recordFetch(clause, "lookup", QueryProfile::getMillisSince(start));
+	}
+	return hasResults;
+}
+
+// groups evaluated other than by joining clauses one by one need every clause fetched whole
+bool QueryEvaluator::fetchDeferredClauses(const vector<shared_ptr<OptionalClause>>& clauses) {
+	for (vector<shared_ptr<OptionalClause>>::const_iterator it = clauses.begin(); it != clauses.end(); it++) {
+		if (this->aDeferredClauses.erase(*it) > 0 && !fetchClause(*it)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 bool QueryEvaluator::evaluateRelationshipClause(shared_ptr<OptionalClause> clause) {
 	shared_ptr<RelationshipClause> relationshipClause = dynamic_pointer_cast<RelationshipClause>(clause);
 
@@ -100,15 +341,17 @@ bool QueryEvaluator::evaluateRelationshipClause(shared_ptr<OptionalClause> claus
 		rightQueryInput->getQueryInputType() == QueryInputType::DECLARATION) {
 
 		unordered_map<string, unordered_set<string>> PKBResults = aPKB->getMapResultsOfRS(relationshipType, leftQueryInput, rightQueryInput);
-		clause->addMapResult(PKBResults);
-		return (PKBResults.size() != 0);
+		bool hasResults = PKBResults.size() != 0;
+		clause->addMapResult(move(PKBResults));
+		return hasResults;
 	}
 
 	// only one query input can be declaration
 	unordered_set<string> PKBResults = aPKB->getSetResultsOfRS(relationshipClause->getRelationshipType(),
 		leftQueryInput, rightQueryInput);
-	clause->addSetResult(PKBResults);
-	return (PKBResults.size() != 0);
+	bool hasResults = PKBResults.size() != 0;
+	clause->addSetResult(move(PKBResults));
+	return hasResults;
 }
 
 bool QueryEvaluator::evaluatePatternClause(shared_ptr<OptionalClause> clause) {
@@ -136,8 +379,9 @@ bool QueryEvaluator::evaluatePatternClause(shared_ptr<OptionalClause> clause) {
 			break;
 		}
 
-		clause->addMapResult(PKBResults);
-		return (PKBResults.size() != 0);
+		bool hasResults = PKBResults.size() != 0;
+		clause->addMapResult(move(PKBResults));
+		return hasResults;
 	}
 	else { // else first argument of clause is not a declaration: clause has only 1 declaration (assign/while/if)
 		unordered_set<string> PKBResults;
@@ -155,8 +399,9 @@ bool QueryEvaluator::evaluatePatternClause(shared_ptr<OptionalClause> clause) {
 			break;
 		}
 
-		clause->addSetResult(PKBResults);
-		return (PKBResults.size() != 0);
+		bool hasResults = PKBResults.size() != 0;
+		clause->addSetResult(move(PKBResults));
+		return hasResults;
 	}
 }
 
@@ -208,8 +453,9 @@ bool QueryEvaluator::evaluateTwoDeclarationsWithClause(shared_ptr<Declaration> l
 			(leftEntityType != EntityType::CONST && rightEntityType == EntityType::CONST)) {
 
 			unordered_map<string, unordered_set<string>> PKBResults = aPKB->getDeclarationsMatchResults(leftDeclaration, rightDeclaration);
-			clause->addMapResult(PKBResults);
-			return (PKBResults.size() != 0);
+			bool hasResults = PKBResults.size() != 0;
+			clause->addMapResult(move(PKBResults));
+			return hasResults;
 		}
 		else { // else, both declarations are of the same type: v = v, p = p, s/n = a/w/c/pn/rd/s/n
 
@@ -222,16 +468,18 @@ bool QueryEvaluator::evaluateTwoDeclarationsWithClause(shared_ptr<Declaration> l
 			}
 
 			unordered_set<string> PKBResults = aPKB->getEntities(restrictiveEntityType);
-			clause->addSetResult(PKBResults);
-			return (PKBResults.size() != 0);
+			bool hasResults = PKBResults.size() != 0;
+			clause->addSetResult(move(PKBResults));
+			return hasResults;
 		}
 	}
 
 	// Both are attributes
 	if (leftDeclaration->getIsAttribute() && rightDeclaration->getIsAttribute()) {
 		unordered_map<string, unordered_set<string>> PKBResults = aPKB->getAttributesMatchResults(leftDeclaration->getEntityType(), rightDeclaration->getEntityType());
-		clause->addMapResult(PKBResults);
-		return (PKBResults.size() != 0);
+		bool hasResults = PKBResults.size() != 0;
+		clause->addMapResult(move(PKBResults));
+		return hasResults;
 	}
 
 	// One attribute and one declaration
@@ -247,8 +495,9 @@ bool QueryEvaluator::evaluateTwoDeclarationsWithClause(shared_ptr<Declaration> l
 	}
 
 	unordered_map<string, unordered_set<string>> PKBResults = aPKB->getDeclarationMatchAttributeResults(declaration, attribute->getEntityType());
-	clause->addMapResult(PKBResults);
-	return (PKBResults.size() != 0);
+	bool hasResults = PKBResults.size() != 0;
+	clause->addMapResult(move(PKBResults));
+	return hasResults;
 }
 
 bool QueryEvaluator::evaluateOneDeclarationWithClause(shared_ptr<Declaration> declaration, shared_ptr<QueryInput> queryInput,
@@ -257,8 +506,9 @@ bool QueryEvaluator::evaluateOneDeclarationWithClause(shared_ptr<Declaration> de
 	// One attribute and one ident
 	if (declaration->getIsAttribute()) {
 		unordered_set<string> PKBResults = aPKB->getAttributeMatchNameResults(declaration->getEntityType(), dynamic_pointer_cast<Ident>(queryInput));
-		clause->addSetResult(PKBResults);
-		return (PKBResults.size() != 0);
+		bool hasResults = PKBResults.size() != 0;
+		clause->addSetResult(move(PKBResults));
+		return hasResults;
 	}
 	else { // One declaration and one stmtNum/Ident
 		unordered_set<string> PKBResults = aPKB->getEntities(declaration->getEntityType());
@@ -272,13 +522,44 @@ bool QueryEvaluator::evaluateOneDeclarationWithClause(shared_ptr<Declaration> de
 	}
 }
 
-shared_ptr<ResultsTable> QueryEvaluator::mergeClauses(vector<shared_ptr<OptionalClause>> clauses, shared_ptr<ResultsTable> resultsTable) {
+// clauses in a cycle are joined synonym by synonym, as joining them clause by clause
+// can build intermediate tables much larger than the final results
+shared_ptr<ResultsTable> QueryEvaluator::evaluateClauseGroup(const vector<shared_ptr<OptionalClause>>& clauseGroup) {
+	if (DisjointClausesSet::isCyclic(clauseGroup)) {
+		if (!fetchDeferredClauses(clauseGroup)) {
+			shared_ptr<ResultsTable> noResults = MonotonicArena::makeShared<ResultsTable>();
+			noResults->setIsNoResult();
+			return noResults;
+		}
+		auto start = chrono::steady_clock::now();
+		shared_ptr<ResultsTable> results = GenericJoinEvaluator(clauseGroup).evaluate();
+		if (aProfile != nullptr) {
+			aProfile->recordGroup(getGroupProfile("generic join", "join synonym by synonym", clauseGroup,
+				results->isNoResult() ? 0 : results->getTableSize(), start));
+		}
+		return results;
+	}
+	return mergeClauses(clauseGroup, MonotonicArena::makeShared<ResultsTable>());
+}
+
+shared_ptr<ResultsTable> QueryEvaluator::mergeClauses(const vector<shared_ptr<OptionalClause>>& clauses, shared_ptr<ResultsTable> resultsTable) {
 	shared_ptr<ResultsTable> currentResults = resultsTable;
 
-	for (vector<shared_ptr<OptionalClause>>::iterator iterator = clauses.begin(); iterator != clauses.end(); iterator++) {
+	for (vector<shared_ptr<OptionalClause>>::const_iterator iterator = clauses.begin(); iterator != clauses.end(); iterator++) {
 		shared_ptr<OptionalClause> clause = *iterator;
 		ClauseType clauseType = clause->getClauseType();
 
+		// a deferred clause is only fetched now, for the values of its synonyms joined so far
+		if (this->aDeferredClauses.count(clause) > 0 && !fetchDeferredClause(clause, currentResults)) {
+			currentResults->setIsNoResult();
+			return currentResults;
+		}
+
+		CancellationToken::checkCurrent();
+		auto start = chrono::steady_clock::now();
+		int inputRows = currentResults->getTableSize();
+		this->aJoinAlgorithm = "filter"; // clauses without synonyms only keep or drop the whole table
+
 		switch (clauseType) {
 		case ClauseType::RELATIONSHIP:
 			currentResults = mergeRelationshipClause(dynamic_pointer_cast<RelationshipClause>(clause), currentResults);
@@ -296,6 +577,11 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeClauses(vector<shared_ptr<Optional
 			break;
 		}
 
+		if (aProfile != nullptr) {
+			int outputRows = currentResults->isNoResult() ? 0 : currentResults->getTableSize();
+			aProfile->recordMerge(clause, this->aJoinAlgorithm, inputRows, outputRows, QueryProfile::getMillisSince(start));
+		}
+
 		// if the clause does not have any results, no need to continue evaluating
 		if (currentResults->isNoResult()) {
 			return currentResults;
@@ -316,7 +602,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeRelationshipClause(shared_ptr<Rela
 	case (ClauseResultType::MAP): {
 		string leftSynonym = leftQueryInput->getValue();
 		string rightSynonym = rightQueryInput->getValue();
-		unordered_map<string, unordered_set<string>> clauseResults = relationshipClause->getMapResult();
+		unordered_map<string, unordered_set<string>> clauseResults = relationshipClause->takeMapResult();
 		currentResults = mergeMapResults(clauseResults, { leftSynonym, rightSynonym }, currentResults);
 
 		// intermediate results table may become empty after merging
@@ -335,7 +621,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeRelationshipClause(shared_ptr<Rela
 		else {
 			synonym = rightQueryInput->getValue();
 		}
-		unordered_set<string> clauseResults = relationshipClause->getSetResult();
+		unordered_set<string> clauseResults = relationshipClause->takeSetResult();
 
 		currentResults = mergeSetResults(clauseResults, { synonym }, currentResults);
 
@@ -368,7 +654,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergePatternClause(shared_ptr<PatternCl
 
 	switch (clauseResultType) {
 	case (ClauseResultType::MAP): {
-		unordered_map<string, unordered_set<string>> clauseResults = patternClause->getMapResult();
+		unordered_map<string, unordered_set<string>> clauseResults = patternClause->takeMapResult();
 		currentResults = mergeMapResults(clauseResults, { synonym->getValue(), queryInput->getValue() }, currentResults);
 
 		// intermediate results table may become empty after merging
@@ -380,7 +666,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergePatternClause(shared_ptr<PatternCl
 	}
 
 	case (ClauseResultType::SET): {
-		unordered_set<string> clauseResults = patternClause->getSetResult();
+		unordered_set<string> clauseResults = patternClause->takeSetResult();
 
 		currentResults = mergeSetResults(clauseResults, { synonym->getValue() }, currentResults);
 
@@ -431,7 +717,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeTwoDeclarationsWithClause(shared_p
 
 		switch (clauseResultType) {
 		case (ClauseResultType::MAP): {
-			unordered_map<string, unordered_set<string>> clauseResults = withClause->getMapResult();
+			unordered_map<string, unordered_set<string>> clauseResults = withClause->takeMapResult();
 			currentResults = mergeMapResults(clauseResults, { leftSynonym, rightSynonym }, currentResults);
 
 			// intermediate results table may become empty after merging
@@ -443,7 +729,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeTwoDeclarationsWithClause(shared_p
 		}
 
 		case (ClauseResultType::SET): {
-			unordered_set<string> clauseResults = withClause->getSetResult();
+			unordered_set<string> clauseResults = withClause->takeSetResult();
 			currentResults = mergeSetResults(clauseResults, { leftSynonym, rightSynonym }, currentResults);
 
 			// intermediate results table may become empty after merging
@@ -460,7 +746,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeTwoDeclarationsWithClause(shared_p
 	}
 
 	// From here on, result type must be a map (refer to evaluateTwoDeclarationsWithClause function above)
-	unordered_map<string, unordered_set<string>> clauseResults = withClause->getMapResult();
+	unordered_map<string, unordered_set<string>> clauseResults = withClause->takeMapResult();
 
 	// Both are attributes
 	if (leftDeclaration->getIsAttribute() && rightDeclaration->getIsAttribute()) {
@@ -520,7 +806,7 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeOneDeclarationWithClause(shared_pt
 
 	
 	// In this function, the result type must be a set (refer to evaluateOneDeclarationWithClause function above)
-	unordered_set<string> clauseresults = withClause->getSetResult();
+	unordered_set<string> clauseresults = withClause->takeSetResult();
 	currentResults = mergeSetResults(clauseresults, { declaration->getValue() }, currentResults);
 
 	// intermediate results table may become empty after merging
@@ -535,13 +821,15 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeOneDeclarationWithClause(shared_pt
 
 // PKBResult is assumed to be non empty here - QE must check if results from PKB are empty before merging
 // only case when currentResult is empty is when mergining the first PKBResult
-shared_ptr<ResultsTable> QueryEvaluator::mergeMapResults(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms, shared_ptr<ResultsTable> currentResults) {
+shared_ptr<ResultsTable> QueryEvaluator::mergeMapResults(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms, shared_ptr<ResultsTable> currentResults) {
 	if (currentResults->isTableEmpty()) {
+		this->aJoinAlgorithm = QueryProfile::describeJoin(true, {});
 		currentResults->populateWithMap(PKBResults, synonyms);
 		return currentResults;
 	}
 
 	unordered_set<string> commonSynonyms = ResultUtil::getCommonSynonyms(synonyms, currentResults->getSynonyms());
+	this->aJoinAlgorithm = QueryProfile::describeJoin(false, commonSynonyms);
 	if (commonSynonyms.size() == 0) {
 		return ResultUtil::getCartesianProductFromMap(PKBResults, synonyms, currentResults);
 	}
@@ -550,14 +838,16 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeMapResults(unordered_map <string,
 	}
 }
 
-shared_ptr<ResultsTable> QueryEvaluator::mergeSetResults(unordered_set<string> PKBResults, vector<string> synonyms,
+shared_ptr<ResultsTable> QueryEvaluator::mergeSetResults(const unordered_set<string>& PKBResults, const vector<string>& synonyms,
 	shared_ptr<ResultsTable> currentResults) {
 	if (currentResults->isTableEmpty()) {
+		this->aJoinAlgorithm = QueryProfile::describeJoin(true, {});
 		currentResults->populateWithSet(PKBResults, synonyms);
 		return currentResults;
 	}
 
 	unordered_set<string> commonSynonyms = ResultUtil::getCommonSynonyms(synonyms, currentResults->getSynonyms());
+	this->aJoinAlgorithm = QueryProfile::describeJoin(false, commonSynonyms);
 	if (commonSynonyms.size() == 0) {
 		return ResultUtil::getCartesianProductFromSet(PKBResults, synonyms, currentResults);
 	}
@@ -568,14 +858,54 @@ shared_ptr<ResultsTable> QueryEvaluator::mergeSetResults(unordered_set<string> P
 
 shared_ptr<ResultsTable> QueryEvaluator::mergeResultTables(shared_ptr<ResultsTable> groupResult, shared_ptr<ResultsTable> currentResults) {
 	if (currentResults->isTableEmpty()) {
+		this->aJoinAlgorithm = QueryProfile::describeJoin(true, {});
 		return groupResult;
 	}
 
 	unordered_set<string> commonSynonyms = ResultUtil::getCommonSynonyms(groupResult->getSynonyms(), currentResults->getSynonyms());
+	this->aJoinAlgorithm = QueryProfile::describeJoin(false, commonSynonyms);
 	if (commonSynonyms.size() == 0) {
 		return ResultUtil::getCartesianProductOfTables(groupResult, currentResults);
 	}
 	else {
 		return ResultUtil::getNaturalJoinOfTables(groupResult, currentResults, commonSynonyms);
 	}
-}
\ No newline at end of file
+}
+
+bool QueryEvaluator::hasSelectedSynonym(const vector<shared_ptr<OptionalClause>>& clauses) {
+	vector<string> selectedSynonyms = aQuery->getSelectClause()->getSynonyms();
+	unordered_set<string> selected(selectedSynonyms.begin(), selectedSynonyms.end());
+	for (const shared_ptr<OptionalClause>& clause : clauses) {
+		for (const string& synonym : clause->getResultSynonyms()) {
+			if (selected.find(synonym) != selected.end()) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool QueryEvaluator::evaluateExistentialGroup(const vector<shared_ptr<OptionalClause>>& clauseGroup) {
+	if (!fetchDeferredClauses(clauseGroup)) {
+		return false;
+	}
+	auto start = chrono::steady_clock::now();
+	bool hasBinding = ExistentialEvaluator(clauseGroup).hasSatisfyingBinding();
+	if (aProfile != nullptr) {
+		aProfile->recordGroup(getGroupProfile("existential check", "search for one binding", clauseGroup, hasBinding, start));
+	}
+	return hasBinding;
+}
+
+GroupProfile QueryEvaluator::getGroupProfile(const string& step, const string& joinAlgorithm, const vector<shared_ptr<OptionalClause>>& clauseGroup,
+	int outputRows, chrono::steady_clock::time_point start) {
+	GroupProfile group;
+	group.step = step;
+	group.joinAlgorithm = joinAlgorithm;
+	for (shared_ptr<OptionalClause> clause : clauseGroup) {
+		group.inputRows += clause->getResultSize();
+	}
+	group.outputRows = outputRows;
+	group.millis = QueryProfile::getMillisSince(start);
+	return group;
+}
@@ -9,11 +9,32 @@
 #include "ResultUtil.h"
 #include "ResultsTable.h"
 #include "QueryOptimizer.h"
+#include "ExistentialEvaluator.h"
+#include "GenericJoinEvaluator.h"
+#include "ClauseResultCache.h"
+#include "BatchResults.h"
+#include "QueryProfile.h"
+#include "StmtNum.h"
 
 class QueryEvaluator {
 private:
 	shared_ptr<QueryInterface> aQuery;
 	shared_ptr<PKBInterface> aPKB;
+	shared_ptr<ClauseResultCache> aClauseCache;
+	shared_ptr<BatchResults> aBatchResults;
+	bool isExistentialMode = false;
+	bool canDeferClauses = false;
+	unordered_set<shared_ptr<OptionalClause>> aDeferredClauses; // relationship clauses whose results are not fetched yet
+	shared_ptr<QueryProfile> aProfile;
+	string aJoinAlgorithm; // how the last clause or table was merged, only kept for the profile
+
+	bool fetchClause(shared_ptr<OptionalClause> clause);
+
+	bool isDeferrable(shared_ptr<OptionalClause> clause);
+
+	bool fetchDeferredClause(shared_ptr<OptionalClause> clause, shared_ptr<ResultsTable> currentResults);
+
+	bool fetchDeferredClauses(const vector<shared_ptr<OptionalClause>>& clauses);
 
 	bool evaluateRelationshipClause(shared_ptr<OptionalClause> clause);
 
@@ -27,7 +48,9 @@ private:
 	bool evaluateOneDeclarationWithClause(shared_ptr<Declaration> declaration, shared_ptr<QueryInput> queryInput,
 		shared_ptr<OptionalClause> clause);
 
-	shared_ptr<ResultsTable> mergeClauses(vector<shared_ptr<OptionalClause>> clauses, shared_ptr<ResultsTable> resultsTable);
+	shared_ptr<ResultsTable> evaluateClauseGroup(const vector<shared_ptr<OptionalClause>>& clauseGroup);
+
+	shared_ptr<ResultsTable> mergeClauses(const vector<shared_ptr<OptionalClause>>& clauses, shared_ptr<ResultsTable> resultsTable);
 
 	shared_ptr<ResultsTable> mergeRelationshipClause(shared_ptr<RelationshipClause> relationshipClause, shared_ptr<ResultsTable> results);
 
@@ -39,17 +62,54 @@ private:
 	
 	shared_ptr<ResultsTable> mergeOneDeclarationWithClause(shared_ptr<WithClause> withClause, shared_ptr<ResultsTable> results);
 
-	shared_ptr<ResultsTable> mergeMapResults(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+	shared_ptr<ResultsTable> mergeMapResults(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 		shared_ptr<ResultsTable> currentResults);
 
-	shared_ptr<ResultsTable> mergeSetResults(unordered_set<string> PKBResults, vector<string> synonyms,
+	shared_ptr<ResultsTable> mergeSetResults(const unordered_set<string>& PKBResults, const vector<string>& synonyms,
 		shared_ptr<ResultsTable> currentResults);
 
 	shared_ptr<ResultsTable> mergeResultTables(shared_ptr<ResultsTable> groupResult, shared_ptr<ResultsTable> currentResults);
+
+	bool hasSelectedSynonym(const vector<shared_ptr<OptionalClause>>& clauses);
+
+	// only checks that the group has one satisfying binding
+	bool evaluateExistentialGroup(const vector<shared_ptr<OptionalClause>>& clauseGroup);
+
+	// a step on a whole clause group, whose input rows are the results of its clauses
+	GroupProfile getGroupProfile(const string& step, const string& joinAlgorithm, const vector<shared_ptr<OptionalClause>>& clauseGroup,
+		int outputRows, chrono::steady_clock::time_point start);
 	
 public:
 	
+	// a relation between two synonyms looked up once per value of a synonym already joined,
+	// when each value costs about this many pairs less than reading the whole relation
+	static const int LOOKUP_COST = 4;
+
+	// relations estimated smaller than this are always read whole
+	static const int MIN_DEFERRED_SIZE = 256;
+
 	QueryEvaluator(shared_ptr<QueryInterface> query, shared_ptr<PKBInterface> pkb);
 
+	// clause results are looked up in and stored to the given cache, which must only be used with this PKB
+	QueryEvaluator(shared_ptr<QueryInterface> query, shared_ptr<PKBInterface> pkb, shared_ptr<ClauseResultCache> clauseCache);
+
 	shared_ptr<ResultsTable> evaluate();
+
+	// groups of clauses without any selected synonym are only checked for one satisfying binding,
+	// and their synonyms are left out of the evaluated results table
+	void setExistentialMode(bool isExistential);
+
+	// clauses and clause groups shared with other queries of a batch are taken from and given to the batch results
+	void setBatchResults(shared_ptr<BatchResults> batchResults);
+
+	// records the fetch and merge of every clause, and the steps on whole groups, to the given profile
+	void setProfile(shared_ptr<QueryProfile> profile);
+
+	// fetches the results of every clause, and sorts the clauses into groups of connected clauses by result size;
+	// returns false if any clause has no results
+	bool evaluateClauseGroups(vector<vector<shared_ptr<OptionalClause>>>& clauseGroups);
+
+	// evaluates each group of connected clauses separately and projects it to its distinct selected synonyms,
+	// the groups are left to be combined by ResultsProjector
+	vector<shared_ptr<ResultsTable>> evaluateProjectedGroups();
 };
\ No newline at end of file
@@ -17,6 +17,7 @@ public:
 	virtual void addWithClause(shared_ptr<QueryInput> leftQueryInput, shared_ptr<QueryInput> rightQueryInput) = 0;
 	virtual shared_ptr<SelectClause> getSelectClause() = 0;
 	virtual vector<shared_ptr<OptionalClause>> getOptionalClauses() = 0;
+	virtual void setOptionalClauses(vector<shared_ptr<OptionalClause>> optionalClauses) = 0;
     virtual void setIsBooleanQuery() = 0;
     virtual bool getIsBooleanQuery() = 0;
 
@@ -2,6 +2,7 @@
 #include "Tokenizer.h"
 #include "EntitiesTable.h"
 #include "QueryParserErrorUtility.h"
+#include "MonotonicArena.h"
 
 #include <algorithm>  // for std::find
 #include <iterator>  // for std::begin, std::end
@@ -71,6 +72,18 @@ std::shared_ptr<Token> QueryParser::expect(TokenTypes type)
     }
 }
 
+/*
+    This function throws a Syntactic error for the current token in the given clause,
+    or for the end of the query if there are no tokens left.
+*/
+void QueryParser::unexpectedToken(std::string clause)
+{
+    if (!currToken) {
+        QueryParserErrorUtility::unexpectedQueryEndSyntacticException();
+    }
+    QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), clause);
+}
+
 void QueryParser::selectClause()
 {
     // Can have zero or more declarations
@@ -93,7 +106,7 @@ void QueryParser::resultClause()
     if (tuple()) {
         return;
     }
-    QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), RES_CLAUSE_STR);
+    unexpectedToken(RES_CLAUSE_STR);
 }
 
 bool QueryParser::tuple()
@@ -103,10 +116,10 @@ bool QueryParser::tuple()
     }
     else if (accept(TokenTypes::LeftAngleBracket)) {
         if (!elem())  // must have at least one elem in tuple
-            QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), TUPLE_STR);
+            unexpectedToken(TUPLE_STR);
         while (accept(TokenTypes::Comma)) {
             if (!elem())  // must have at least one elem after each comma
-                QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), TUPLE_STR);
+                unexpectedToken(TUPLE_STR);
         }
         expect(TokenTypes::RightAngleBracket);
         return true;
@@ -130,7 +143,7 @@ bool QueryParser::elem()
             // Check for semantically incorrect attribute names for certain synonyms (e.g. constant.procName is invalid)
             QueryParserErrorUtility::semanticCheckInvalidAttrForSynonym(synonyms, attrNameToken->getValue(), token->getValue());
 
-            auto queryInput = std::make_shared<Declaration>(synonyms[token->getValue()], token->getValue());
+            auto queryInput = MonotonicArena::makeShared<Declaration>(synonyms[token->getValue()], token->getValue());
 
             // We call setIsAttribute on Declarations that represent secondary attribute names used for a synonym
             // A secondary attribute is defined as the attribute that is not implied by the synonym alone
@@ -143,7 +156,7 @@ bool QueryParser::elem()
             query->addDeclarationToSelectClause(queryInput);
         }
         else {
-            auto queryInput = std::make_shared<Declaration>(synonyms[token->getValue()], token->getValue());
+            auto queryInput = MonotonicArena::makeShared<Declaration>(synonyms[token->getValue()], token->getValue());
             query->addDeclarationToSelectClause(queryInput);
         }
 
@@ -195,7 +208,7 @@ void QueryParser::relRef()
     if (modifies() || uses() || follows() || parent() || calls() || next() || affects() || nextBip() || affectsBip()) {
         return;
     }
-    QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), RELREF_STR);
+    unexpectedToken(RELREF_STR);
 }
 
 std::shared_ptr<QueryInput> QueryParser::stmtRef(std::set<EntityType> allowedDesignEntities, bool acceptsUnderscore)
@@ -208,18 +221,18 @@ std::shared_ptr<QueryInput> QueryParser::stmtRef(std::set<EntityType> allowedDes
         // Check that synonym has entity that is allowed
         QueryParserErrorUtility::semanticCheckValidSynonymEntityType(synonyms, token->getValue(), allowedDesignEntities);
 
-        return std::make_shared<Declaration>(synonyms[token->getValue()], token->getValue());
+        return MonotonicArena::makeShared<Declaration>(synonyms[token->getValue()], token->getValue());
     }
     token = std::move(accept(TokenTypes::Underscore));
     if (token) {
         QueryParserErrorUtility::semanticCheckWildcardAllowed(acceptsUnderscore, token->getValue(), STMTREF_STR);
-        return std::make_shared<Any>(token->getValue());
+        return MonotonicArena::makeShared<Any>(token->getValue());
     }
     token = std::move(accept(TokenTypes::Integer));
     if (token) {
-        return std::make_shared<StmtNum>(token->getValue());
+        return MonotonicArena::makeShared<StmtNum>(token->getValue());
     }
-    QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), STMTREF_STR);
+    unexpectedToken(STMTREF_STR);
 }
 
 std::shared_ptr<QueryInput> QueryParser::entRef(std::set<EntityType> allowedDesignEntities, bool acceptsUnderscore)
@@ -232,20 +245,20 @@ std::shared_ptr<QueryInput> QueryParser::entRef(std::set<EntityType> allowedDesi
         // Check that synonym has entity that is allowed
         QueryParserErrorUtility::semanticCheckValidSynonymEntityType(synonyms, token->getValue(), allowedDesignEntities);
 
-        return std::make_shared<Declaration>(synonyms[token->getValue()], token->getValue());
+        return MonotonicArena::makeShared<Declaration>(synonyms[token->getValue()], token->getValue());
     }
     token = std::move(accept(TokenTypes::Underscore));
     if (token) {
         QueryParserErrorUtility::semanticCheckWildcardAllowed(acceptsUnderscore, token->getValue(), ENTREF_STR);
-        return std::make_shared<Any>(token->getValue());
+        return MonotonicArena::makeShared<Any>(token->getValue());
     }
     else if (accept(TokenTypes::DoubleQuote)) {
         token = std::move(expect(TokenTypes::Identifier));
         expect(TokenTypes::DoubleQuote);
-        return std::make_shared<Ident>(token->getValue());
+        return MonotonicArena::makeShared<Ident>(token->getValue());
     }
     else {
-        QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), ENTREF_STR);
+        unexpectedToken(ENTREF_STR);
     }
 }
 
@@ -254,7 +267,7 @@ bool QueryParser::modifies()
     if (accept(TokenTypes::Modifies)) {
         expect(TokenTypes::LeftParen);
         std::shared_ptr<QueryInput> leftQueryInput;
-        if (currToken->getType() == TokenTypes::DoubleQuote) {
+        if (currToken && currToken->getType() == TokenTypes::DoubleQuote) {
             leftQueryInput = entRef(EntitiesTable::getRelAllowedLeftEntities(RelationshipType::MODIFIES), false);
         }
         else {
@@ -274,7 +287,7 @@ bool QueryParser::uses()
     if (accept(TokenTypes::Uses)) {
         expect(TokenTypes::LeftParen);
         std::shared_ptr<QueryInput> leftQueryInput;
-        if (currToken->getType() == TokenTypes::DoubleQuote) {
+        if (currToken && currToken->getType() == TokenTypes::DoubleQuote) {
             leftQueryInput = entRef(EntitiesTable::getRelAllowedLeftEntities(RelationshipType::USES), false);
         }
         else {
@@ -569,7 +582,7 @@ std::shared_ptr<QueryInput> QueryParser::ref()
 {
     std::shared_ptr<Token> token = std::move(accept(TokenTypes::Integer));
     if (token) {
-        auto queryInput = std::make_shared<StmtNum>(token->getValue());
+        auto queryInput = MonotonicArena::makeShared<StmtNum>(token->getValue());
         return queryInput;
     }
     token = std::move(accept(TokenTypes::Identifier));
@@ -583,7 +596,7 @@ std::shared_ptr<QueryInput> QueryParser::ref()
             // Check for semantically incorrect attribute names for certain synonyms (e.g. constant.procName is invalid)
             QueryParserErrorUtility::semanticCheckInvalidAttrForSynonym(synonyms, attrNameToken->getValue(), token->getValue());
 
-            queryInput = std::make_shared<Declaration>(synonyms[token->getValue()], token->getValue());
+            queryInput = MonotonicArena::makeShared<Declaration>(synonyms[token->getValue()], token->getValue());
 
             if (EntitiesTable::isSecondaryAttr(synonyms[token->getValue()], attrNameToken->getValue()))
                 queryInput->setIsAttribute();
@@ -592,7 +605,7 @@ std::shared_ptr<QueryInput> QueryParser::ref()
             // Synonym in with clause must be of type prog_line
             QueryParserErrorUtility::semanticCheckWithClauseSynonym(synonyms[token->getValue()], token->getValue());
 
-            queryInput = std::make_shared<Declaration>(synonyms[token->getValue()], token->getValue());
+            queryInput = MonotonicArena::makeShared<Declaration>(synonyms[token->getValue()], token->getValue());
         }
         return queryInput;
     }
@@ -600,12 +613,12 @@ std::shared_ptr<QueryInput> QueryParser::ref()
         token = std::move(expect(TokenTypes::Identifier));
         expect(TokenTypes::DoubleQuote);
 
-        auto queryInput = std::make_shared<Ident>(token->getValue());
+        auto queryInput = MonotonicArena::makeShared<Ident>(token->getValue());
 
         return queryInput;
     }
     // Ref could not be parsed correctly
-    QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), REF_STR);
+    unexpectedToken(REF_STR);
 }
 
 bool QueryParser::patternClause()
@@ -647,7 +660,7 @@ bool QueryParser::patternClause()
 
 void QueryParser::patternAssign(std::string synonymValue)
 {
-    auto synonym = std::make_shared<Declaration>(synonyms[synonymValue], synonymValue);
+    auto synonym = MonotonicArena::makeShared<Declaration>(synonyms[synonymValue], synonymValue);
     expect(TokenTypes::LeftParen);
     std::shared_ptr<QueryInput> queryInput = entRef(EntitiesTable::getPatternAllowedLeftEntities(PatternType::PATTERN_ASSIGN), true);
     expect(TokenTypes::Comma);
@@ -658,7 +671,7 @@ void QueryParser::patternAssign(std::string synonymValue)
 
 void QueryParser::patternWhile(std::string synonymValue)
 {
-    auto synonym = std::make_shared<Declaration>(synonyms[synonymValue], synonymValue);
+    auto synonym = MonotonicArena::makeShared<Declaration>(synonyms[synonymValue], synonymValue);
     expect(TokenTypes::LeftParen);
     std::shared_ptr<QueryInput> queryInput = entRef(EntitiesTable::getPatternAllowedLeftEntities(PatternType::PATTERN_WHILE), true);
     expect(TokenTypes::Comma);
@@ -669,7 +682,7 @@ void QueryParser::patternWhile(std::string synonymValue)
 
 void QueryParser::patternIf(std::string synonymValue)
 {
-    auto synonym = std::make_shared<Declaration>(synonyms[synonymValue], synonymValue);
+    auto synonym = MonotonicArena::makeShared<Declaration>(synonyms[synonymValue], synonymValue);
     expect(TokenTypes::LeftParen);
     std::shared_ptr<QueryInput> queryInput = entRef(EntitiesTable::getPatternAllowedLeftEntities(PatternType::PATTERN_IF), true);
     expect(TokenTypes::Comma);
@@ -689,17 +702,17 @@ std::shared_ptr<Expression> QueryParser::expressionSpec()
             expression(result);
             expect(TokenTypes::DoubleQuote);
             expect(TokenTypes::Underscore);
-            return std::make_shared<Expression>(result);
+            return MonotonicArena::makeShared<Expression>(result);
         }
         // Parse _ expressionSpec
-        return std::make_shared<Expression>("_", ExpressionType::EMPTY);
+        return MonotonicArena::makeShared<Expression>("_", ExpressionType::EMPTY);
     }
     // Parse "exp" expressionSpec
     expect(TokenTypes::DoubleQuote);
     Expression result("", ExpressionType::EXACT);
     expression(result);
     expect(TokenTypes::DoubleQuote);
-    return std::make_shared<Expression>(result);
+    return MonotonicArena::makeShared<Expression>(result);
 }
 
 void QueryParser::expression(Expression& result)
@@ -746,7 +759,7 @@ void QueryParser::factor(Expression& result)
         return;
     }
     // Factor could not be parsed correctly
-    QueryParserErrorUtility::unexpectedTokenSyntacticException(currToken->toString(), FACTOR_STR);
+    unexpectedToken(FACTOR_STR);
 }
 
 void QueryParser::parse()
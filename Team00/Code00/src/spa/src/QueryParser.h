@@ -29,6 +29,7 @@ private:
     void getNextToken();
     std::shared_ptr<Token> accept(TokenTypes type);
     std::shared_ptr<Token> expect(TokenTypes type);
+    void unexpectedToken(std::string clause);
     std::shared_ptr<QueryInput> expect(std::shared_ptr<QueryInput> queryInput, bool isStmtRef);
     void selectClause();
     void resultClause();
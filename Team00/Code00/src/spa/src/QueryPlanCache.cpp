@@ -0,0 +1,210 @@
+#include <cctype>
+#include <set>
+#include <vector>
+
+#include "QueryPlanCache.h"
+#include "QueryParser.h"
+#include "QueryRewriter.h"
+#include "Tokenizer.h"
+#include "SyntacticException.h"
+#include "SemanticException.h"
+#include "MonotonicArena.h"
+#include "Tracer.h"
+
+namespace {
+	// words the tokenizer gives a meaning of their own, never renamed even when declared as synonyms
+	const set<string> KEYWORDS = { "Select", "such", "that", "pattern", "and", "with", "BOOLEAN",
+		"Modifies", "Uses", "Parent", "Follows", "Calls", "Next", "NextBip", "Affects", "AffectsBip",
+		"stmt", "read", "print", "while", "if", "assign", "variable", "constant", "procedure", "prog_line", "call",
+		"procName", "varName", "value" };
+
+	// single character tokens, whitespace next to them is never significant
+	const string SEPARATORS = "()\",;<>=.+-/%";
+
+	bool isWord(const string& lexeme) {
+		return !lexeme.empty() && isalnum((unsigned char) lexeme[0]);
+	}
+
+	bool isSeparator(const string& lexeme) {
+		return lexeme.size() == 1 && SEPARATORS.find(lexeme[0]) != string::npos;
+	}
+}
+
+QueryPlanCache::QueryPlanCache(size_t capacity) {
+	this->aCapacity = capacity;
+}
+
+QueryPlan QueryPlanCache::getPlan(const string& queryText) {
+	string key = normalize(queryText);
+	{
+		lock_guard<mutex> lock(this->aMutex);
+		auto it = key.empty() ? this->aPlanIndex.end() : this->aPlanIndex.find(key);
+		if (it != this->aPlanIndex.end()) {
+			this->aHitCount++;
+			this->aPlans.splice(this->aPlans.begin(), this->aPlans, it->second);
+			return copyPlan(it->second->second);
+		}
+		this->aMissCount++;
+	}
+
+	// parsed outside the lock, another thread may store an equivalent plan in the meantime
+	QueryPlan plan = buildPlan(queryText);
+	if (key.empty() || this->aCapacity == 0) {
+		return plan;
+	}
+
+	lock_guard<mutex> lock(this->aMutex);
+	if (this->aPlanIndex.find(key) == this->aPlanIndex.end()) {
+		if (this->aPlans.size() >= this->aCapacity) {
+			this->aPlanIndex.erase(this->aPlans.back().first);
+			this->aPlans.pop_back();
+		}
+		this->aPlans.push_front({ key, plan });
+		this->aPlanIndex[key] = this->aPlans.begin();
+	}
+	return copyPlan(plan);
+}
+
+QueryPlan QueryPlanCache::buildPlan(const string& queryText) {
+	SPA_TRACE_SCOPE("parseQuery");
+	// a plan may stay cached long after its query, so it gets an arena of its own rather than pinning the query's
+	MonotonicArena::Scope arenaScope(make_shared<MonotonicArena>());
+	QueryPlan plan;
+	shared_ptr<Query> query = MonotonicArena::makeShared<Query>();
+	shared_ptr<Tokenizer> tokenizer = MonotonicArena::makeShared<Tokenizer>(queryText);
+	QueryParser queryParser = QueryParser{ tokenizer, query };
+	try {
+		queryParser.parse();
+	}
+	catch (SyntacticException& err) {
+		plan.status = QueryPlanStatus::SYNTAX_ERROR;
+		plan.errorMessage = err.what();
+		return plan;
+	}
+	catch (SemanticException& err) {
+		plan.status = QueryPlanStatus::SEMANTIC_ERROR;
+		plan.errorMessage = err.what();
+		plan.isBooleanQuery = query->getIsBooleanQuery();
+		return plan;
+	}
+
+	QueryRewriter::propagateConstants(query);
+	plan.query = query;
+	plan.isBooleanQuery = query->getIsBooleanQuery();
+	return plan;
+}
+
+QueryPlan QueryPlanCache::copyPlan(const QueryPlan& plan) {
+	QueryPlan copy = plan;
+	if (plan.query != nullptr) {
+		copy.query = plan.query->clone();
+	}
+	return copy;
+}
+
+string QueryPlanCache::normalize(const string& queryText) {
+	// '$' is not valid in a query, so renamed synonyms cannot collide with text of another query
+	if (queryText.find('$') != string::npos) {
+		return "";
+	}
+
+	// split into words, quoted regions are kept apart so names inside them are never renamed
+	vector<string> lexemes;
+	vector<bool> isSpaceBefore;
+	vector<bool> isQuoted;
+	bool isInQuotes = false;
+	bool hasSpace = false;
+	for (size_t i = 0; i < queryText.size();) {
+		char c = queryText[i];
+		if (isspace((unsigned char) c)) { // non-ASCII bytes are negative as char
+			hasSpace = true;
+			i++;
+			continue;
+		}
+		size_t length = 1;
+		if (isalnum((unsigned char) c)) {
+			while (i + length < queryText.size() && isalnum((unsigned char) queryText[i + length])) {
+				length++;
+			}
+		}
+		lexemes.push_back(queryText.substr(i, length));
+		isSpaceBefore.push_back(hasSpace);
+		isQuoted.push_back(isInQuotes && c != '"');
+		if (c == '"') {
+			isInQuotes = !isInQuotes;
+		}
+		hasSpace = false;
+		i += length;
+	}
+
+	// collect the declared synonyms: (design-entity synonym (, synonym)* ;)* before Select
+	unordered_map<string, string> renamedSynonyms;
+	size_t index = 0;
+	while (index < lexemes.size() && lexemes[index] != "Select") {
+		if (!isWord(lexemes[index])) {
+			return "";
+		}
+		index++;
+		if (index < lexemes.size() && lexemes[index - 1] == "prog" && lexemes[index] == "_") { // prog_line
+			index += 2;
+		}
+		while (true) {
+			if (index >= lexemes.size() || !isWord(lexemes[index])) {
+				return "";
+			}
+			string synonym = lexemes[index];
+			if (KEYWORDS.find(synonym) == KEYWORDS.end() && renamedSynonyms.find(synonym) == renamedSynonyms.end()) {
+				renamedSynonyms[synonym] = "$" + to_string(renamedSynonyms.size());
+			}
+			index++;
+			if (index < lexemes.size() && lexemes[index] == ",") {
+				index++;
+				continue;
+			}
+			if (index < lexemes.size() && lexemes[index] == ";") {
+				index++;
+				break;
+			}
+			return "";
+		}
+	}
+
+	string key;
+	for (size_t i = 0; i < lexemes.size(); i++) {
+		string lexeme = lexemes[i];
+
+		// a word directly followed by '#', '_' or '*' is part of a longer token (stmt#, prog_line, Follows*),
+		// and a word after '.' is an attribute name
+		bool isPartOfToken = (i > 0 && (lexemes[i - 1] == "." || (lexemes[i - 1] == "_" && !isSpaceBefore[i]))) ||
+			(i + 1 < lexemes.size() && !isSpaceBefore[i + 1] &&
+				(lexemes[i + 1] == "#" || lexemes[i + 1] == "_" || lexemes[i + 1] == "*"));
+		auto renamed = renamedSynonyms.find(lexeme);
+		if (!isQuoted[i] && !isPartOfToken && renamed != renamedSynonyms.end()) {
+			lexeme = renamed->second;
+		}
+
+		// the tokenizer checks for whitespace after prog_line, elsewhere whitespace only separates words
+		bool isSpaceKept = isSpaceBefore[i] && i > 0 &&
+			(!isSeparator(lexemes[i]) || lexemes[i - 1] == "line") && !isSeparator(lexemes[i - 1]);
+		if (isSpaceKept) {
+			key += " ";
+		}
+		key += lexeme;
+	}
+	return key;
+}
+
+size_t QueryPlanCache::getSize() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aPlans.size();
+}
+
+int QueryPlanCache::getHitCount() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aHitCount;
+}
+
+int QueryPlanCache::getMissCount() {
+	lock_guard<mutex> lock(this->aMutex);
+	return this->aMissCount;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Query.h"
+
+using namespace std;
+
+enum class QueryPlanStatus {
+	VALID, SYNTAX_ERROR, SEMANTIC_ERROR,
+	// never the status of a plan, only of a query whose evaluation was cancelled or went over its memory budget
+	TIMEOUT, MEMORY_LIMIT
+};
+
+struct QueryPlan {
+	QueryPlanStatus status = QueryPlanStatus::VALID;
+	shared_ptr<Query> query; // parsed and rewritten query, only set when valid
+	string errorMessage;
+	bool isBooleanQuery = false;
+};
+
+// LRU cache of parsed query plans, keyed on the query text with whitespace and synonym names normalized.
+// Plans handed out hold their own clauses, so the cached plan is never evaluated. Safe to share between threads.
+class QueryPlanCache {
+private:
+	size_t aCapacity;
+	list<pair<string, QueryPlan>> aPlans; // most recently used first
+	unordered_map<string, list<pair<string, QueryPlan>>::iterator> aPlanIndex;
+	int aHitCount = 0;
+	int aMissCount = 0;
+	mutex aMutex;
+
+	static QueryPlan buildPlan(const string& queryText);
+
+	static QueryPlan copyPlan(const QueryPlan& plan);
+
+public:
+	QueryPlanCache(size_t capacity = 1024);
+
+	// runs the query front end (tokenizer, parser and rewriter), or reuses the plan of an equivalent query
+	QueryPlan getPlan(const string& queryText);
+
+	// canonical form of a query, empty if the query is not safe to cache
+	static string normalize(const string& queryText);
+
+	size_t getSize();
+	int getHitCount();
+	int getMissCount();
+};
@@ -0,0 +1,187 @@
+#include <iomanip>
+#include <set>
+
+#include "QueryProfile.h"
+#include "RelationshipClause.h"
+#include "PatternClause.h"
+#include "Declaration.h"
+
+namespace {
+	const unordered_map<int, string> RELATIONSHIP_NAMES = {
+		{ FOLLOWS, "Follows" }, { FOLLOWS_T, "Follows*" }, { PARENT, "Parent" }, { PARENT_T, "Parent*" },
+		{ USES, "Uses" }, { MODIFIES, "Modifies" }, { CALLS, "Calls" }, { CALLS_T, "Calls*" },
+		{ NEXT, "Next" }, { NEXT_T, "Next*" }, { AFFECTS, "Affects" }, { AFFECTS_T, "Affects*" },
+		{ NEXTBIP, "NextBip" }, { NEXTBIP_T, "NextBip*" }, { AFFECTSBIP, "AffectsBip" }, { AFFECTSBIP_T, "AffectsBip*" },
+	};
+
+	string describeInput(shared_ptr<QueryInput> input) {
+		if (input->getQueryInputType() == QueryInputType::IDENT) {
+			return "\"" + input->getValue() + "\"";
+		}
+		shared_ptr<Declaration> declaration = dynamic_pointer_cast<Declaration>(input);
+		if (declaration == nullptr || !declaration->getIsAttribute()) {
+			return input->getValue();
+		}
+		// only the names of calls, reads and prints are attributes other than the synonym itself
+		return input->getValue() + (declaration->getEntityType() == EntityType::CALL ? ".procName" : ".varName");
+	}
+
+	string escapeJson(const string& text) {
+		string escaped;
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+}
+
+string QueryProfile::describeClause(shared_ptr<OptionalClause> clause) {
+	switch (clause->getClauseType()) {
+	case ClauseType::RELATIONSHIP: {
+		auto nameIt = RELATIONSHIP_NAMES.find(dynamic_pointer_cast<RelationshipClause>(clause)->getRelationshipType());
+		string name = nameIt == RELATIONSHIP_NAMES.end() ? "?" : nameIt->second;
+		return name + "(" + describeInput(clause->getLeftInput()) + ", " + describeInput(clause->getRightInput()) + ")";
+	}
+	case ClauseType::PATTERN: {
+		shared_ptr<PatternClause> patternClause = dynamic_pointer_cast<PatternClause>(clause);
+		string description = "pattern " + patternClause->getSynonym()->getValue() + "(" + describeInput(patternClause->getQueryInput());
+		shared_ptr<Expression> expression = patternClause->getExpression();
+		if (expression == nullptr || expression->getType() == ExpressionType::EMPTY) {
+			return description + ", _)";
+		}
+		string value = "\"" + expression->getValue() + "\"";
+		return description + ", " + (expression->getType() == ExpressionType::PARTIAL ? "_" + value + "_" : value) + ")";
+	}
+	case ClauseType::WITH:
+		return "with " + describeInput(clause->getLeftInput()) + " = " + describeInput(clause->getRightInput());
+
+	default:
+		return "?";
+	}
+}
+
+string QueryProfile::describeJoin(bool isFirst, const unordered_set<string>& commonSynonyms) {
+	if (isFirst) {
+		return "scan";
+	}
+	if (commonSynonyms.empty()) {
+		return "cartesian product";
+	}
+	set<string> sortedSynonyms(commonSynonyms.begin(), commonSynonyms.end());
+	string description = "nested-loop join on "; // ResultUtil compares every value with every row
+	for (const string& synonym : sortedSynonyms) {
+		description += (synonym == *sortedSynonyms.begin() ? "" : ", ") + synonym;
+	}
+	return description;
+}
+
+double QueryProfile::getMillisSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+ClauseProfile& QueryProfile::getClauseProfile(shared_ptr<OptionalClause> clause) {
+	auto indexIt = this->aClauseIndex.find(clause.get());
+	if (indexIt != this->aClauseIndex.end()) {
+		return this->aClauses[indexIt->second];
+	}
+	this->aClauseIndex[clause.get()] = this->aClauses.size();
+	this->aClauses.push_back(ClauseProfile());
+	this->aClauses.back().clause = describeClause(clause);
+	return this->aClauses.back();
+}
+
+// a deferred clause is recorded again when it is fetched, with the time of both
+void QueryProfile::recordFetch(shared_ptr<OptionalClause> clause, const string& source, double millis) {
+	ClauseProfile& profile = getClauseProfile(clause);
+	profile.source = source;
+	profile.fetchMillis += millis;
+	if (source == "deferred") {
+		profile.resultSize = 0;
+	}
+	else {
+		profile.resultSize = clause->getClauseResultType() == ClauseResultType::BOOL ? clause->getBoolResult() : clause->getResultSize();
+	}
+}
+
+void QueryProfile::recordMerge(shared_ptr<OptionalClause> clause, const string& joinAlgorithm, int inputRows, int outputRows,
+	double millis) {
+	ClauseProfile& profile = getClauseProfile(clause);
+	profile.joinAlgorithm = joinAlgorithm;
+	profile.inputRows = inputRows;
+	profile.outputRows = outputRows;
+	profile.mergeMillis = millis;
+}
+
+void QueryProfile::recordGroup(const GroupProfile& group) {
+	this->aGroups.push_back(group);
+}
+
+void QueryProfile::recordProjection(double millis, int resultCount) {
+	this->aProjectionMillis = millis;
+	this->aResultCount = resultCount;
+}
+
+void QueryProfile::setTotalMillis(double millis) {
+	this->aTotalMillis = millis;
+}
+
+const vector<ClauseProfile>& QueryProfile::getClauses() const {
+	return this->aClauses;
+}
+
+const vector<GroupProfile>& QueryProfile::getGroups() const {
+	return this->aGroups;
+}
+
+double QueryProfile::getProjectionMillis() const {
+	return this->aProjectionMillis;
+}
+
+int QueryProfile::getResultCount() const {
+	return this->aResultCount;
+}
+
+double QueryProfile::getTotalMillis() const {
+	return this->aTotalMillis;
+}
+
+void QueryProfile::writeText(ostream& out) const {
+	out << fixed << setprecision(3);
+	for (const ClauseProfile& clause : this->aClauses) {
+		out << clause.clause << "  (" << clause.source << " " << clause.fetchMillis << " ms, " << clause.resultSize << " results)";
+		if (!clause.joinAlgorithm.empty()) {
+			out << "  " << clause.joinAlgorithm << " " << clause.inputRows << " -> " << clause.outputRows
+				<< " rows " << clause.mergeMillis << " ms";
+		}
+		out << "\n";
+	}
+	for (const GroupProfile& group : this->aGroups) {
+		out << group.step << "  (" << group.joinAlgorithm << " " << group.inputRows << " -> " << group.outputRows
+			<< " rows " << group.millis << " ms)\n";
+	}
+	out << "projection  (" << this->aResultCount << " results " << this->aProjectionMillis << " ms)\n";
+	out << "total " << this->aTotalMillis << " ms\n";
+	out << defaultfloat;
+}
+
+void QueryProfile::writeJson(ostream& out) const {
+	out << "{\"clauses\":[";
+	for (size_t i = 0; i < this->aClauses.size(); i++) {
+		const ClauseProfile& clause = this->aClauses[i];
+		out << (i == 0 ? "" : ",") << "{\"clause\":\"" << escapeJson(clause.clause) << "\",\"source\":\"" << clause.source
+			<< "\",\"fetchMs\":" << clause.fetchMillis << ",\"resultSize\":" << clause.resultSize
+			<< ",\"joinAlgorithm\":\"" << clause.joinAlgorithm << "\",\"inputRows\":" << clause.inputRows
+			<< ",\"outputRows\":" << clause.outputRows << ",\"mergeMs\":" << clause.mergeMillis << "}";
+	}
+	out << "],\"groups\":[";
+	for (size_t i = 0; i < this->aGroups.size(); i++) {
+		const GroupProfile& group = this->aGroups[i];
+		out << (i == 0 ? "" : ",") << "{\"step\":\"" << group.step << "\",\"joinAlgorithm\":\"" << group.joinAlgorithm
+			<< "\",\"inputRows\":" << group.inputRows << ",\"outputRows\":" << group.outputRows << ",\"ms\":" << group.millis << "}";
+	}
+	out << "],\"projectionMs\":" << this->aProjectionMillis << ",\"resultCount\":" << this->aResultCount
+		<< ",\"totalMs\":" << this->aTotalMillis << "}";
+}
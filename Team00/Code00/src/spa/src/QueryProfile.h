@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "OptionalClause.h"
+
+using namespace std;
+
+// what happened to one clause of a profiled query
+struct ClauseProfile {
+	string clause; // as written in the query, e.g. Follows*(s, 3)
+	string source; // where its results came from: pkb, lookup, cache, batch or deferred (never fetched)
+	double fetchMillis = 0;
+	int resultSize = 0; // pairs or values the clause has
+	string joinAlgorithm; // how it was merged with the clauses before it, empty if it was not merged
+	int inputRows = 0;
+	int outputRows = 0;
+	double mergeMillis = 0;
+};
+
+// a step that works on whole clause groups or result tables rather than one clause
+struct GroupProfile {
+	string step; // generic join, existential check or merge tables
+	string joinAlgorithm;
+	int inputRows = 0;
+	int outputRows = 0;
+	double millis = 0;
+};
+
+// Per query profile, the EXPLAIN ANALYZE of a PQL query: recorded by QueryEvaluator when it is given one,
+// and by QueryService around the projection of the results. Not safe to share between threads.
+class QueryProfile {
+private:
+	vector<ClauseProfile> aClauses;
+	unordered_map<OptionalClause*, size_t> aClauseIndex;
+	vector<GroupProfile> aGroups;
+	double aProjectionMillis = 0;
+	int aResultCount = 0;
+	double aTotalMillis = 0;
+
+	ClauseProfile& getClauseProfile(shared_ptr<OptionalClause> clause);
+
+public:
+	static string describeClause(shared_ptr<OptionalClause> clause);
+
+	// scan for the first clause of a table, otherwise the join of a table with clause results over the common synonyms
+	static string describeJoin(bool isFirst, const unordered_set<string>& commonSynonyms);
+
+	static double getMillisSince(chrono::steady_clock::time_point start);
+
+	void recordFetch(shared_ptr<OptionalClause> clause, const string& source, double millis);
+
+	void recordMerge(shared_ptr<OptionalClause> clause, const string& joinAlgorithm, int inputRows, int outputRows, double millis);
+
+	void recordGroup(const GroupProfile& group);
+
+	void recordProjection(double millis, int resultCount);
+
+	void setTotalMillis(double millis);
+
+	const vector<ClauseProfile>& getClauses() const;
+
+	const vector<GroupProfile>& getGroups() const;
+
+	double getProjectionMillis() const;
+
+	int getResultCount() const;
+
+	double getTotalMillis() const;
+
+	// one line per clause and step, in the order they were evaluated
+	void writeText(ostream& out) const;
+
+	// the same report as a single line of JSON
+	void writeJson(ostream& out) const;
+};
@@ -0,0 +1,113 @@
+#include "QueryRewriter.h"
+#include "StmtNum.h"
+#include "Ident.h"
+#include "MonotonicArena.h"
+
+void QueryRewriter::propagateConstants(shared_ptr<QueryInterface> query) {
+	vector<shared_ptr<OptionalClause>> clauses = query->getOptionalClauses();
+	unordered_map<string, shared_ptr<QueryInput>> bindings = getConstantBindings(clauses);
+	if (bindings.empty()) {
+		return;
+	}
+
+	// with clauses are kept, as they still check that the constant is of the synonym's entity type
+	vector<shared_ptr<OptionalClause>> rewrittenClauses;
+	for (shared_ptr<OptionalClause> clause : clauses) {
+		switch (clause->getClauseType()) {
+		case ClauseType::RELATIONSHIP: {
+			shared_ptr<RelationshipClause> relationshipClause = dynamic_pointer_cast<RelationshipClause>(clause);
+			shared_ptr<QueryInput> leftInput = substitute(relationshipClause->getLeftInput(), bindings);
+			shared_ptr<QueryInput> rightInput = substitute(relationshipClause->getRightInput(), bindings);
+			if (leftInput != relationshipClause->getLeftInput() || rightInput != relationshipClause->getRightInput()) {
+				clause = MonotonicArena::makeShared<RelationshipClause>(relationshipClause->getRelationshipType(), leftInput, rightInput);
+			}
+			break;
+		}
+
+		case ClauseType::PATTERN: {
+			// only the variable can be substituted, pattern results are keyed by the pattern synonym
+			shared_ptr<PatternClause> patternClause = dynamic_pointer_cast<PatternClause>(clause);
+			shared_ptr<QueryInput> queryInput = substitute(patternClause->getQueryInput(), bindings);
+			if (queryInput != patternClause->getQueryInput()) {
+				if (patternClause->getExpression() == nullptr) {
+					clause = MonotonicArena::makeShared<PatternClause>(patternClause->getSynonym(), queryInput);
+				}
+				else {
+					clause = MonotonicArena::makeShared<PatternClause>(patternClause->getSynonym(), queryInput, patternClause->getExpression());
+				}
+			}
+			break;
+		}
+
+		default:
+			break;
+		}
+		rewrittenClauses.push_back(clause);
+	}
+
+	query->setOptionalClauses(rewrittenClauses);
+}
+
+unordered_map<string, shared_ptr<QueryInput>> QueryRewriter::getConstantBindings(vector<shared_ptr<OptionalClause>> clauses) {
+	unordered_map<string, shared_ptr<QueryInput>> bindings;
+	unordered_set<string> conflictingSynonyms;
+
+	for (shared_ptr<OptionalClause> clause : clauses) {
+		if (clause->getClauseType() != ClauseType::WITH) {
+			continue;
+		}
+
+		shared_ptr<QueryInput> leftInput = clause->getLeftInput();
+		shared_ptr<QueryInput> rightInput = clause->getRightInput();
+		shared_ptr<QueryInput> constant;
+		shared_ptr<Declaration> declaration;
+		if (leftInput->getQueryInputType() == QueryInputType::DECLARATION &&
+			rightInput->getQueryInputType() != QueryInputType::DECLARATION) {
+			declaration = dynamic_pointer_cast<Declaration>(leftInput);
+			constant = rightInput;
+		}
+		else if (rightInput->getQueryInputType() == QueryInputType::DECLARATION &&
+			leftInput->getQueryInputType() != QueryInputType::DECLARATION) {
+			declaration = dynamic_pointer_cast<Declaration>(rightInput);
+			constant = leftInput;
+		}
+		else {
+			continue;
+		}
+
+		// secondary attributes (eg. c.procName) do not identify the synonym, and constants never appear in other clauses
+		EntityType entityType = declaration->getEntityType();
+		if (declaration->getIsAttribute() || entityType == EntityType::CONST) {
+			continue;
+		}
+
+		shared_ptr<QueryInput> binding;
+		if (entityType == EntityType::PROC || entityType == EntityType::VAR) {
+			binding = MonotonicArena::makeShared<Ident>(constant->getValue());
+		}
+		else {
+			binding = MonotonicArena::makeShared<StmtNum>(constant->getValue());
+		}
+
+		string synonym = declaration->getValue();
+		auto it = bindings.find(synonym);
+		if (it != bindings.end() && it->second->getValue() != binding->getValue()) {
+			conflictingSynonyms.insert(synonym); // the with clauses alone give an empty result
+		}
+		bindings[synonym] = binding;
+	}
+
+	for (string synonym : conflictingSynonyms) {
+		bindings.erase(synonym);
+	}
+	return bindings;
+}
+
+shared_ptr<QueryInput> QueryRewriter::substitute(shared_ptr<QueryInput> queryInput,
+	unordered_map<string, shared_ptr<QueryInput>>& bindings) {
+	if (queryInput == nullptr || queryInput->getQueryInputType() != QueryInputType::DECLARATION) {
+		return queryInput;
+	}
+	auto it = bindings.find(queryInput->getValue());
+	return it == bindings.end() ? queryInput : it->second;
+}
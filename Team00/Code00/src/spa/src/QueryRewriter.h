@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "QueryInterface.h"
+#include "OptionalClause.h"
+
+class QueryRewriter {
+public:
+	// substitutes synonyms bound to a single constant by with clauses into the other clauses of the query
+	static void propagateConstants(shared_ptr<QueryInterface> query);
+
+	static unordered_map<string, shared_ptr<QueryInput>> getConstantBindings(vector<shared_ptr<OptionalClause>> clauses);
+
+private:
+	static shared_ptr<QueryInput> substitute(shared_ptr<QueryInput> queryInput,
+		unordered_map<string, shared_ptr<QueryInput>>& bindings);
+};
@@ -0,0 +1,242 @@
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#include "QueryService.h"
+#include "QueryEvaluator.h"
+#include "PipelinedQueryEvaluator.h"
+#include "ResultsProjector.h"
+#include "SIMPLETokenStream.h"
+#include "DesignExtractor.h"
+#include "Parser.h"
+#include "MonotonicArena.h"
+#include "Tracer.h"
+#include "QueryTimeoutException.h"
+#include "MemoryBudgetExceededException.h"
+
+QueryService::QueryService() {
+	this->aClauseCache = make_shared<ClauseResultCache>();
+}
+
+bool QueryService::loadSource(const string& filename, string& errorMessage) {
+	SPA_TRACE_SCOPE("loadSource");
+	ifstream in(filename.c_str());
+	if (!in) {
+		errorMessage = "Cannot open the File : " + filename;
+		return false;
+	}
+
+	vector<string> codes;
+	string line;
+	while (getline(in, line)) {
+		if (line.size() > 0) {
+			codes.push_back(line);
+		}
+	}
+	in.close();
+
+	SIMPLETokenStream stream{ move(codes) };
+	DesignExtractor extractor;
+	Parser parser{ extractor };
+	CancellationToken::Scope cancellationScope(makeCancellationToken(0));
+	try {
+		auto error = parser.parseProgram(stream);
+		if (error.hasError()) {
+			errorMessage = error.getErrorMessage();
+			return false;
+		}
+
+		// the extractor is not used again, so it frees its structures as the PKB takes them
+		shared_ptr<PKB> pkb = extractor.handOffToPKB();
+		pkb->init();
+		this->setPKB(pkb);
+	}
+	catch (QueryTimeoutException&) {
+		errorMessage = "Loading " + filename + " was stopped";
+		return false;
+	}
+	return true;
+}
+
+void QueryService::setPKB(shared_ptr<PKB> pkb) {
+	this->aPKB = pkb;
+	this->aClauseCache->clear();
+}
+
+shared_ptr<PKB> QueryService::getPKB() {
+	return this->aPKB;
+}
+
+void QueryService::setPipelined(bool pipelined) {
+	this->isPipelined = pipelined;
+}
+
+void QueryService::setTimeout(int milliseconds) {
+	this->aTimeoutMillis = milliseconds;
+}
+
+void QueryService::setStopFlag(const volatile bool* stopFlag) {
+	this->aStopFlag = stopFlag;
+}
+
+void QueryService::setQueryMemoryBudget(size_t bytes) {
+	this->aQueryMemoryBytes = bytes;
+}
+
+shared_ptr<CancellationToken> QueryService::makeCancellationToken(int timeoutMillis) {
+	if (timeoutMillis <= 0 && this->aStopFlag == nullptr) {
+		return nullptr;
+	}
+	shared_ptr<CancellationToken> cancellationToken = make_shared<CancellationToken>();
+	cancellationToken->setTimeout(timeoutMillis);
+	cancellationToken->setStopFlag(this->aStopFlag);
+	return cancellationToken;
+}
+
+QueryPlanStatus QueryService::evaluate(const string& queryText, list<string>& results, string& errorMessage) {
+	return evaluate(queryText, results, errorMessage, nullptr);
+}
+
+QueryPlanStatus QueryService::evaluate(const string& queryText, list<string>& results, string& errorMessage,
+	shared_ptr<QueryProfile> profile, shared_ptr<CancellationToken> cancellationToken) {
+	SPA_TRACE_SCOPE("query");
+	auto start = chrono::steady_clock::now();
+	CancellationToken::Scope cancellationScope(cancellationToken != nullptr ? cancellationToken : makeCancellationToken(this->aTimeoutMillis));
+	MemoryBudget::Scope memoryScope(make_shared<MemoryBudget>(this->aQueryMemoryBytes, MemoryBudget::getProcessBudget()));
+	// the objects of this query are allocated together and freed together once nothing refers to them
+	MonotonicArena::Scope arenaScope(make_shared<MonotonicArena>());
+	QueryPlan plan = this->aPlanCache.getPlan(queryText);
+	if (plan.status == QueryPlanStatus::SYNTAX_ERROR) { // no results
+		errorMessage = plan.errorMessage;
+		return plan.status;
+	}
+	if (plan.status == QueryPlanStatus::SEMANTIC_ERROR) { // FALSE if Select BOOLEAN, no results otherwise
+		errorMessage = plan.errorMessage;
+		if (plan.isBooleanQuery) {
+			results.push_back("FALSE");
+		}
+		return plan.status;
+	}
+
+	shared_ptr<Query> query = plan.query;
+	vector<shared_ptr<ResultsTable>> groupResults;
+	size_t previousCount = results.size();
+	auto projectionStart = start;
+	bool isPipelinedQuery = this->isPipelined && profile == nullptr;
+	try {
+		try {
+			if (isPipelinedQuery) {
+				groupResults = PipelinedQueryEvaluator(query, this->aPKB, this->aClauseCache).evaluateProjectedGroups();
+			}
+			else {
+				QueryEvaluator queryEvaluator = QueryEvaluator(query, this->aPKB, this->aClauseCache);
+				queryEvaluator.setProfile(profile);
+				groupResults = queryEvaluator.evaluateProjectedGroups();
+			}
+		}
+		catch (MemoryBudgetExceededException&) {
+			if (isPipelinedQuery) {
+				throw;
+			}
+			// joined tables too large for the budget, pulling bindings through only keeps the distinct selected values
+			groupResults = PipelinedQueryEvaluator(query, this->aPKB, this->aClauseCache).evaluateProjectedGroups();
+		}
+
+		projectionStart = chrono::steady_clock::now();
+		ResultsProjector::projectResults(groupResults, query->getSelectClause(), this->aPKB, results);
+	}
+	catch (QueryTimeoutException&) {
+		results.resize(previousCount);
+		errorMessage = "Query stopped after " + to_string((int) QueryProfile::getMillisSince(start)) + " ms";
+		return QueryPlanStatus::TIMEOUT;
+	}
+	catch (MemoryBudgetExceededException& exception) {
+		results.resize(previousCount);
+		errorMessage = string("Query stopped, ") + exception.what();
+		return QueryPlanStatus::MEMORY_LIMIT;
+	}
+	if (profile != nullptr) {
+		profile->recordProjection(QueryProfile::getMillisSince(projectionStart), results.size() - previousCount);
+		profile->setTotalMillis(QueryProfile::getMillisSince(start));
+	}
+	return plan.status;
+}
+
+BatchStatistics QueryService::evaluateBatch(const vector<string>& queryTexts, vector<QueryResponse>& responses) {
+	SPA_TRACE_SCOPE("queryBatch");
+	auto start = chrono::steady_clock::now();
+	MonotonicArena::Scope arenaScope(make_shared<MonotonicArena>());
+	BatchStatistics statistics;
+	statistics.queryCount = queryTexts.size();
+	responses.assign(queryTexts.size(), QueryResponse());
+
+	vector<QueryPlan> plans;
+	vector<shared_ptr<Query>> queries;
+	for (const string& queryText : queryTexts) {
+		plans.push_back(this->aPlanCache.getPlan(queryText));
+		if (plans.back().status == QueryPlanStatus::VALID) {
+			queries.push_back(plans.back().query);
+			statistics.clauseCount += plans.back().query->getOptionalClauses().size();
+		}
+	}
+	statistics.validQueryCount = queries.size();
+
+	shared_ptr<BatchResults> batchResults = make_shared<BatchResults>();
+	batchResults->findSharedPieces(queries);
+
+	for (size_t i = 0; i < plans.size(); i++) {
+		QueryPlan& plan = plans[i];
+		QueryResponse& response = responses[i];
+		response.status = plan.status;
+		response.errorMessage = plan.errorMessage;
+		if (plan.status == QueryPlanStatus::SEMANTIC_ERROR && plan.isBooleanQuery) {
+			response.results.push_back("FALSE");
+		}
+		if (plan.status != QueryPlanStatus::VALID) {
+			continue;
+		}
+
+		auto queryStart = chrono::steady_clock::now();
+		CancellationToken::Scope cancellationScope(makeCancellationToken(this->aTimeoutMillis));
+		MemoryBudget::Scope memoryScope(make_shared<MemoryBudget>(this->aQueryMemoryBytes, MemoryBudget::getProcessBudget()));
+		try {
+			vector<shared_ptr<ResultsTable>> groupResults;
+			try {
+				QueryEvaluator queryEvaluator = QueryEvaluator(plan.query, this->aPKB, this->aClauseCache);
+				queryEvaluator.setBatchResults(batchResults);
+				groupResults = queryEvaluator.evaluateProjectedGroups();
+			}
+			catch (MemoryBudgetExceededException&) { // as in evaluate
+				groupResults = PipelinedQueryEvaluator(plan.query, this->aPKB, this->aClauseCache).evaluateProjectedGroups();
+			}
+			ResultsProjector::projectResults(groupResults, plan.query->getSelectClause(), this->aPKB, response.results);
+		}
+		catch (QueryTimeoutException&) {
+			response.results.clear();
+			response.status = QueryPlanStatus::TIMEOUT;
+			response.errorMessage = "Query stopped after " + to_string((int) QueryProfile::getMillisSince(queryStart)) + " ms";
+			statistics.timedOutQueryCount++;
+		}
+		catch (MemoryBudgetExceededException& exception) {
+			response.results.clear();
+			response.status = QueryPlanStatus::MEMORY_LIMIT;
+			response.errorMessage = string("Query stopped, ") + exception.what();
+			statistics.overBudgetQueryCount++;
+		}
+	}
+
+	statistics.sharedClauseCount = batchResults->getSharedClauseCount();
+	statistics.sharedGroupCount = batchResults->getSharedGroupCount();
+	statistics.reusedClauseCount = batchResults->getReusedClauseCount();
+	statistics.reusedGroupCount = batchResults->getReusedGroupCount();
+	statistics.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return statistics;
+}
+
+QueryPlanCache& QueryService::getPlanCache() {
+	return this->aPlanCache;
+}
+
+shared_ptr<ClauseResultCache> QueryService::getClauseCache() {
+	return this->aClauseCache;
+}
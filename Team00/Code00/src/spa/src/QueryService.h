@@ -0,0 +1,103 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PKB.h"
+#include "QueryPlanCache.h"
+#include "ClauseResultCache.h"
+#include "BatchResults.h"
+#include "QueryProfile.h"
+#include "CancellationToken.h"
+#include "MemoryBudget.h"
+
+using namespace std;
+
+// answer to one query of a batch, as evaluate reports it for a single query
+struct QueryResponse {
+	QueryPlanStatus status = QueryPlanStatus::VALID;
+	list<string> results;
+	string errorMessage; // set when the query is invalid or stopped
+};
+
+// answers PQL queries against one loaded program, keeping the PKB and caches resident between queries.
+// Once a program is loaded, evaluate can be called from several threads at once.
+class QueryService {
+private:
+	shared_ptr<PKB> aPKB;
+	QueryPlanCache aPlanCache;
+	shared_ptr<ClauseResultCache> aClauseCache;
+	bool isPipelined = false;
+	int aTimeoutMillis = 0;
+	const volatile bool* aStopFlag = nullptr;
+	size_t aQueryMemoryBytes = 0;
+
+	shared_ptr<CancellationToken> makeCancellationToken(int timeoutMillis);
+
+public:
+	QueryService();
+
+	/**
+	* Parses a SIMPLE source file and replaces the loaded program
+	*
+	* @param errorMessage set to the reason when the program cannot be loaded
+	* @return true if the program was loaded
+	*/
+	bool loadSource(const string& filename, string& errorMessage);
+
+	// replaces the loaded program, clause results of the previous program are dropped
+	void setPKB(shared_ptr<PKB> pkb);
+
+	shared_ptr<PKB> getPKB();
+
+	// evaluates single queries with PipelinedQueryEvaluator instead of QueryEvaluator
+	void setPipelined(bool pipelined);
+
+	// each query is stopped with QueryPlanStatus::TIMEOUT once it has run this long, 0 for no limit
+	void setTimeout(int milliseconds);
+
+	// loading programs and evaluating queries stop as soon as the flag is set, such as AbstractWrapper::GlobalStop
+	void setStopFlag(const volatile bool* stopFlag);
+
+	/**
+	* Limits the intermediate results of each query; the whole process is limited by MemoryBudget::getProcessBudget.
+	* The clause results fetched from the PKB, the joined tables and the projected rows are all charged to the budget.
+	* A query going over the limit with QueryEvaluator, alone or in a batch, is evaluated again with PipelinedQueryEvaluator,
+	* which only keeps the distinct selected values; if that goes over the limit too, it stops with QueryPlanStatus::MEMORY_LIMIT.
+	*
+	* @param bytes 0 for no limit
+	*/
+	void setQueryMemoryBudget(size_t bytes);
+
+	/**
+	* Evaluates a query and appends its answers to results
+	*
+	* @param errorMessage set to the error when the query is invalid or stopped
+	* @return whether the query was valid, or the kind of error; TIMEOUT and MEMORY_LIMIT leave results as they were
+	*/
+	QueryPlanStatus evaluate(const string& queryText, list<string>& results, string& errorMessage);
+
+	/**
+	* Evaluates a query like evaluate, and records to the profile how each clause was fetched and merged.
+	* Profiled queries are always evaluated by QueryEvaluator, the pipelined evaluator does not record profiles.
+	*
+	* @param profile may be nullptr, then nothing is recorded
+	* @param cancellationToken stops the query when cancelled from another thread, instead of the timeout of the service
+	*/
+	QueryPlanStatus evaluate(const string& queryText, list<string>& results, string& errorMessage, shared_ptr<QueryProfile> profile,
+		shared_ptr<CancellationToken> cancellationToken = nullptr);
+
+	/**
+	* Evaluates a batch of queries, fetching the clauses and merging the clause groups they have in common once
+	*
+	* @param responses set to the status, answers and error of each query, in the order of the queries;
+	* like evaluate, a query stopped at the timeout or its memory budget has TIMEOUT or MEMORY_LIMIT and no answers
+	* @return counts of the shared pieces and the throughput of the batch
+	*/
+	BatchStatistics evaluateBatch(const vector<string>& queryTexts, vector<QueryResponse>& responses);
+
+	QueryPlanCache& getPlanCache();
+
+	shared_ptr<ClauseResultCache> getClauseCache();
+};
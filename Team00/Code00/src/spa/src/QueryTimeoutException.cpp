@@ -0,0 +1,6 @@
+#include "QueryTimeoutException.h"
+
+QueryTimeoutException::QueryTimeoutException(const std::string& what_arg) : std::runtime_error(what_arg)
+{
+
+}
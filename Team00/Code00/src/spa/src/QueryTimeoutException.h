@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdexcept>
+
+// thrown out of evaluation when the cancellation token of the query is cancelled or its deadline has passed
+class QueryTimeoutException : public std::runtime_error {
+public:
+    QueryTimeoutException(const std::string& what_arg);
+};
@@ -1,4 +1,5 @@
 #include "RelationshipClause.h"
+#include "MonotonicArena.h"
 
 RelationshipClause::RelationshipClause(RelationshipType relationshipType, shared_ptr<QueryInput> leftInput, shared_ptr<QueryInput> rightInput) {
 	this->aRelationshipType = relationshipType;
@@ -17,4 +18,8 @@ shared_ptr<QueryInput> RelationshipClause::getLeftInput() {
 
 shared_ptr<QueryInput> RelationshipClause::getRightInput() {
 	return this->aRightInput;
-}
\ No newline at end of file
+}
+
+shared_ptr<OptionalClause> RelationshipClause::clone() {
+	return MonotonicArena::makeShared<RelationshipClause>(this->aRelationshipType, this->aLeftInput, this->aRightInput);
+}
@@ -12,4 +12,5 @@ public:
 	RelationshipType getRelationshipType();
 	shared_ptr<QueryInput> getLeftInput();
 	shared_ptr<QueryInput> getRightInput();
+	shared_ptr<OptionalClause> clone();
 };
\ No newline at end of file
@@ -20,3 +20,6 @@ enum RelationshipType {
 	AFFECTSBIP_T = 16
 };
 
+// number of relationship types, for arrays indexed by RelationshipType
+const int RELATIONSHIP_TYPE_COUNT = AFFECTSBIP_T + 1;
+
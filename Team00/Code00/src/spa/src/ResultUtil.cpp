@@ -1,10 +1,13 @@
 #include "ResultUtil.h"
+#include "MorselExecutor.h"
+#include "MonotonicArena.h"
 #include <map>
+#include <set>
 
-unordered_set<string> ResultUtil::getCommonSynonyms(vector<string> PKBResultSynonyms, unordered_set<string> currentResultSynonyms) {
+unordered_set<string> ResultUtil::getCommonSynonyms(const vector<string>& PKBResultSynonyms, const unordered_set<string>& currentResultSynonyms) {
 	unordered_set<string> commonSynonyms;
 
-	for (vector<string>::iterator it = PKBResultSynonyms.begin(); it != PKBResultSynonyms.end(); it++) {
+	for (vector<string>::const_iterator it = PKBResultSynonyms.begin(); it != PKBResultSynonyms.end(); it++) {
 		if (currentResultSynonyms.find(*it) != currentResultSynonyms.end()) {
 			commonSynonyms.insert(*it);
 		}
@@ -14,10 +17,10 @@ unordered_set<string> ResultUtil::getCommonSynonyms(vector<string> PKBResultSyno
 
 }
 
-unordered_set<string> ResultUtil::getCommonSynonyms(unordered_set<string> groupResultSynonyms, unordered_set<string> currentResultSynonyms) {
+unordered_set<string> ResultUtil::getCommonSynonyms(const unordered_set<string>& groupResultSynonyms, const unordered_set<string>& currentResultSynonyms) {
 	unordered_set<string> commonSynonyms;
 
-	for (unordered_set<string>::iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
+	for (unordered_set<string>::const_iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
 		if (currentResultSynonyms.find(*it) != currentResultSynonyms.end()) {
 			commonSynonyms.insert(*it);
 		}
@@ -29,66 +32,63 @@ unordered_set<string> ResultUtil::getCommonSynonyms(unordered_set<string> groupR
 // used to merge PKB Map results with ResultsTable object that have no common synonyms
 // synonyms assumed to be size 2
 // all inputs assumed to be non empty
-shared_ptr<ResultsTable> ResultUtil::getCartesianProductFromMap(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+shared_ptr<ResultsTable> ResultUtil::getCartesianProductFromMap(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 	shared_ptr<ResultsTable> currentResults) {
 	unordered_map<string, int> synonymIndex = currentResults->getSynonymIndexMap();
-	vector<vector<string>> tableValues = currentResults->getTableValues();
-	vector<vector<string>> newTableValues;
+	const vector<vector<string>>& tableValues = currentResults->getTableValues();
 
-	string leftSynonym = synonyms.at(0);
-	string rightSynonym = synonyms.at(1);
+	const string& leftSynonym = synonyms.at(0);
+	const string& rightSynonym = synonyms.at(1);
 	synonymIndex.insert({ leftSynonym, synonymIndex.size() });
 	synonymIndex.insert({ rightSynonym, synonymIndex.size() });
 
-	for (unordered_map <string, unordered_set<string>>::iterator pkbResultIt = PKBResults.begin();
-		pkbResultIt != PKBResults.end(); pkbResultIt++) {
-		string leftSynonymValue = pkbResultIt->first;
-		unordered_set<string> rightSynonymValues = pkbResultIt->second;
-
-		for (unordered_set<string>::iterator synonymIt = rightSynonymValues.begin(); synonymIt != rightSynonymValues.end();
-			synonymIt++) {
-			string rightSynonymValue = *synonymIt;
+	vector<pair<const string*, const string*>> pairs = getPairs(PKBResults);
+	vector<vector<string>> newTableValues = MorselExecutor::run(pairs.size(), tableValues.size(),
+		[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+		for (size_t i = begin; i < end; i++) {
+			const string& leftSynonymValue = *pairs.at(i).first;
+			const string& rightSynonymValue = *pairs.at(i).second;
 
-			for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-				vector<string> rowCopy(*it);
+			for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+				vector<string> rowCopy = copyRow(*it, 2);
 				rowCopy.push_back(leftSynonymValue);
 				rowCopy.push_back(rightSynonymValue);
-				newTableValues.push_back(rowCopy);
+				rows.push_back(move(rowCopy));
 			}
 		}
-	}
+	});
 
-	currentResults->setTable(synonymIndex, newTableValues);
+	currentResults->setTable(move(synonymIndex), move(newTableValues));
 
 	return currentResults;
 }
 
 // used to merge PKB Set results with ResultsTable object that have no common synonyms
 // all inputs assumed to be non empty
-shared_ptr<ResultsTable> ResultUtil::getCartesianProductFromSet(unordered_set<string> PKBResults, vector<string> synonyms,
+shared_ptr<ResultsTable> ResultUtil::getCartesianProductFromSet(const unordered_set<string>& PKBResults, const vector<string>& synonyms,
 	shared_ptr<ResultsTable> currentResults) {
 	unordered_map<string, int> synonymIndex = currentResults->getSynonymIndexMap();
 	for (size_t i = 0; i < synonyms.size(); i++) {
 		synonymIndex.insert({ synonyms.at(i), synonymIndex.size() });
 	}
 	
-	vector<vector<string>> tableValues = currentResults->getTableValues();
-	vector<vector<string>> newTableValues;
-	for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-
-		for (unordered_set<string>::iterator pkbResultIt = PKBResults.begin(); pkbResultIt != PKBResults.end();
-			pkbResultIt++) {
-			vector<string> rowCopy(*it);
-			string valueToBeAdded = *pkbResultIt;
-			for (size_t i = 0; i < synonyms.size(); i++) {
-				rowCopy.push_back(valueToBeAdded);
+	const vector<vector<string>>& tableValues = currentResults->getTableValues();
+	vector<vector<string>> newTableValues = MorselExecutor::run(tableValues.size(), PKBResults.size(),
+		[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+		for (size_t i = begin; i < end; i++) {
+			for (unordered_set<string>::const_iterator pkbResultIt = PKBResults.begin(); pkbResultIt != PKBResults.end();
+				pkbResultIt++) {
+				vector<string> rowCopy = copyRow(tableValues.at(i), synonyms.size());
+				const string& valueToBeAdded = *pkbResultIt;
+				for (size_t j = 0; j < synonyms.size(); j++) {
+					rowCopy.push_back(valueToBeAdded);
+				}
+				rows.push_back(move(rowCopy));
 			}
-			newTableValues.push_back(rowCopy);
 		}
+	});
 
-	}
-
-	currentResults->setTable(synonymIndex, newTableValues);
+	currentResults->setTable(move(synonymIndex), move(newTableValues));
 
 	return currentResults;
 }
@@ -96,11 +96,11 @@ shared_ptr<ResultsTable> ResultUtil::getCartesianProductFromSet(unordered_set<st
 
 // used to merge PKB Map results with ResultsTable object that have some common synonyms
 // Synonyms is assumed to be of size 2
-shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromMap(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
-	shared_ptr<ResultsTable> currentResults, unordered_set<string> commonSynonyms) {
+shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromMap(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
+	shared_ptr<ResultsTable> currentResults, const unordered_set<string>& commonSynonyms) {
 
-	string leftSynonym = synonyms.at(0);
-	string rightSynonym = synonyms.at(1);
+	const string& leftSynonym = synonyms.at(0);
+	const string& rightSynonym = synonyms.at(1);
 
 	// both are common synonyms
 	if (commonSynonyms.find(leftSynonym) != commonSynonyms.end() &&
@@ -119,35 +119,37 @@ shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromMap(unordered_map <string
 
 // used to merge PKB Set results with ResultsTable object that have some common synonym
 // vector synonyms assumed to have size range of 1 to 2
-shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromSet(unordered_set<string> PKBResults, vector<string> synonyms,
-	shared_ptr<ResultsTable> currentResults, unordered_set<string> commonSynonyms) {
+shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromSet(const unordered_set<string>& PKBResults, const vector<string>& synonyms,
+	shared_ptr<ResultsTable> currentResults, const unordered_set<string>& commonSynonyms) {
 	unordered_map<string, int> synonymIndex = currentResults->getSynonymIndexMap();
-	vector<vector<string>> tableValues = currentResults->getTableValues();
+	const vector<vector<string>>& tableValues = currentResults->getTableValues();
 	vector<vector<string>> newTableValues;
+	vector<const string*> values = getValues(PKBResults);
 
 	// Only one synonym involved - it must be the common synonym
 	if (synonyms.size() == 1) {
 		int index = synonymIndex.find(synonyms.at(0))->second;
 
-		for (unordered_set<string>::iterator pkbResultIt = PKBResults.begin(); pkbResultIt != PKBResults.end();
-			pkbResultIt++) {
-			string valueFromPKB = *pkbResultIt;
+		newTableValues = MorselExecutor::run(values.size(), tableValues.size(),
+			[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+			for (size_t i = begin; i < end; i++) {
+				const string& valueFromPKB = *values.at(i);
 
-			for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-				vector<string> row = *it;
-				if (row.at(index) == valueFromPKB) {
-					newTableValues.push_back(row);
+				for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+					if (it->at(index) == valueFromPKB) {
+						rows.push_back(*it);
+					}
 				}
 			}
-		}
+		});
 
-		currentResults->setTable(synonymIndex, newTableValues);
+		currentResults->setTable(move(synonymIndex), move(newTableValues));
 		return currentResults;
 	}
 
 	// Two synonyms involved - need to find out 1 or 2 common synonyms
-	string leftSynonym = synonyms.at(0);
-	string rightSynonym = synonyms.at(1);
+	const string& leftSynonym = synonyms.at(0);
+	const string& rightSynonym = synonyms.at(1);
 
 	// both are common synonyms - no need to add new synonym to resultsTable
 	if (commonSynonyms.find(leftSynonym) != commonSynonyms.end() &&
@@ -155,17 +157,18 @@ shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromSet(unordered_set<string>
 		int leftSynonymIndex = synonymIndex.find(leftSynonym)->second;
 		int rightSynonymIndex = synonymIndex.find(rightSynonym)->second;
 
-		for (unordered_set<string>::iterator pkbResultsIt = PKBResults.begin(); pkbResultsIt != PKBResults.end(); pkbResultsIt++) {
-			string valueToBeAdded = *pkbResultsIt;
+		newTableValues = MorselExecutor::run(values.size(), tableValues.size(),
+			[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+			for (size_t i = begin; i < end; i++) {
+				const string& valueToBeAdded = *values.at(i);
 
-			for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-				vector<string> row = *it;
-				if (row.at(leftSynonymIndex) == valueToBeAdded && row.at(rightSynonymIndex) == valueToBeAdded) {
-					vector<string> rowCopy(row);
-					newTableValues.push_back(rowCopy);
+				for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+					if (it->at(leftSynonymIndex) == valueToBeAdded && it->at(rightSynonymIndex) == valueToBeAdded) {
+						rows.push_back(*it);
+					}
 				}
 			}
-		}
+		});
 	}
 	else { // exactly one synonym is common
 		string commonSynonym;
@@ -182,62 +185,60 @@ shared_ptr<ResultsTable> ResultUtil::getNaturalJoinFromSet(unordered_set<string>
 		int commonSynonymIndex = synonymIndex.find(commonSynonym)->second;
 		synonymIndex.insert({ uncommonSynonym, synonymIndex.size() });
 
-		for (unordered_set<string>::iterator pkbResultsIt = PKBResults.begin(); pkbResultsIt != PKBResults.end(); pkbResultsIt++) {
-			string valueToBeAdded = *pkbResultsIt;
+		newTableValues = MorselExecutor::run(values.size(), tableValues.size(),
+			[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+			for (size_t i = begin; i < end; i++) {
+				const string& valueToBeAdded = *values.at(i);
 
-			for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-				vector<string> row = *it;
-				if (row.at(commonSynonymIndex) == valueToBeAdded) {
-					vector<string> rowCopy(row);
-					rowCopy.push_back(valueToBeAdded);
-					newTableValues.push_back(rowCopy);
+				for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+					if (it->at(commonSynonymIndex) == valueToBeAdded) {
+						vector<string> rowCopy = copyRow(*it, 1);
+						rowCopy.push_back(valueToBeAdded);
+						rows.push_back(move(rowCopy));
+					}
 				}
 			}
-		}
+		});
 
 	}
 
-	currentResults->setTable(synonymIndex, newTableValues);
+	currentResults->setTable(move(synonymIndex), move(newTableValues));
 	return currentResults;
 }
 
-shared_ptr<ResultsTable> ResultUtil::getNaturalJoinTwoSynonymsCommon(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+shared_ptr<ResultsTable> ResultUtil::getNaturalJoinTwoSynonymsCommon(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 	shared_ptr<ResultsTable> currentResults) {
 	unordered_map<string, int> synonymIndex = currentResults->getSynonymIndexMap();
-	string leftSynonym = synonyms.at(0);
-	string rightSynonym = synonyms.at(1);
+	const string& leftSynonym = synonyms.at(0);
+	const string& rightSynonym = synonyms.at(1);
 	int leftSynonymIndex = synonymIndex.find(leftSynonym)->second;
 	int rightSynonymIndex = synonymIndex.find(rightSynonym)->second;
 
-	vector<vector<string>> tableValues = currentResults->getTableValues();
-	vector<vector<string>> newTableValues;
-
-	for (unordered_map <string, unordered_set<string>>::iterator pkbResultsIt = PKBResults.begin(); pkbResultsIt != PKBResults.end();
-		pkbResultsIt++) {
-		string leftSynonymValue = pkbResultsIt->first;
-		unordered_set<string> rightSynonymValues = pkbResultsIt->second;
-
-		for (unordered_set<string>::iterator rowIt = rightSynonymValues.begin(); rowIt != rightSynonymValues.end(); rowIt++) {
-			string rightSynonymValue = *rowIt;
-			for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-				vector<string> row = *it;
-				if (row.at(leftSynonymIndex) == leftSynonymValue && row.at(rightSynonymIndex) == rightSynonymValue) {
-					vector<string> rowCopy(row);
-					newTableValues.push_back(rowCopy);
+	const vector<vector<string>>& tableValues = currentResults->getTableValues();
+	vector<pair<const string*, const string*>> pairs = getPairs(PKBResults);
+	vector<vector<string>> newTableValues = MorselExecutor::run(pairs.size(), tableValues.size(),
+		[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+		for (size_t i = begin; i < end; i++) {
+			const string& leftSynonymValue = *pairs.at(i).first;
+			const string& rightSynonymValue = *pairs.at(i).second;
+
+			for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+				if (it->at(leftSynonymIndex) == leftSynonymValue && it->at(rightSynonymIndex) == rightSynonymValue) {
+					rows.push_back(*it);
 				}
 			}
 		}
-	}
+	});
 
-	currentResults->setTable(synonymIndex, newTableValues);
+	currentResults->setTable(move(synonymIndex), move(newTableValues));
 	return currentResults;
 }
 
-shared_ptr<ResultsTable> ResultUtil::getNaturalJoinOneSynonymCommon(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+shared_ptr<ResultsTable> ResultUtil::getNaturalJoinOneSynonymCommon(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 	bool isLeftSynonymCommon, shared_ptr<ResultsTable> currentResults) {
 	unordered_map<string, int> synonymIndex = currentResults->getSynonymIndexMap();
-	string leftSynonym = synonyms.at(0);
-	string rightSynonym = synonyms.at(1);
+	const string& leftSynonym = synonyms.at(0);
+	const string& rightSynonym = synonyms.at(1);
 	string commonSynonym;
 	string uncommonSynonym;
 	if (isLeftSynonymCommon) {
@@ -251,97 +252,100 @@ shared_ptr<ResultsTable> ResultUtil::getNaturalJoinOneSynonymCommon(unordered_ma
 	int commonSynonymIndex = synonymIndex.find(commonSynonym)->second;
 	synonymIndex.insert({ uncommonSynonym, synonymIndex.size() });
 
-	vector<vector<string>> tableValues = currentResults->getTableValues();
+	const vector<vector<string>>& tableValues = currentResults->getTableValues();
 	vector<vector<string>> newTableValues;
 
 	if (isLeftSynonymCommon) {
-		for (unordered_map <string, unordered_set<string>>::iterator pkbResultIt = PKBResults.begin();
+		vector<const pair<const string, unordered_set<string>>*> entries;
+		for (unordered_map<string, unordered_set<string>>::const_iterator pkbResultIt = PKBResults.begin();
 			pkbResultIt != PKBResults.end(); pkbResultIt++) {
-			string leftSynonymValue = pkbResultIt->first;
-			unordered_set<string> rightSynonymValues = pkbResultIt->second;
-			
-			for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-				vector<string> row = *it;
-				if (row.at(commonSynonymIndex) == leftSynonymValue) {
-					for (unordered_set<string>::iterator setIt = rightSynonymValues.begin(); setIt != rightSynonymValues.end(); setIt++) {
-						vector<string> rowCopy(row);
-						rowCopy.push_back(*setIt);
-						newTableValues.push_back(rowCopy);
+			entries.push_back(&*pkbResultIt);
+		}
+
+		newTableValues = MorselExecutor::run(entries.size(), tableValues.size(),
+			[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+			for (size_t i = begin; i < end; i++) {
+				const string& leftSynonymValue = entries.at(i)->first;
+				const unordered_set<string>& rightSynonymValues = entries.at(i)->second;
+
+				for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+					if (it->at(commonSynonymIndex) == leftSynonymValue) {
+						for (unordered_set<string>::const_iterator setIt = rightSynonymValues.begin(); setIt != rightSynonymValues.end(); setIt++) {
+							vector<string> rowCopy = copyRow(*it, 1);
+							rowCopy.push_back(*setIt);
+							rows.push_back(move(rowCopy));
+						}
 					}
 				}
 			}
-		}
+		});
 	}
 	else {
-		for (unordered_map <string, unordered_set<string>>::iterator pkbResultIt = PKBResults.begin();
-			pkbResultIt != PKBResults.end(); pkbResultIt++) {
-			string leftSynonymValue = pkbResultIt->first;
-			unordered_set<string> rightSynonymValues = pkbResultIt->second;
-
-			for (unordered_set<string>::iterator setIt = rightSynonymValues.begin(); setIt != rightSynonymValues.end(); setIt++) {
-				string rightSynonymValue = *setIt;
-
-				for (vector<vector<string>>::iterator it = tableValues.begin(); it != tableValues.end(); it++) {
-					vector<string> row = *it;
-					if (row.at(commonSynonymIndex) == rightSynonymValue) {
-						vector<string> rowCopy(row);
+		vector<pair<const string*, const string*>> pairs = getPairs(PKBResults);
+		newTableValues = MorselExecutor::run(pairs.size(), tableValues.size(),
+			[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+			for (size_t i = begin; i < end; i++) {
+				const string& leftSynonymValue = *pairs.at(i).first;
+				const string& rightSynonymValue = *pairs.at(i).second;
+
+				for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+					if (it->at(commonSynonymIndex) == rightSynonymValue) {
+						vector<string> rowCopy = copyRow(*it, 1);
 						rowCopy.push_back(leftSynonymValue);
-						newTableValues.push_back(rowCopy);
+						rows.push_back(move(rowCopy));
 					}
 				}
 			}
-		}
+		});
 	}
 
-	currentResults->setTable(synonymIndex, newTableValues);
+	currentResults->setTable(move(synonymIndex), move(newTableValues));
 	return currentResults;
 }
 
 shared_ptr<ResultsTable> ResultUtil::getCartesianProductOfTables(shared_ptr<ResultsTable> groupResult, shared_ptr<ResultsTable> currentResults) {
 	unordered_set<string> groupResultSynonyms = groupResult->getSynonyms();
 	unordered_map<string, int> currentResultsSynonymIndex = currentResults->getSynonymIndexMap();
-	for (unordered_set<string>::iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
+	for (unordered_set<string>::const_iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
 		string groupResultSynonym = *it;
 		currentResultsSynonymIndex.insert({ groupResultSynonym, currentResultsSynonymIndex.size() });
 	}
 
-	unordered_map<string, int> groupResultSynonymIndex = groupResult->getSynonymIndexMap();
-	vector<vector<string>> currentResultsTableValues = currentResults->getTableValues();
-	vector<vector<string>> groupResultTableValues = groupResult->getTableValues();
-	vector<vector<string>> newTableValues;
-	for (vector<vector<string>>::iterator currentResultIt = currentResultsTableValues.begin();
-		currentResultIt != currentResultsTableValues.end(); currentResultIt++) {
-		vector<string> currentResultRow = (*currentResultIt);
-
-		for (vector<vector<string>>::iterator groupResultIt = groupResultTableValues.begin(); groupResultIt != groupResultTableValues.end(); groupResultIt++) {
-			vector<string>groupResultRow = (*groupResultIt);
-			vector<string> rowCopy(currentResultRow);
-
-			for (unordered_set<string>::iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
-				string groupResultSynonym = *it;
-				int groupResultIndex = groupResultSynonymIndex.find(groupResultSynonym)->second;
-				string value = groupResultRow.at(groupResultIndex);
-				rowCopy.push_back(value);
-			}
+	const unordered_map<string, int>& groupResultSynonymIndex = groupResult->getSynonymIndexMap();
+	const vector<vector<string>>& currentResultsTableValues = currentResults->getTableValues();
+	const vector<vector<string>>& groupResultTableValues = groupResult->getTableValues();
+	vector<vector<string>> newTableValues = MorselExecutor::run(currentResultsTableValues.size(), groupResultTableValues.size(),
+		[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+		for (size_t i = begin; i < end; i++) {
+			const vector<string>& currentResultRow = currentResultsTableValues.at(i);
+
+			for (vector<vector<string>>::const_iterator groupResultIt = groupResultTableValues.begin(); groupResultIt != groupResultTableValues.end(); groupResultIt++) {
+				const vector<string>& groupResultRow = (*groupResultIt);
+				vector<string> rowCopy = copyRow(currentResultRow, groupResultSynonyms.size());
+
+				for (unordered_set<string>::const_iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
+					int groupResultIndex = groupResultSynonymIndex.find(*it)->second;
+					rowCopy.push_back(groupResultRow.at(groupResultIndex));
+				}
 
-			newTableValues.push_back(rowCopy);
+				rows.push_back(move(rowCopy));
+			}
 		}
+	});
 
-	}
-
-	currentResults->setTable(currentResultsSynonymIndex, newTableValues);
+	currentResults->setTable(move(currentResultsSynonymIndex), move(newTableValues));
 
 	return currentResults;
 }
 
 shared_ptr<ResultsTable> ResultUtil::getNaturalJoinOfTables(shared_ptr<ResultsTable> groupResult, shared_ptr<ResultsTable> currentResults,
-	unordered_set<string> commonSynonyms) {
+	const unordered_set<string>& commonSynonyms) {
 	unordered_set<string> groupResultSynonyms = groupResult->getSynonyms();
 	unordered_set<string> currentResultsSynonyms = currentResults->getSynonyms();
 	unordered_map<string, int> currentResultsSynonymIndex = currentResults->getSynonymIndexMap();
 
 	unordered_set<string> uncommonSynonyms = {};
-	for (unordered_set<string>::iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
+	for (unordered_set<string>::const_iterator it = groupResultSynonyms.begin(); it != groupResultSynonyms.end(); it++) {
 		string groupResultSynonym = *it;
 
 		// synonym is not in current results table, aka uncommon synonym
@@ -351,50 +355,109 @@ shared_ptr<ResultsTable> ResultUtil::getNaturalJoinOfTables(shared_ptr<ResultsTa
 		}
 	}
 
-	unordered_map<string, int> groupResultSynonymIndex = groupResult->getSynonymIndexMap();
-	vector<vector<string>> currentResultsTableValues = currentResults->getTableValues();
-	vector<vector<string>> groupResultTableValues = groupResult->getTableValues();
-	vector<vector<string>> newTableValues;
-	for (vector<vector<string>>::iterator currentResultIt = currentResultsTableValues.begin();
-		currentResultIt != currentResultsTableValues.end(); currentResultIt++) {
-		vector<string> currentResultRow = (*currentResultIt);
-
-		for (vector<vector<string>>::iterator groupResultIt = groupResultTableValues.begin(); groupResultIt != groupResultTableValues.end(); groupResultIt++) {
-			vector<string>groupResultRow = (*groupResultIt);
-
-			// checking if the values of common synonyms match
-			bool allCommonSynonymsMatch = true;
-			for (unordered_set<string>::iterator it = commonSynonyms.begin(); it != commonSynonyms.end(); it++) {
-				string commonSynonym = *it;
-				int groupResultIndex = groupResultSynonymIndex.find(commonSynonym)->second;
-				int currentResultIndex = currentResultsSynonymIndex.find(commonSynonym)->second;
-				string groupResultValue = groupResultRow.at(groupResultIndex);
-				string currentResultValue = currentResultRow.at(currentResultIndex);
-				if (groupResultValue != currentResultValue) { 
-					allCommonSynonymsMatch = false;
-					break;
+	const unordered_map<string, int>& groupResultSynonymIndex = groupResult->getSynonymIndexMap();
+	const vector<vector<string>>& currentResultsTableValues = currentResults->getTableValues();
+	const vector<vector<string>>& groupResultTableValues = groupResult->getTableValues();
+	vector<vector<string>> newTableValues = MorselExecutor::run(currentResultsTableValues.size(), groupResultTableValues.size(),
+		[&](size_t begin, size_t end, vector<vector<string>>& rows) {
+		for (size_t i = begin; i < end; i++) {
+			const vector<string>& currentResultRow = currentResultsTableValues.at(i);
+
+			for (vector<vector<string>>::const_iterator groupResultIt = groupResultTableValues.begin(); groupResultIt != groupResultTableValues.end(); groupResultIt++) {
+				const vector<string>& groupResultRow = (*groupResultIt);
+
+				// checking if the values of common synonyms match
+				bool allCommonSynonymsMatch = true;
+				for (unordered_set<string>::const_iterator it = commonSynonyms.begin(); it != commonSynonyms.end(); it++) {
+					int groupResultIndex = groupResultSynonymIndex.find(*it)->second;
+					int currentResultIndex = currentResultsSynonymIndex.find(*it)->second;
+					if (groupResultRow.at(groupResultIndex) != currentResultRow.at(currentResultIndex)) {
+						allCommonSynonymsMatch = false;
+						break;
+					}
 				}
-			}
 
-			if (!allCommonSynonymsMatch) { // if one of the common synonyms do not match, skip this row
-				continue;
-			}
+				if (!allCommonSynonymsMatch) { // if one of the common synonyms do not match, skip this row
+					continue;
+				}
 
-			vector<string> rowCopy(currentResultRow);
-			// since all common synonyms match, add uncommon synonyms to new row
-			for (unordered_set<string>::iterator it = uncommonSynonyms.begin(); it != uncommonSynonyms.end(); it++) {
-				string uncommonSynonym = *it;
-				int groupResultIndex = groupResultSynonymIndex.find(uncommonSynonym)->second;
-				string value = groupResultRow.at(groupResultIndex);
-				rowCopy.push_back(value);
+				vector<string> rowCopy = copyRow(currentResultRow, uncommonSynonyms.size());
+				// since all common synonyms match, add uncommon synonyms to new row
+				for (unordered_set<string>::const_iterator it = uncommonSynonyms.begin(); it != uncommonSynonyms.end(); it++) {
+					int groupResultIndex = groupResultSynonymIndex.find(*it)->second;
+					rowCopy.push_back(groupResultRow.at(groupResultIndex));
+				}
+
+				rows.push_back(move(rowCopy));
 			}
+		}
+	});
+
+	currentResults->setTable(move(currentResultsSynonymIndex), move(newTableValues));
+
+	return currentResults;
+}
 
-			newTableValues.push_back(rowCopy);
+// pairs of a map in iteration order, so that they can be split into morsels
+vector<pair<const string*, const string*>> ResultUtil::getPairs(const unordered_map<string, unordered_set<string>>& PKBResults) {
+	vector<pair<const string*, const string*>> pairs;
+	for (auto& entry : PKBResults) {
+		for (const string& value : entry.second) {
+			pairs.push_back({ &entry.first, &value });
 		}
+	}
+	return pairs;
+}
+
+// copy of a row with room for the columns a join appends, so that appending them does not reallocate
+vector<string> ResultUtil::copyRow(const vector<string>& row, size_t extraColumnCount) {
+	vector<string> rowCopy;
+	rowCopy.reserve(row.size() + extraColumnCount);
+	rowCopy.insert(rowCopy.end(), row.begin(), row.end());
+	return rowCopy;
+}
+
+vector<const string*> ResultUtil::getValues(const unordered_set<string>& PKBResults) {
+	vector<const string*> values;
+	for (const string& value : PKBResults) {
+		values.push_back(&value);
+	}
+	return values;
+}
 
+shared_ptr<ResultsTable> ResultUtil::getProjectedTable(shared_ptr<ResultsTable> results, const vector<string>& synonyms) {
+	const unordered_map<string, int>& synonymIndex = results->getSynonymIndexMap();
+	unordered_map<string, int> projectedSynonymIndex;
+	vector<int> projectedColumns;
+	for (vector<string>::const_iterator it = synonyms.begin(); it != synonyms.end(); it++) {
+		const string& synonym = *it;
+		unordered_map<string, int>::const_iterator indexIt = synonymIndex.find(synonym);
+		if (indexIt == synonymIndex.end() || projectedSynonymIndex.find(synonym) != projectedSynonymIndex.end()) {
+			continue;
+		}
+		projectedSynonymIndex.insert({ synonym, projectedColumns.size() });
+		projectedColumns.push_back(indexIt->second);
 	}
 
-	currentResults->setTable(currentResultsSynonymIndex, newTableValues);
+	shared_ptr<ResultsTable> projectedResults = MonotonicArena::makeShared<ResultsTable>();
+	if (results->isNoResult()) {
+		projectedResults->setIsNoResult();
+	}
+	if (projectedColumns.size() == synonymIndex.size()) { // nothing to drop, rows are already distinct
+		projectedResults->setTable(move(projectedSynonymIndex), results->getTableValues());
+		return projectedResults;
+	}
 
-	return currentResults;
-}
\ No newline at end of file
+	const vector<vector<string>>& tableValues = results->getTableValues();
+	set<vector<string>> distinctRows;
+	for (vector<vector<string>>::const_iterator it = tableValues.begin(); it != tableValues.end(); it++) {
+		vector<string> row;
+		row.reserve(projectedColumns.size());
+		for (int column : projectedColumns) {
+			row.push_back(it->at(column));
+		}
+		distinctRows.insert(move(row));
+	}
+	projectedResults->setTable(move(projectedSynonymIndex), vector<vector<string>>(distinctRows.begin(), distinctRows.end()));
+	return projectedResults;
+}
@@ -12,31 +12,40 @@ using namespace std;
 class ResultUtil {
 public:
 	
-	static unordered_set<string> getCommonSynonyms(vector<string> PKBResultSynonyms, unordered_set<string> currentResultSynonyms);
+	static unordered_set<string> getCommonSynonyms(const vector<string>& PKBResultSynonyms, const unordered_set<string>& currentResultSynonyms);
 
-	static unordered_set<string> getCommonSynonyms(unordered_set<string> groupResultSynonyms, unordered_set<string> currentResultSynonyms);
+	static unordered_set<string> getCommonSynonyms(const unordered_set<string>& groupResultSynonyms, const unordered_set<string>& currentResultSynonyms);
 
-	static shared_ptr<ResultsTable> getCartesianProductFromMap(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+	static shared_ptr<ResultsTable> getCartesianProductFromMap(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 		shared_ptr<ResultsTable> currentResults);
 
-	static shared_ptr<ResultsTable> getNaturalJoinFromMap(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
-		shared_ptr<ResultsTable> currentResults, unordered_set<string> commonSynonyms);
+	static shared_ptr<ResultsTable> getNaturalJoinFromMap(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
+		shared_ptr<ResultsTable> currentResults, const unordered_set<string>& commonSynonyms);
 
-	static shared_ptr<ResultsTable> getCartesianProductFromSet(unordered_set<string> PKBResults, vector<string> synonyms,
+	static shared_ptr<ResultsTable> getCartesianProductFromSet(const unordered_set<string>& PKBResults, const vector<string>& synonyms,
 		shared_ptr<ResultsTable> currentResults);
 
-	static shared_ptr<ResultsTable> getNaturalJoinFromSet(unordered_set<string> PKBResults, vector<string> synonyms,
-		shared_ptr<ResultsTable> currentResults, unordered_set<string> commonSynonyms);
+	static shared_ptr<ResultsTable> getNaturalJoinFromSet(const unordered_set<string>& PKBResults, const vector<string>& synonyms,
+		shared_ptr<ResultsTable> currentResults, const unordered_set<string>& commonSynonyms);
 
 	static shared_ptr<ResultsTable> getCartesianProductOfTables(shared_ptr<ResultsTable> groupResult, shared_ptr<ResultsTable> currentResults);
 
 	static shared_ptr<ResultsTable> getNaturalJoinOfTables(shared_ptr<ResultsTable> groupResult, shared_ptr<ResultsTable> currentResults, 
-		unordered_set<string> commonSynonyms);
+		const unordered_set<string>& commonSynonyms);
+
+	// keeps only the given synonyms that are in the table, without duplicate rows
+	static shared_ptr<ResultsTable> getProjectedTable(shared_ptr<ResultsTable> results, const vector<string>& synonyms);
 
 private:
-	static shared_ptr<ResultsTable> getNaturalJoinTwoSynonymsCommon(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+	static shared_ptr<ResultsTable> getNaturalJoinTwoSynonymsCommon(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 		shared_ptr<ResultsTable> currentResults);
 
-	static shared_ptr<ResultsTable> getNaturalJoinOneSynonymCommon(unordered_map <string, unordered_set<string>> PKBResults, vector<string> synonyms,
+	static shared_ptr<ResultsTable> getNaturalJoinOneSynonymCommon(const unordered_map<string, unordered_set<string>>& PKBResults, const vector<string>& synonyms,
 		bool isLeftSynonymCommon, shared_ptr<ResultsTable> currentResults);
+
+	static vector<pair<const string*, const string*>> getPairs(const unordered_map<string, unordered_set<string>>& PKBResults);
+
+	static vector<string> copyRow(const vector<string>& row, size_t extraColumnCount);
+
+	static vector<const string*> getValues(const unordered_set<string>& PKBResults);
 };
\ No newline at end of file
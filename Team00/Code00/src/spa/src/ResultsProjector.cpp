@@ -1,4 +1,8 @@
 #include "ResultsProjector.h"
+#include "MonotonicArena.h"
+#include "Tracer.h"
+#include "CancellationToken.h"
+#include "MemoryBudget.h"
 
 string ResultsProjector::TRUE = "TRUE";
 string ResultsProjector::FALSE = "FALSE";
@@ -34,12 +38,110 @@ void ResultsProjector::projectResults(shared_ptr<ResultsTable> evaluatedResults,
 	}
 }
 
-unordered_set<string> ResultsProjector::getAttributeValuesFromStmtNum(unordered_set<string> stmtNum, shared_ptr<PKBInterface> PKB) {
+void ResultsProjector::projectResults(const vector<shared_ptr<ResultsTable>>& groupResults, shared_ptr<SelectClause> selectClause,
+	shared_ptr<PKBInterface> PKB, list<string>& results) {
+	SPA_TRACE_SCOPE("projectResults");
+	vector<shared_ptr<Declaration>> declarations = selectClause->getDeclarations();
+	bool isNoResult = false;
+	for (vector<shared_ptr<ResultsTable>>::const_iterator it = groupResults.begin(); it != groupResults.end(); it++) {
+		isNoResult = isNoResult || (*it)->isNoResult();
+	}
+
+	// Select BOOLEAN
+	if (declarations.size() == 0) {
+		results.push_back(isNoResult ? FALSE : TRUE);
+		return;
+	}
+
+	if (isNoResult) {
+		return;
+	}
+
+	// locate the group and column of each selected synonym, synonyms not in any group take all their entities
+	vector<shared_ptr<ResultsTable>> tables = groupResults;
+	unordered_map<string, pair<int, int>> synonymPositions;
+	for (size_t i = 0; i < tables.size(); i++) {
+		const unordered_map<string, int>& synonymIndexMap = tables.at(i)->getSynonymIndexMap();
+		for (unordered_map<string, int>::const_iterator it = synonymIndexMap.begin(); it != synonymIndexMap.end(); it++) {
+			synonymPositions.insert({ it->first, { i, it->second } });
+		}
+	}
+	for (vector<shared_ptr<Declaration>>::iterator it = declarations.begin(); it != declarations.end(); it++) {
+		string synonym = (*it)->getValue();
+		if (synonymPositions.find(synonym) != synonymPositions.end()) {
+			continue;
+		}
+		unordered_set<string> PKBResults = PKB->getEntities((*it)->getEntityType());
+		if (PKBResults.size() == 0) {
+			return;
+		}
+		shared_ptr<ResultsTable> entityTable = MonotonicArena::makeShared<ResultsTable>();
+		entityTable->populateWithSet(PKBResults, { synonym });
+		synonymPositions.insert({ synonym, { tables.size(), 0 } });
+		tables.push_back(entityTable);
+	}
+
+	// the rows stay in their tables, which are kept alive by tables
+	vector<const vector<vector<string>>*> tableValues;
+	for (vector<shared_ptr<ResultsTable>>::iterator it = tables.begin(); it != tables.end(); it++) {
+		if ((*it)->isTableEmpty()) {
+			return;
+		}
+		tableValues.push_back(&(*it)->getTableValues());
+	}
+
+	// walk the cartesian product of the tables one combination of rows at a time
+	unordered_set<string> setResults;
+	MemoryBudget::Reservation reservation; // the distinct results, which may be many more than the rows of any table
+	unordered_map<string, string> attributeValues; // stmt# -> procName/varName already retrieved from PKB
+	vector<size_t> rowIndices(tableValues.size(), 0);
+	while (true) {
+		CancellationToken::checkCurrent();
+		string resultString;
+		for (size_t i = 0; i < declarations.size(); i++) {
+			shared_ptr<Declaration> declaration = declarations.at(i);
+			pair<int, int> position = synonymPositions.find(declaration->getValue())->second;
+			string synonymValue = tableValues.at(position.first)->at(rowIndices.at(position.first)).at(position.second);
+
+			// If declaration is an attribute, need to retrieve attribute value procName/varName from PKB
+			if (declaration->getIsAttribute()) {
+				unordered_map<string, string>::iterator attributeIt = attributeValues.find(synonymValue);
+				if (attributeIt == attributeValues.end()) {
+					attributeIt = attributeValues.insert({ synonymValue, PKB->getNameFromStmtNum(synonymValue) }).first;
+				}
+				synonymValue = attributeIt->second;
+			}
+
+			resultString += synonymValue;
+
+			if (i != declarations.size() - 1) {
+				resultString += SPACE;
+			}
+		}
+		if (setResults.insert(resultString).second) {
+			reservation.add(MemoryBudget::estimateStringBytes(resultString.size()));
+		}
+
+		int table = tableValues.size() - 1;
+		while (table >= 0 && ++rowIndices.at(table) == tableValues.at(table)->size()) {
+			rowIndices.at(table) = 0;
+			table--;
+		}
+		if (table < 0) {
+			break;
+		}
+	}
+
+	for (const string& setResult : setResults) {
+		results.push_back(setResult);
+	}
+}
+
+unordered_set<string> ResultsProjector::getAttributeValuesFromStmtNum(const unordered_set<string>& stmtNum, shared_ptr<PKBInterface> PKB) {
 	unordered_set<string> values;
 
-	for (unordered_set<string>::iterator it = stmtNum.begin(); it != stmtNum.end(); it++) {
-		string stmtNum = *it;
-		values.insert(PKB->getNameFromStmtNum(stmtNum));
+	for (unordered_set<string>::const_iterator it = stmtNum.begin(); it != stmtNum.end(); it++) {
+		values.insert(PKB->getNameFromStmtNum(*it));
 	}
 
 	return values;
@@ -55,14 +157,13 @@ void ResultsProjector::projectSingleSynonym(shared_ptr<ResultsTable> evaluatedRe
 
 	// if selected synonym is in resultsTable
 	if (synonyms.find(synonym) != synonyms.end()) {
-		vector<vector<string>> resultValues = evaluatedResults->getTableValues();
-		unordered_map<string, int> synonymIndexMap = evaluatedResults->getSynonymIndexMap();
+		const vector<vector<string>>& resultValues = evaluatedResults->getTableValues();
+		const unordered_map<string, int>& synonymIndexMap = evaluatedResults->getSynonymIndexMap();
 		int synonymIndex = synonymIndexMap.find(synonym)->second;
 
 		// Extract synonym values from table
-		for (vector<vector<string>>::iterator it = resultValues.begin(); it != resultValues.end(); it++) {
-			string resultValue = it->at(synonymIndex);
-			setResults.insert(resultValue);
+		for (vector<vector<string>>::const_iterator it = resultValues.begin(); it != resultValues.end(); it++) {
+			setResults.insert(it->at(synonymIndex));
 		}
 
 		// If it is an attribute, need to get the procName/varName from its stmtnums
@@ -92,7 +193,7 @@ void ResultsProjector::projectSingleSynonym(shared_ptr<ResultsTable> evaluatedRe
 
 // ================ Project tuple functions ==========================================================================================================
 
-void ResultsProjector::projectTuple(shared_ptr<ResultsTable> evaluatedResults, vector<shared_ptr<Declaration>> declarations,
+void ResultsProjector::projectTuple(shared_ptr<ResultsTable> evaluatedResults, const vector<shared_ptr<Declaration>>& declarations,
 	shared_ptr<PKBInterface> PKB, list<string>& results) {
 	unordered_set<string> resultsSynonyms = evaluatedResults->getSynonyms();
 	vector<shared_ptr<Declaration>> selectedSynonymsInResult = getSelectedSynonymsInResults(declarations, resultsSynonyms);
@@ -106,7 +207,7 @@ void ResultsProjector::projectTuple(shared_ptr<ResultsTable> evaluatedResults, v
 
 	// All tuple synonyms are not in resultsTable 
 	if (selectedSynonymsInResult.size() == 0) {
-		shared_ptr<ResultsTable> emptyResultsTable = make_shared<ResultsTable>();
+		shared_ptr<ResultsTable> emptyResultsTable = MonotonicArena::makeShared<ResultsTable>();
 		shared_ptr<ResultsTable> resultsTable = getResultsTableOfTuple(declarations, emptyResultsTable, PKB);
 
 		if (resultsTable->isNoResult()) {
@@ -130,9 +231,9 @@ void ResultsProjector::projectTuple(shared_ptr<ResultsTable> evaluatedResults, v
 	}
 }
 
-vector<shared_ptr<Declaration>> ResultsProjector::getSelectedSynonymsInResults(vector<shared_ptr<Declaration>> selectedDeclarations, unordered_set<string> resultSynonyms) {
+vector<shared_ptr<Declaration>> ResultsProjector::getSelectedSynonymsInResults(const vector<shared_ptr<Declaration>>& selectedDeclarations, const unordered_set<string>& resultSynonyms) {
 	vector<shared_ptr<Declaration>> declarations;
-	for (vector<shared_ptr<Declaration>>::iterator it = selectedDeclarations.begin(); it != selectedDeclarations.end(); it++) {
+	for (vector<shared_ptr<Declaration>>::const_iterator it = selectedDeclarations.begin(); it != selectedDeclarations.end(); it++) {
 		shared_ptr<Declaration> declaration = *it;
 		string selectedSynonym = declaration->getValue();
 		if (resultSynonyms.find(selectedSynonym) != resultSynonyms.end()) {
@@ -142,9 +243,9 @@ vector<shared_ptr<Declaration>> ResultsProjector::getSelectedSynonymsInResults(v
 	return declarations;
 }
 
-vector<shared_ptr<Declaration>> ResultsProjector::getSelectedSynonymsNotInResults(vector<shared_ptr<Declaration>> selectedDeclarations, unordered_set<string> resultSynonyms) {
+vector<shared_ptr<Declaration>> ResultsProjector::getSelectedSynonymsNotInResults(const vector<shared_ptr<Declaration>>& selectedDeclarations, const unordered_set<string>& resultSynonyms) {
 	vector<shared_ptr<Declaration>> declarations;
-	for (vector<shared_ptr<Declaration>>::iterator it = selectedDeclarations.begin(); it != selectedDeclarations.end(); it++) {
+	for (vector<shared_ptr<Declaration>>::const_iterator it = selectedDeclarations.begin(); it != selectedDeclarations.end(); it++) {
 		shared_ptr<Declaration> declaration = *it;
 		string selectedSynonym = declaration->getValue();
 		if (resultSynonyms.find(selectedSynonym) == resultSynonyms.end()) {
@@ -155,14 +256,15 @@ vector<shared_ptr<Declaration>> ResultsProjector::getSelectedSynonymsNotInResult
 }
 
 // builds the final result list using the final evaluated results WIP
-void ResultsProjector::projectTupleFromResults(vector<shared_ptr<Declaration>> declarations, shared_ptr<ResultsTable> evaluatedResults,
+void ResultsProjector::projectTupleFromResults(const vector<shared_ptr<Declaration>>& declarations, shared_ptr<ResultsTable> evaluatedResults,
 	shared_ptr<PKBInterface> PKB, list<string>& results) {
-	vector<vector<string>> resultValues = evaluatedResults->getTableValues();
-	unordered_map<string, int> synonymIndexMap = evaluatedResults->getSynonymIndexMap();
+	const vector<vector<string>>& resultValues = evaluatedResults->getTableValues();
+	const unordered_map<string, int>& synonymIndexMap = evaluatedResults->getSynonymIndexMap();
 	unordered_set<string> setResults;
 
-	for (vector<vector<string>>::iterator it = resultValues.begin(); it != resultValues.end(); it++) {
-		vector<string> row = *it;
+	for (vector<vector<string>>::const_iterator it = resultValues.begin(); it != resultValues.end(); it++) {
+		CancellationToken::checkCurrent();
+		const vector<string>& row = *it;
 		string resultString;
 
 		for (size_t i = 0; i < declarations.size(); i++) {
@@ -186,17 +288,17 @@ void ResultsProjector::projectTupleFromResults(vector<shared_ptr<Declaration>> d
 		setResults.insert(resultString);
 	}
 
-	for (auto setResult : setResults) {
+	for (const string& setResult : setResults) {
 		results.push_back(setResult);
 	}
 }
 
-shared_ptr<ResultsTable> ResultsProjector::getResultsTableOfTuple(vector<shared_ptr<Declaration>> newDeclarations, shared_ptr<ResultsTable> initialResults,
+shared_ptr<ResultsTable> ResultsProjector::getResultsTableOfTuple(const vector<shared_ptr<Declaration>>& newDeclarations, shared_ptr<ResultsTable> initialResults,
 	shared_ptr<PKBInterface> PKB) {
 	shared_ptr<ResultsTable> currentResults = initialResults;
 	unordered_set<string> evaluatedSynonyms;
 
-	for (vector<shared_ptr<Declaration>>::iterator it = newDeclarations.begin(); it != newDeclarations.end(); it++) {
+	for (vector<shared_ptr<Declaration>>::const_iterator it = newDeclarations.begin(); it != newDeclarations.end(); it++) {
 		shared_ptr<Declaration> declaration = *it;
 		string synonym = declaration->getValue();
 		EntityType declarationEntityType = declaration->getEntityType();
@@ -14,27 +14,31 @@ private:
 	static string FALSE;
 	static string SPACE;
 
-	static unordered_set<string> getAttributeValuesFromStmtNum(unordered_set<string> stmtNum, shared_ptr<PKBInterface> PKB);
+	static unordered_set<string> getAttributeValuesFromStmtNum(const unordered_set<string>& stmtNum, shared_ptr<PKBInterface> PKB);
 
 	static void projectSingleSynonym(shared_ptr<ResultsTable> evaluatedResults, shared_ptr<Declaration> declaration,
 		shared_ptr<PKBInterface> PKB, list<string>& results);
 
-	static void projectTuple(shared_ptr<ResultsTable> evaluatedResults, vector<shared_ptr<Declaration>> declarations,
+	static void projectTuple(shared_ptr<ResultsTable> evaluatedResults, const vector<shared_ptr<Declaration>>& declarations,
 		shared_ptr<PKBInterface> PKB, list<string>& results);
 
-	static void projectTupleFromResults(vector<shared_ptr<Declaration>> declarations, shared_ptr<ResultsTable> evaluatedResults,
+	static void projectTupleFromResults(const vector<shared_ptr<Declaration>>& declarations, shared_ptr<ResultsTable> evaluatedResults,
 		shared_ptr<PKBInterface> PKB, list<string>& results);
 
-	static shared_ptr<ResultsTable> getResultsTableOfTuple(vector<shared_ptr<Declaration>> newDeclarations, shared_ptr<ResultsTable> initialResults,
+	static shared_ptr<ResultsTable> getResultsTableOfTuple(const vector<shared_ptr<Declaration>>& newDeclarations, shared_ptr<ResultsTable> initialResults,
 		shared_ptr<PKBInterface> PKB);
 
-	static vector<shared_ptr<Declaration>> getSelectedSynonymsInResults(vector<shared_ptr<Declaration>> selectedDeclarations,
-		unordered_set<string> resultSynonyms);
+	static vector<shared_ptr<Declaration>> getSelectedSynonymsInResults(const vector<shared_ptr<Declaration>>& selectedDeclarations,
+		const unordered_set<string>& resultSynonyms);
 
-	static vector<shared_ptr<Declaration>> getSelectedSynonymsNotInResults(vector<shared_ptr<Declaration>> selectedDeclarations,
-		unordered_set<string> resultSynonyms);
+	static vector<shared_ptr<Declaration>> getSelectedSynonymsNotInResults(const vector<shared_ptr<Declaration>>& selectedDeclarations,
+		const unordered_set<string>& resultSynonyms);
 
 public:
 	static void projectResults(shared_ptr<ResultsTable> evaluatedResults, shared_ptr<SelectClause> selectClause, shared_ptr<PKBInterface> PKB,
 		list<string>& results);
+
+	// combines independent group results by streaming their cartesian product instead of materialising it
+	static void projectResults(const vector<shared_ptr<ResultsTable>>& groupResults, shared_ptr<SelectClause> selectClause, shared_ptr<PKBInterface> PKB,
+		list<string>& results);
 };
\ No newline at end of file
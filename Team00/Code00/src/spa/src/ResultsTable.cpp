@@ -5,17 +5,17 @@ ResultsTable::ResultsTable() {
 	this->aValues = vector<vector<string>>();
 }
 
-unordered_map<string, int> ResultsTable::getSynonymIndexMap() {
+const unordered_map<string, int>& ResultsTable::getSynonymIndexMap() {
 	return this->aSynonymIndex;
 }
 
-vector<vector<string>> ResultsTable::getTableValues() {
+const vector<vector<string>>& ResultsTable::getTableValues() {
 	return this->aValues;
 }
 
 unordered_set<string> ResultsTable::getSynonyms() {
 	unordered_set<string> synonyms;
-	for (unordered_map<string, int>::iterator it = this->aSynonymIndex.begin(); it != this->aSynonymIndex.end(); it++) {
+	for (unordered_map<string, int>::const_iterator it = this->aSynonymIndex.begin(); it != this->aSynonymIndex.end(); it++) {
 		synonyms.insert(it->first);
 	}
 	return synonyms;
@@ -30,8 +30,13 @@ void ResultsTable::setIsNoResult() {
 }
 
 void ResultsTable::setTable(unordered_map<string, int> synonymIndex, vector<vector<string>> values) {
-	this->aSynonymIndex = synonymIndex;
-	this->aValues = values;
+	this->aSynonymIndex = move(synonymIndex);
+	this->aValues = move(values);
+	reserveRows();
+}
+
+void ResultsTable::reserveRows() {
+	this->aReservation.resize(MemoryBudget::estimateRowBytes(this->aValues.size(), this->aSynonymIndex.size()));
 }
 
 bool ResultsTable::isTableEmpty() {
@@ -42,35 +47,31 @@ int ResultsTable::getTableSize() {
 	return this->aValues.size();
 }
 
-void ResultsTable::populateWithMap(unordered_map<string, unordered_set<string>> PKBResult, vector<string> synonyms) {
-	string leftSynonym = synonyms.at(0);
-	string rightSynonym = synonyms.at(1);
+void ResultsTable::populateWithMap(const unordered_map<string, unordered_set<string>>& PKBResult, const vector<string>& synonyms) {
+	const string& leftSynonym = synonyms.at(0);
+	const string& rightSynonym = synonyms.at(1);
 	this->aSynonymIndex.clear();
 	this->aSynonymIndex.insert({ leftSynonym, 0 });
 	this->aSynonymIndex.insert({ rightSynonym, 1 });
-	for (unordered_map<string, unordered_set<string>>::iterator it = PKBResult.begin(); it != PKBResult.end(); it++) {
-		string leftSynonymValue = it->first;
-		unordered_set<string> values = it->second;
+	for (unordered_map<string, unordered_set<string>>::const_iterator it = PKBResult.begin(); it != PKBResult.end(); it++) {
+		const string& leftSynonymValue = it->first;
+		const unordered_set<string>& values = it->second;
 
-		for (unordered_set<string>::iterator setIt = values.begin(); setIt != values.end(); setIt++) {
-			string rightSynonymValue = *setIt;
-			vector<string> row = { leftSynonymValue, rightSynonymValue };
-			this->aValues.push_back(row);
+		for (unordered_set<string>::const_iterator setIt = values.begin(); setIt != values.end(); setIt++) {
+			this->aValues.push_back({ leftSynonymValue, *setIt });
 		}
 	}
+	reserveRows();
 }
 
-void ResultsTable::populateWithSet(unordered_set<string> PKBResult, vector<string> synonyms) {
+void ResultsTable::populateWithSet(const unordered_set<string>& PKBResult, const vector<string>& synonyms) {
 	this->aSynonymIndex.clear();
 	for (size_t i = 0; i < synonyms.size(); i++) {
 		this->aSynonymIndex.insert({ synonyms.at(i), i });
 	}
-	for (unordered_set<string>::iterator it = PKBResult.begin(); it != PKBResult.end(); it++) {
-		string value = *it;
-		vector<string> row = {};
-		for (size_t i = 0; i < synonyms.size(); i++) {
-			row.push_back(value);
-		}
-		this->aValues.push_back(row);
+	this->aValues.reserve(this->aValues.size() + PKBResult.size());
+	for (unordered_set<string>::const_iterator it = PKBResult.begin(); it != PKBResult.end(); it++) {
+		this->aValues.emplace_back(synonyms.size(), *it);
 	}
+	reserveRows();
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <vector>
 #include <unordered_set>
 #include <unordered_set>
+#include "MemoryBudget.h"
 
 using namespace std;
 
@@ -12,18 +13,23 @@ private:
 	unordered_map<string, int> aSynonymIndex;
 	vector<vector<string>> aValues;
 	bool noResult = false;
+	MemoryBudget::Reservation aReservation; // the rows, charged to the budget of the query that made the table
+
+	// @throws MemoryBudgetExceededException if the rows take more than the budget allows
+	void reserveRows();
 
 public:
 	ResultsTable();
-	unordered_map<string, int> getSynonymIndexMap();
-	vector<vector<string>> getTableValues();
+	const unordered_map<string, int>& getSynonymIndexMap();
+	const vector<vector<string>>& getTableValues();
 	unordered_set<string> getSynonyms();
+	// takes the rows by value so that joins can move the rows they built into the table
 	void setTable(unordered_map<string, int> synonymIndex, vector<vector<string>> values);
 	bool isNoResult();
 	void setIsNoResult();
 
 	bool isTableEmpty();
 	int getTableSize();
-	void populateWithMap(unordered_map<string, unordered_set<string>> PKBResult, vector<string> synonyms);
-	void populateWithSet(unordered_set<string> PKBResult, vector<string> synonyms);
+	void populateWithMap(const unordered_map<string, unordered_set<string>>& PKBResult, const vector<string>& synonyms);
+	void populateWithSet(const unordered_set<string>& PKBResult, const vector<string>& synonyms);
 };
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
+#include "SimpleProgramGenerator.h"
+
+namespace {
+	const string OPERATORS = "+-*/%";
+	const vector<string> RELATIONAL_OPERATORS = { "<", "<=", ">", ">=", "==", "!=" };
+}
+
+SimpleProgramGenerator::SimpleProgramGenerator(GeneratorOptions options) {
+	this->aOptions = options;
+	this->aOptions.procedureCount = max(1, options.procedureCount);
+	this->aOptions.variableCount = max(1, options.variableCount);
+	this->aOptions.expressionLength = max(0, options.expressionLength);
+}
+
+vector<int> SimpleProgramGenerator::getCallees(CallGraphShape shape, int procedure, int procedureCount) {
+	vector<int> callees;
+	if (shape == CallGraphShape::CHAIN) {
+		callees.push_back(procedure + 1);
+	}
+	else if (shape == CallGraphShape::FAN_OUT) {
+		for (int i = 1; i <= FAN_OUT_WIDTH; i++) {
+			callees.push_back(procedure * FAN_OUT_WIDTH + i);
+		}
+	}
+	else { // layer k holds procedures 2k - 1 and 2k, the first layer only procedure 0
+		int layer = (procedure + 1) / 2;
+		callees.push_back(2 * layer + 1);
+		callees.push_back(2 * layer + 2);
+	}
+	callees.erase(remove_if(callees.begin(), callees.end(), [&](int callee) {
+		return callee >= procedureCount;
+	}), callees.end());
+	return callees;
+}
+
+string SimpleProgramGenerator::getProcedureName(int procedure) {
+	return "proc" + to_string(procedure);
+}
+
+// mt19937 gives the same numbers everywhere, unlike the standard distributions, so they are mapped by hand
+int SimpleProgramGenerator::getRandom(int low, int high) {
+	return low + (int) (this->aGenerator() % (uint32_t) (high - low + 1));
+}
+
+bool SimpleProgramGenerator::getChance(double probability) {
+	return this->aGenerator() / 4294967296.0 < probability;
+}
+
+string SimpleProgramGenerator::getVariable() {
+	return "v" + to_string(this->getRandom(0, this->aOptions.variableCount - 1));
+}
+
+// random parts are drawn one statement at a time, so the text does not depend on the evaluation order of operands
+string SimpleProgramGenerator::getExpression(int operatorCount) {
+	auto getOperand = [&]() {
+		return this->getChance(0.7) ? this->getVariable() : to_string(this->getRandom(0, 99));
+	};
+
+	string expression = getOperand();
+	while (operatorCount > 0) {
+		string op(1, OPERATORS[this->getRandom(0, OPERATORS.size() - 1)]);
+		if (operatorCount >= 2 && this->getChance(0.2)) {
+			string left = getOperand();
+			string innerOp(1, OPERATORS[this->getRandom(0, OPERATORS.size() - 1)]);
+			string right = getOperand();
+			expression += " " + op + " (" + left + " " + innerOp + " " + right + ")";
+			operatorCount -= 2;
+		}
+		else {
+			expression += " " + op + " " + getOperand();
+			operatorCount--;
+		}
+	}
+	return expression;
+}
+
+string SimpleProgramGenerator::getCondition() {
+	auto getRelation = [&]() {
+		string left = this->getVariable();
+		string op = RELATIONAL_OPERATORS[this->getRandom(0, RELATIONAL_OPERATORS.size() - 1)];
+		string right = this->getExpression(this->getRandom(0, 1));
+		return left + " " + op + " " + right;
+	};
+
+	string condition = getRelation();
+	if (this->getChance(0.2)) {
+		string op = this->getChance(0.5) ? "&&" : "||";
+		string other = getRelation();
+		condition = "(" + condition + ") " + op + " (" + other + ")";
+	}
+	if (this->getChance(0.1)) {
+		condition = "!(" + condition + ")";
+	}
+	return condition;
+}
+
+void SimpleProgramGenerator::writeLine(int depth, const string& line) {
+	*this->aOut << string(depth, '\t') << line << '\n';
+}
+
+void SimpleProgramGenerator::writeProgram(ostream& out) {
+	this->aGenerator.seed(this->aOptions.seed);
+	this->aOut = &out;
+	this->aStatementNumber = 0;
+
+	int procedureCount = this->aOptions.procedureCount;
+	int statementCount = max(procedureCount, this->aOptions.statementCount);
+	for (int procedure = 0; procedure < procedureCount; procedure++) {
+		this->aPendingCalls = getCallees(this->aOptions.callGraphShape, procedure, procedureCount);
+		int budget = statementCount / procedureCount + (procedure < statementCount % procedureCount ? 1 : 0);
+		this->aProcedureRemaining = max(budget, (int) this->aPendingCalls.size());
+
+		this->writeLine(0, "procedure " + getProcedureName(procedure) + " {");
+		this->writeBlock(1, this->aProcedureRemaining);
+		this->writeLine(0, "}");
+	}
+	this->aOut = nullptr;
+}
+
+void SimpleProgramGenerator::writeBlock(int depth, int budget) {
+	while (budget > 0) {
+		int used = 0;
+		this->writeStatement(depth, budget, used);
+		budget -= used;
+	}
+}
+
+// writes one statement, with the statements nested in it, using at most budget statements
+void SimpleProgramGenerator::writeStatement(int depth, int budget, int& used) {
+	this->aStatementNumber++;
+	this->aProcedureRemaining--;
+	used = 1;
+
+	// calls are spread over the procedure, and forced once only as many statements are left as calls
+	int pendingCallCount = this->aPendingCalls.size();
+	if (pendingCallCount > 0 && (this->aProcedureRemaining < pendingCallCount
+		|| this->getChance((double) pendingCallCount / (this->aProcedureRemaining + 1)))) {
+		this->writeLine(depth, "call " + getProcedureName(this->aPendingCalls.back()) + ";");
+		this->aPendingCalls.pop_back();
+		return;
+	}
+
+	bool canNest = depth <= this->aOptions.maxNestingDepth && this->aProcedureRemaining >= pendingCallCount;
+	double kind = this->aGenerator() / 4294967296.0;
+	if (canNest && budget >= 2 && kind < this->aOptions.loopDensity) {
+		int bodyBudget = this->getRandom(1, min(budget - 1, MAX_BLOCK_SIZE));
+		this->writeLine(depth, "while (" + this->getCondition() + ") {");
+		this->writeBlock(depth + 1, bodyBudget);
+		this->writeLine(depth, "}");
+		used += bodyBudget;
+		return;
+	}
+	if (canNest && budget >= 3 && kind < this->aOptions.loopDensity + this->aOptions.branchDensity) {
+		int thenBudget = this->getRandom(1, min(budget - 2, MAX_BLOCK_SIZE));
+		int elseBudget = this->getRandom(1, min(budget - 1 - thenBudget, MAX_BLOCK_SIZE));
+		this->writeLine(depth, "if (" + this->getCondition() + ") then {");
+		this->writeBlock(depth + 1, thenBudget);
+		this->writeLine(depth, "} else {");
+		this->writeBlock(depth + 1, elseBudget);
+		this->writeLine(depth, "}");
+		used += thenBudget + elseBudget;
+		return;
+	}
+
+	double simpleKind = this->aGenerator() / 4294967296.0;
+	string variable = this->getVariable();
+	if (simpleKind < 0.7) {
+		string expression = this->getExpression(this->getRandom(0, this->aOptions.expressionLength));
+		this->writeLine(depth, variable + " = " + expression + ";");
+	}
+	else if (simpleKind < 0.85) {
+		this->writeLine(depth, "read " + variable + ";");
+	}
+	else {
+		this->writeLine(depth, "print " + variable + ";");
+	}
+}
+
+vector<string> SimpleProgramGenerator::generateProgram() {
+	ostringstream out;
+	this->writeProgram(out);
+	vector<string> lines;
+	istringstream in(out.str());
+	string line;
+	while (getline(in, line)) {
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+void SimpleProgramGenerator::writeQueries(ostream& out, int statementCount) {
+	mt19937 generator(this->aOptions.seed);
+	auto getStatement = [&]() {
+		return to_string(1 + generator() % (uint32_t) max(1, statementCount));
+	};
+
+	// declarations and select of each query
+	vector<pair<string, string>> queries = {
+		{ "prog_line n1, n2;", "Select <n1, n2> such that Next*(n1, n2)" },
+		{ "assign a1, a2;", "Select <a1, a2> such that Affects*(a1, a2)" },
+		{ "assign a;", "Select a such that Affects*(a, a)" },
+		{ "prog_line n1, n2;", "Select <n1, n2> such that NextBip*(n1, n2)" },
+		{ "assign a1, a2;", "Select <a1, a2> such that AffectsBip*(a1, a2)" },
+		{ "while w;", "Select w such that Next*(w, w)" },
+		{ "stmt s1, s2; assign a1, a2; variable v; while w; procedure p;",
+			"Select <s1, s2, a1, a2, v, w, p> such that Follows(s1, s2) and Parent(w, s1) and Affects(a1, a2) and Modifies(a1, v) and Uses(p, v)" },
+		{ "prog_line n1, n2; assign a; variable v; if ifs;",
+			"Select <n1, n2, a, v, ifs> such that Next*(n1, n2) and Next(n2, a) and Uses(a, v) and Next(ifs, n1)" },
+	};
+	// then queries from random statements, cycling through the relationships
+	for (int i = 0; queries.size() < (size_t) this->aOptions.queryCount; i++) {
+		string statement = getStatement();
+		switch (i % 4) {
+		case 0:
+			queries.push_back({ "prog_line n;", "Select n such that Next*(" + statement + ", n)" });
+			break;
+		case 1:
+			queries.push_back({ "assign a;", "Select a such that Affects*(" + statement + ", a)" });
+			break;
+		case 2:
+			queries.push_back({ "prog_line n;", "Select n such that NextBip*(n, " + statement + ")" });
+			break;
+		default:
+			string other = getStatement();
+			queries.push_back({ "stmt s;", "Select BOOLEAN such that AffectsBip*(" + statement + ", " + other + ")" });
+			break;
+		}
+	}
+	queries.resize(min(queries.size(), (size_t) max(0, this->aOptions.queryCount)));
+
+	for (size_t i = 0; i < queries.size(); i++) {
+		out << i + 1 << " - stress\n" << queries[i].first << "\n" << queries[i].second << "\n\n5000\n";
+	}
+}
+
+int SimpleProgramGenerator::getStatementCount() {
+	return this->aStatementNumber;
+}
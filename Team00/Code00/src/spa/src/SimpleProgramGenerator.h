@@ -0,0 +1,84 @@
+#pragma once
+
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// how the procedures call each other; callees always come after their callers, so there is no recursion
+enum class CallGraphShape {
+	CHAIN, // every procedure calls the next one
+	FAN_OUT, // a tree, every procedure calls up to FAN_OUT_WIDTH procedures
+	DIAMOND // layers of two procedures, both calling both procedures of the next layer
+};
+
+struct GeneratorOptions {
+	unsigned int seed = 1;
+	int statementCount = 1000;
+	int procedureCount = 10;
+	int maxNestingDepth = 3;
+	double loopDensity = 0.1; // chance of a statement being a while loop
+	double branchDensity = 0.1; // chance of a statement being an if
+	CallGraphShape callGraphShape = CallGraphShape::CHAIN;
+	int expressionLength = 3; // most operators on the right of an assignment
+	int variableCount = 20;
+	int queryCount = 20;
+};
+
+// Generates valid SIMPLE programs of a given size and shape, and stress queries for them.
+// The same options always give the same program and queries.
+class SimpleProgramGenerator {
+private:
+	GeneratorOptions aOptions;
+	mt19937 aGenerator;
+	ostream* aOut = nullptr;
+	int aProcedureRemaining = 0; // statements left to write in the current procedure
+	vector<int> aPendingCalls; // procedures the current procedure has yet to call
+	int aStatementNumber = 0;
+
+	int getRandom(int low, int high);
+
+	bool getChance(double probability);
+
+	string getVariable();
+
+	string getExpression(int operatorCount);
+
+	string getCondition();
+
+	void writeLine(int depth, const string& line);
+
+	void writeStatement(int depth, int budget, int& used);
+
+	void writeBlock(int depth, int budget);
+
+public:
+	static const int FAN_OUT_WIDTH = 4;
+
+	// most statements in the body of one container, so that deep nesting is spread over the program
+	static const int MAX_BLOCK_SIZE = 20;
+
+	SimpleProgramGenerator(GeneratorOptions options);
+
+	static vector<int> getCallees(CallGraphShape shape, int procedure, int procedureCount);
+
+	static string getProcedureName(int procedure);
+
+	// writes the program one statement per line; at least one statement per call, so small programs may run over
+	void writeProgram(ostream& out);
+
+	vector<string> generateProgram();
+
+	/**
+	* Writes queries on Next*, Affects*, NextBip*, AffectsBip* and long tuple selects in the autotester format.
+	* The expected answers are left empty, the queries are meant for timing.
+	*
+	* @param statementCount number of statements in the program, for the statement numbers used in the queries
+	*/
+	void writeQueries(ostream& out, int statementCount);
+
+	// statements written by the last writeProgram
+	int getStatementCount();
+};
@@ -0,0 +1,13 @@
+#include "SingleRowOperator.h"
+
+SingleRowOperator::SingleRowOperator() : BindingOperator(1) {}
+
+bool SingleRowOperator::next(vector<vector<string>>& batch) {
+	batch.clear();
+	if (this->isDone) {
+		return false;
+	}
+	this->isDone = true;
+	batch.push_back({});
+	return true;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "BindingOperator.h"
+
+// produces one row without any synonym, the input of the first clause of a pipeline
+class SingleRowOperator : public BindingOperator {
+private:
+	bool isDone = false;
+
+public:
+	SingleRowOperator();
+
+	bool next(vector<vector<string>>& batch);
+};
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <bitset>
+
+#include "StatementBitmap.h"
+
+namespace {
+	const int WORD_BITS = 64;
+}
+
+StatementBitmap::StatementBitmap(const int& size) {
+	this->aWords.assign((max(size, 0) + WORD_BITS - 1) / WORD_BITS, 0);
+}
+
+void StatementBitmap::insert(const int& index) {
+	if (index < 0) {
+		return;
+	}
+	size_t word = index / WORD_BITS;
+	if (word >= this->aWords.size()) {
+		this->aWords.resize(word + 1, 0);
+	}
+	this->aWords[word] |= (uint64_t) 1 << (index % WORD_BITS);
+}
+
+bool StatementBitmap::contains(const int& index) const {
+	if (index < 0 || (size_t) index / WORD_BITS >= this->aWords.size()) {
+		return false;
+	}
+	return (this->aWords[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+size_t StatementBitmap::count() const {
+	size_t total = 0;
+	for (uint64_t word : this->aWords) {
+		total += bitset<WORD_BITS>(word).count();
+	}
+	return total;
+}
+
+bool StatementBitmap::isEmpty() const {
+	for (uint64_t word : this->aWords) {
+		if (word != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+StatementBitmap StatementBitmap::intersect(const StatementBitmap& other) const {
+	StatementBitmap result;
+	size_t size = min(this->aWords.size(), other.aWords.size());
+	result.aWords.resize(size);
+	for (size_t i = 0; i < size; i++) {
+		result.aWords[i] = this->aWords[i] & other.aWords[i];
+	}
+	return result;
+}
+
+unordered_set<string> StatementBitmap::toStrings() const {
+	unordered_set<string> values;
+	values.reserve(count());
+	for (size_t i = 0; i < this->aWords.size(); i++) {
+		for (uint64_t word = this->aWords[i]; word != 0; word &= word - 1) {
+			int bit = 0;
+			while (((word >> bit) & 1) == 0) {
+				bit++;
+			}
+			values.insert(to_string(i * WORD_BITS + bit));
+		}
+	}
+	return values;
+}
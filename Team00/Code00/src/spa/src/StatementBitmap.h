@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+// Set of statement numbers with one bit per statement, so membership is a bit test
+// and the intersection of two sets is an AND of their words.
+class StatementBitmap {
+private:
+	vector<uint64_t> aWords;
+
+public:
+	// holds the statement numbers from 0 to size - 1 without growing
+	StatementBitmap(const int& size = 0);
+
+	// grows to hold the statement number if needed
+	void insert(const int& index);
+
+	bool contains(const int& index) const;
+
+	size_t count() const;
+
+	bool isEmpty() const;
+
+	StatementBitmap intersect(const StatementBitmap& other) const;
+
+	// the statement numbers as the strings the PKB answers with
+	unordered_set<string> toStrings() const;
+};
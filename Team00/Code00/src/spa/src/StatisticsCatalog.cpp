@@ -0,0 +1,138 @@
+#include <algorithm>
+
+#include "StatisticsCatalog.h"
+#include "Declaration.h"
+
+using namespace std;
+
+double RelationStatistics::getAverageOutDegree() const {
+	return this->distinctLeftCount == 0 ? 0 : (double) this->pairCount / this->distinctLeftCount;
+}
+
+double RelationStatistics::getAverageInDegree() const {
+	return this->distinctRightCount == 0 ? 0 : (double) this->pairCount / this->distinctRightCount;
+}
+
+StatisticsCatalog::StatisticsCatalog() {}
+
+RelationStatistics StatisticsCatalog::computeStatistics(
+	const unordered_map<string, unordered_set<string>>& relation,
+	const unordered_map<string, unordered_set<string>>& relationBy) {
+	RelationStatistics statistics;
+	for (auto& entry : relation) {
+		int degree = entry.second.size();
+		if (degree == 0) {
+			continue;
+		}
+		statistics.pairCount += degree;
+		statistics.distinctLeftCount++;
+		statistics.outDegreeHistogram[degree]++;
+	}
+	for (auto& entry : relationBy) {
+		int degree = entry.second.size();
+		if (degree == 0) {
+			continue;
+		}
+		statistics.distinctRightCount++;
+		statistics.inDegreeHistogram[degree]++;
+	}
+	return statistics;
+}
+
+void StatisticsCatalog::setEntityCount(const EntityType& type, const int& count) {
+	this->entityCounts[type] = count;
+}
+
+void StatisticsCatalog::setRelationStatistics(const RelationshipType& type, const RelationStatistics& statistics) {
+	this->relationStatistics[type] = statistics;
+}
+
+void StatisticsCatalog::setProcRelationStatistics(const RelationshipType& type, const RelationStatistics& statistics) {
+	if (type == RelationshipType::USES) {
+		this->procUsesStatistics = statistics;
+	}
+	else if (type == RelationshipType::MODIFIES) {
+		this->procModifiesStatistics = statistics;
+	}
+}
+
+int StatisticsCatalog::getEntityCount(const EntityType& type) const {
+	auto it = this->entityCounts.find(type);
+	return it == this->entityCounts.end() ? 0 : it->second;
+}
+
+const RelationStatistics& StatisticsCatalog::getRelationStatistics(const RelationshipType& type) const {
+	return this->relationStatistics[type];
+}
+
+const RelationStatistics& StatisticsCatalog::getProcRelationStatistics(const RelationshipType& type) const {
+	return type == RelationshipType::USES ? this->procUsesStatistics : this->procModifiesStatistics;
+}
+
+const RelationStatistics& StatisticsCatalog::getClauseRelationStatistics(const RelationshipType& type, shared_ptr<QueryInput> input1) const {
+	return this->isProcInput(type, input1) ? this->getProcRelationStatistics(type) : this->getRelationStatistics(type);
+}
+
+bool StatisticsCatalog::isProcInput(const RelationshipType& type, shared_ptr<QueryInput> input) const {
+	if (type != RelationshipType::USES && type != RelationshipType::MODIFIES) {
+		return false;
+	}
+	if (input->getQueryInputType() == QueryInputType::IDENT) {
+		return true;
+	}
+	if (input->getQueryInputType() == QueryInputType::DECLARATION) {
+		return dynamic_pointer_cast<Declaration>(input)->getEntityType() == EntityType::PROC;
+	}
+	return false;
+}
+
+// fraction of the statements matched by a statement-typed declaration
+double StatisticsCatalog::getSelectivity(shared_ptr<QueryInput> input) const {
+	if (input->getQueryInputType() != QueryInputType::DECLARATION) {
+		return 1;
+	}
+	EntityType type = dynamic_pointer_cast<Declaration>(input)->getEntityType();
+	switch (type) {
+	case EntityType::WHILE:
+	case EntityType::IF:
+	case EntityType::ASSIGN:
+	case EntityType::READ:
+	case EntityType::PRINT:
+	case EntityType::CALL: {
+		int total = this->getEntityCount(EntityType::STMT);
+		return total == 0 ? 0 : (double) this->getEntityCount(type) / total;
+	}
+	default:
+		return 1;
+	}
+}
+
+double StatisticsCatalog::estimateResultSize(const RelationshipType& type,
+	shared_ptr<QueryInput> input1, shared_ptr<QueryInput> input2) const {
+	const RelationStatistics& statistics = this->getClauseRelationStatistics(type, input1);
+
+	QueryInputType leftType = input1->getQueryInputType();
+	QueryInputType rightType = input2->getQueryInputType();
+	bool leftDeclaration = leftType == QueryInputType::DECLARATION;
+	bool rightDeclaration = rightType == QueryInputType::DECLARATION;
+	double leftSelectivity = this->getSelectivity(input1);
+	double rightSelectivity = this->getSelectivity(input2);
+
+	if (leftDeclaration && rightDeclaration) {
+		return statistics.pairCount * leftSelectivity * rightSelectivity;
+	}
+	else if (leftDeclaration) {
+		if (rightType == QueryInputType::ANY) {
+			return statistics.distinctLeftCount * leftSelectivity;
+		}
+		return statistics.getAverageInDegree() * leftSelectivity;
+	}
+	else if (rightDeclaration) {
+		if (leftType == QueryInputType::ANY) {
+			return statistics.distinctRightCount * rightSelectivity;
+		}
+		return statistics.getAverageOutDegree() * rightSelectivity;
+	}
+	// boolean clause, at most one row
+	return min(1.0, (double) statistics.pairCount);
+}
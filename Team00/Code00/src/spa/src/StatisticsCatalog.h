@@ -0,0 +1,89 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "EntityType.h"
+#include "RelationshipType.h"
+#include "QueryInput.h"
+#include "EnumClassHash.h"
+
+using namespace std;
+
+struct RelationStatistics {
+	int pairCount = 0; // number of (left, right) pairs
+	int distinctLeftCount = 0; // number of distinct left values
+	int distinctRightCount = 0; // number of distinct right values
+	map<int, int> outDegreeHistogram; // out-degree -> number of left values
+	map<int, int> inDegreeHistogram; // in-degree -> number of right values
+
+	double getAverageOutDegree() const;
+	double getAverageInDegree() const;
+};
+
+class StatisticsCatalog {
+
+public:
+	StatisticsCatalog();
+
+	/**
+	* Computes statistics of a relation from its forward and backward maps
+	*
+	* @param relation map from left value to right values
+	* @param relationBy map from right value to left values
+	*
+	* @return statistics of the relation
+	*/
+	static RelationStatistics computeStatistics(
+		const unordered_map<string, unordered_set<string>>& relation,
+		const unordered_map<string, unordered_set<string>>& relationBy);
+
+	void setEntityCount(const EntityType& type, const int& count);
+
+	void setRelationStatistics(const RelationshipType& type, const RelationStatistics& statistics);
+
+	/**
+	* Sets statistics of Uses/Modifies where the left value is a procedure
+	*/
+	void setProcRelationStatistics(const RelationshipType& type, const RelationStatistics& statistics);
+
+	int getEntityCount(const EntityType& type) const;
+
+	const RelationStatistics& getRelationStatistics(const RelationshipType& type) const;
+
+	const RelationStatistics& getProcRelationStatistics(const RelationshipType& type) const;
+
+	/**
+	* Gets the statistics of the relation read by a relationship clause,
+	* which are of procedures for Uses/Modifies with a procedure as the first input
+	*/
+	const RelationStatistics& getClauseRelationStatistics(const RelationshipType& type, shared_ptr<QueryInput> input1) const;
+
+	/**
+	* Estimates the number of results of a relationship clause before it is evaluated,
+	* assuming the synonym types filter the relation independently
+	*
+	* @param type
+	* @param input1 the first input of relationship
+	* @param input2 the second input of relationship
+	*
+	* @return estimated number of rows (pairs for two declarations, values for one,
+	* and at most 1 for boolean clauses)
+	*/
+	double estimateResultSize(const RelationshipType& type,
+		shared_ptr<QueryInput> input1, shared_ptr<QueryInput> input2) const;
+
+private:
+	unordered_map<EntityType, int, EnumClassHash> entityCounts;
+
+	RelationStatistics relationStatistics[RELATIONSHIP_TYPE_COUNT];
+
+	RelationStatistics procUsesStatistics, procModifiesStatistics;
+
+	bool isProcInput(const RelationshipType& type, shared_ptr<QueryInput> input) const;
+
+	double getSelectivity(shared_ptr<QueryInput> input) const;
+};
@@ -0,0 +1,66 @@
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = max(1u, thread::hardware_concurrency());
+	}
+	for (size_t i = 0; i < threadCount; i++) {
+		this->aWorkers.emplace_back(&ThreadPool::runWorker, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> lock(this->aMutex);
+		this->isStopping = true;
+	}
+	this->aTaskAvailable.notify_all();
+	for (thread& worker : this->aWorkers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::submit(function<void()> task) {
+	{
+		lock_guard<mutex> lock(this->aMutex);
+		this->aTasks.push(move(task));
+	}
+	this->aTaskAvailable.notify_one();
+}
+
+void ThreadPool::waitAll() {
+	unique_lock<mutex> lock(this->aMutex);
+	this->aTasksDone.wait(lock, [this] { return this->aTasks.empty() && this->aActiveCount == 0; });
+}
+
+size_t ThreadPool::getThreadCount() {
+	return this->aWorkers.size();
+}
+
+void ThreadPool::runWorker() {
+	while (true) {
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(this->aMutex);
+			this->aTaskAvailable.wait(lock, [this] { return this->isStopping || !this->aTasks.empty(); });
+			if (this->aTasks.empty()) { // stopping and nothing left to run
+				return;
+			}
+			task = move(this->aTasks.front());
+			this->aTasks.pop();
+			this->aActiveCount++;
+		}
+
+		task();
+
+		{
+			lock_guard<mutex> lock(this->aMutex);
+			this->aActiveCount--;
+			if (this->aTasks.empty() && this->aActiveCount == 0) {
+				this->aTasksDone.notify_all();
+			}
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// fixed number of worker threads running submitted tasks in submission order
+class ThreadPool {
+private:
+	vector<thread> aWorkers;
+	queue<function<void()>> aTasks;
+	mutex aMutex;
+	condition_variable aTaskAvailable;
+	condition_variable aTasksDone;
+	int aActiveCount = 0;
+	bool isStopping = false;
+
+	void runWorker();
+
+public:
+	// uses the number of hardware threads if threadCount is 0
+	ThreadPool(size_t threadCount = 0);
+
+	// finishes the queued tasks before joining the workers
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void submit(function<void()> task);
+
+	// blocks until every submitted task has finished
+	void waitAll();
+
+	size_t getThreadCount();
+};
@@ -1,5 +1,6 @@
 #include "Tokenizer.h"
 #include "SyntacticException.h" // for throwing SyntacticException
+#include "MonotonicArena.h"
 #include <ctype.h>  // for std::isdigit, std::isalpha
 #include <algorithm>  // for std::find
 #include <iterator>  // for std::begin, std::end
@@ -58,30 +59,30 @@ std::shared_ptr<Token> Tokenizer::convertTokenWithSymbolToIdentifierToken(TokenT
     switch (type)
     {
     case TokenTypes::ParentT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "Parent" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "Parent" });
         break;
     case TokenTypes::FollowsT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "Follows" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "Follows" });
         break;
     case TokenTypes::NextT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "Next" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "Next" });
         break;
     case TokenTypes::CallsT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "Calls" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "Calls" });
         break;
     case TokenTypes::AffectsT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "Affects" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "Affects" });
         break;
     case TokenTypes::AffectsBipT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "AffectsBip" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "AffectsBip" });
         break;
     case TokenTypes::NextBipT:
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, "NextBip" });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, "NextBip" });
         break;
     default:
         break;
     }
-    tokenizer->addToTokenBuffer(std::make_shared<Token>(Token{ TokenTypes::TermSymbol, "*" }));
+    tokenizer->addToTokenBuffer(MonotonicArena::makeShared<Token>(Token{ TokenTypes::TermSymbol, "*" }));
     return token;
 }
 
@@ -98,8 +99,8 @@ Tokenizer::Tokenizer(const std::string givenInput) : inputStream(givenInput)
 */
 std::shared_ptr<Token> Tokenizer::readInteger()
 {
-    std::string integer = readWhile(std::isdigit);
-    return std::make_shared<Token>(Token{ TokenTypes::Integer, integer });
+    std::string integer = readWhile(::isdigit);
+    return MonotonicArena::makeShared<Token>(Token{ TokenTypes::Integer, integer });
 }
 
 /*
@@ -127,7 +128,7 @@ bool Tokenizer::isPureIdentifier(std::string s)
 std::shared_ptr<Token> Tokenizer::readIdentifier()
 {
     std::string identifier = std::string(1, inputStream.next());
-    identifier += readWhile(std::isalnum);
+    identifier += readWhile(::isalnum);
 
     // Peek at the next character to handle special cases
     char c = ' ';
@@ -137,37 +138,37 @@ std::shared_ptr<Token> Tokenizer::readIdentifier()
     if (c == '#') {
         identifier += inputStream.next();
         if (identifier == "stmt#")
-            return std::make_shared<Token>(Token{ TokenTypes::AttrName, identifier });
+            return MonotonicArena::makeShared<Token>(Token{ TokenTypes::AttrName, identifier });
     }
     else if (c == '_') {
         identifier += inputStream.next();
-        identifier += readWhile(std::isalpha);
+        identifier += readWhile(::isalpha);
         if (identifier == "prog_line" && (inputStream.eof() || std::isspace(inputStream.peek())))
-            return std::make_shared<Token>(Token{ TokenTypes::DesignEntity, identifier });
+            return MonotonicArena::makeShared<Token>(Token{ TokenTypes::DesignEntity, identifier });
     }
     else if (c == '*') {
         identifier += inputStream.peek();  // Do not consume this character yet
         std::shared_ptr<Token> token = std::shared_ptr<Token>();
         if (identifier == "Parent*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::ParentT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::ParentT, identifier });
         }
         else if (identifier == "Follows*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::FollowsT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::FollowsT, identifier });
         }
         else if (identifier == "Calls*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::CallsT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::CallsT, identifier });
         }
         else if (identifier == "Next*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::NextT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::NextT, identifier });
         }
         else if (identifier == "NextBip*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::NextBipT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::NextBipT, identifier });
         }
         else if (identifier == "Affects*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::AffectsT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::AffectsT, identifier });
         }
         else if (identifier == "AffectsBip*") {
-            token = std::make_shared<Token>(Token{ TokenTypes::AffectsBipT, identifier });
+            token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::AffectsBipT, identifier });
         }
 
         // Consume the '*' character if a match was found
@@ -185,64 +186,64 @@ std::shared_ptr<Token> Tokenizer::readIdentifier()
     // Match other keywords
     std::shared_ptr<Token> token;
     if (identifier == "Select") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Select, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Select, identifier });
     }
     else if (identifier == "such") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Such, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Such, identifier });
     }
     else if (identifier == "that") {
-        token = std::make_shared<Token>(Token{ TokenTypes::That, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::That, identifier });
     }
     else if (identifier == "pattern") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Pattern, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Pattern, identifier });
     }
     else if (identifier == "and") {
-        token = std::make_shared<Token>(Token{ TokenTypes::And, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::And, identifier });
     }
     else if (identifier == "Modifies") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Modifies, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Modifies, identifier });
     }
     else if (identifier == "Uses") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Uses, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Uses, identifier });
     }
     else if (identifier == "Parent") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Parent, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Parent, identifier });
     }
     else if (identifier == "Follows") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Follows, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Follows, identifier });
     }
     else if (identifier == "Calls") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Calls, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Calls, identifier });
     }
     else if (identifier == "Next") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Next, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Next, identifier });
     }
     else if (identifier == "NextBip") {
-        token = std::make_shared<Token>(Token{ TokenTypes::NextBip, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::NextBip, identifier });
     }
     else if (identifier == "Affects") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Affects, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Affects, identifier });
     }
     else if (identifier == "AffectsBip") {
-        token = std::make_shared<Token>(Token{ TokenTypes::AffectsBip, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::AffectsBip, identifier });
     }
     else if (identifier == "with") {
-        token = std::make_shared<Token>(Token{ TokenTypes::With, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::With, identifier });
     }
     else if (identifier == "BOOLEAN") {
-        token = std::make_shared<Token>(Token{ TokenTypes::Boolean, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Boolean, identifier });
     }
     else if (std::find(std::begin(Tokenizer::designEntities), std::end(Tokenizer::designEntities), identifier) != std::end(Tokenizer::designEntities)) {
-        token = std::make_shared<Token>(Token{ TokenTypes::DesignEntity, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::DesignEntity, identifier });
     }
     else if (std::find(std::begin(Tokenizer::attrNames), std::end(Tokenizer::attrNames), identifier) != std::end(Tokenizer::attrNames)) {
-        token = std::make_shared<Token>(Token{ TokenTypes::AttrName, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::AttrName, identifier });
     }
     else {
         // Valid identifier must not contain any special characters, throw syntax error if such characters found
         if (!isPureIdentifier(identifier))
             throw SyntacticException("Invalid identifier encountered: " + identifier);
-        token = std::make_shared<Token>(Token{ TokenTypes::Identifier, identifier });
+        token = MonotonicArena::makeShared<Token>(Token{ TokenTypes::Identifier, identifier });
     }
     return token;
 }
@@ -280,49 +281,49 @@ std::shared_ptr<Token> Tokenizer::readNext()
         return token;
     }
 
-    readWhile(std::isspace);
+    readWhile(::isspace);
     if (inputStream.eof()) return std::shared_ptr<Token>();
     char ch = inputStream.peek();
     switch (ch)
     {
     case '(':
-        return std::make_shared<Token>(Token{ TokenTypes::LeftParen, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::LeftParen, std::string(1, inputStream.next()) });
         break;
     case ')':
-        return std::make_shared<Token>(Token{ TokenTypes::RightParen, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::RightParen, std::string(1, inputStream.next()) });
         break;
     case '"':
-        return std::make_shared<Token>(Token{ TokenTypes::DoubleQuote, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::DoubleQuote, std::string(1, inputStream.next()) });
         break;
     case '_':
-        return std::make_shared<Token>(Token{ TokenTypes::Underscore, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::Underscore, std::string(1, inputStream.next()) });
         break;
     case ';':
-        return std::make_shared<Token>(Token{ TokenTypes::Semicolon, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::Semicolon, std::string(1, inputStream.next()) });
         break;
     case ',':
-        return std::make_shared<Token>(Token{ TokenTypes::Comma, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::Comma, std::string(1, inputStream.next()) });
         break;
     case '+':
     case '-':
-        return std::make_shared<Token>(Token{ TokenTypes::ExprSymbol, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::ExprSymbol, std::string(1, inputStream.next()) });
         break;
     case '/':
     case '%':
     case '*':
-        return std::make_shared<Token>(Token{ TokenTypes::TermSymbol, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::TermSymbol, std::string(1, inputStream.next()) });
         break;
     case '<':
-        return std::make_shared<Token>(Token{ TokenTypes::LeftAngleBracket, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::LeftAngleBracket, std::string(1, inputStream.next()) });
         break;
     case '>':
-        return std::make_shared<Token>(Token{ TokenTypes::RightAngleBracket, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::RightAngleBracket, std::string(1, inputStream.next()) });
         break;
     case '=':
-        return std::make_shared<Token>(Token{ TokenTypes::Equals, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::Equals, std::string(1, inputStream.next()) });
         break;
     case '.':
-        return std::make_shared<Token>(Token{ TokenTypes::Dot, std::string(1, inputStream.next()) });
+        return MonotonicArena::makeShared<Token>(Token{ TokenTypes::Dot, std::string(1, inputStream.next()) });
         break;
     default:
         break;
@@ -0,0 +1,190 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <thread>
+
+#include "Tracer.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+mutex Tracer::aMutex;
+vector<TraceEvent> Tracer::aEvents;
+size_t Tracer::aOldestEvent = 0;
+const size_t Tracer::MAX_EVENT_COUNT;
+
+namespace {
+	const chrono::steady_clock::time_point TRACE_START = chrono::steady_clock::now();
+
+	// per thread, so that the deltas of a scope are not mixed with the allocations of other threads
+	thread_local long long allocationCount = 0;
+	thread_local long long allocatedBytes = 0;
+
+	string escapeJson(const string& text) {
+		string escaped;
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+
+#ifdef SPA_ENABLE_TRACING
+	// writes the trace on exit when SPA_TRACE_FILE is set, so that any executable linking spa can be traced
+	struct TraceFileWriter {
+		~TraceFileWriter() {
+			const char* filename = getenv("SPA_TRACE_FILE");
+			if (filename != nullptr && !Tracer::writeChromeTrace(filename)) {
+				fprintf(stderr, "Cannot open the File : %s\n", filename);
+			}
+		}
+	};
+
+	TraceFileWriter traceFileWriter;
+#endif
+}
+
+#ifdef SPA_ENABLE_TRACING
+// counting replacements of the global allocation functions, the other forms forward to these
+void* operator new(size_t size) {
+	allocationCount++;
+	allocatedBytes += size;
+	void* pointer = malloc(size == 0 ? 1 : size);
+	if (pointer == nullptr) {
+		throw bad_alloc();
+	}
+	return pointer;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+	free(pointer);
+}
+#endif
+
+bool Tracer::isEnabled() {
+#ifdef SPA_ENABLE_TRACING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Tracer::record(const TraceEvent& event) {
+	lock_guard<mutex> lock(aMutex);
+	if (aEvents.size() < MAX_EVENT_COUNT) {
+		aEvents.push_back(event);
+		return;
+	}
+	aEvents[aOldestEvent] = event;
+	aOldestEvent = (aOldestEvent + 1) % MAX_EVENT_COUNT;
+}
+
+vector<TraceEvent> Tracer::getEvents() {
+	lock_guard<mutex> lock(aMutex);
+	vector<TraceEvent> events(aEvents.begin() + aOldestEvent, aEvents.end());
+	events.insert(events.end(), aEvents.begin(), aEvents.begin() + aOldestEvent);
+	return events;
+}
+
+void Tracer::clear() {
+	lock_guard<mutex> lock(aMutex);
+	aEvents.clear();
+	aOldestEvent = 0;
+}
+
+void Tracer::writeChromeTrace(ostream& out) {
+	vector<TraceEvent> events = getEvents();
+	out << "{\"traceEvents\":[";
+	for (size_t i = 0; i < events.size(); i++) {
+		const TraceEvent& event = events[i];
+		out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << escapeJson(event.name) << "\",\"cat\":\"spa\",\"ph\":\"X\""
+			<< ",\"ts\":" << event.startMicros << ",\"dur\":" << event.durationMicros
+			<< ",\"pid\":1,\"tid\":" << event.threadId
+			<< ",\"args\":{\"residentBytesDelta\":" << event.residentBytesDelta
+			<< ",\"allocationCount\":" << event.allocationCount << ",\"allocatedBytes\":" << event.allocatedBytes << "}}";
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool Tracer::writeChromeTrace(const string& filename) {
+	ofstream out(filename.c_str());
+	if (!out) {
+		return false;
+	}
+	writeChromeTrace(out);
+	return true;
+}
+
+long long Tracer::getMicros() {
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - TRACE_START).count();
+}
+
+long long Tracer::getResidentBytes() {
+#ifdef __linux__
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if (statm == nullptr) {
+		return 0;
+	}
+	long long totalPages = 0;
+	long long residentPages = 0;
+	int count = fscanf(statm, "%lld %lld", &totalPages, &residentPages);
+	fclose(statm);
+	return count == 2 ? residentPages * sysconf(_SC_PAGESIZE) : 0;
+#else
+	return 0;
+#endif
+}
+
+long long Tracer::getAllocationCount() {
+	return allocationCount;
+}
+
+long long Tracer::getAllocatedBytes() {
+	return allocatedBytes;
+}
+
+size_t Tracer::getThreadId() {
+	return hash<thread::id>()(this_thread::get_id()) % 100000;
+}
+
+TraceScope::TraceScope(const char* name) {
+	this->aName = name;
+	this->aStartResidentBytes = Tracer::getResidentBytes();
+	this->aStartAllocationCount = Tracer::getAllocationCount();
+	this->aStartAllocatedBytes = Tracer::getAllocatedBytes();
+	this->aStartMicros = Tracer::getMicros();
+}
+
+TraceScope::~TraceScope() {
+	TraceEvent event;
+	event.name = this->aName;
+	event.startMicros = this->aStartMicros;
+	event.durationMicros = Tracer::getMicros() - this->aStartMicros;
+	event.threadId = Tracer::getThreadId();
+	event.allocationCount = Tracer::getAllocationCount() - this->aStartAllocationCount;
+	event.allocatedBytes = Tracer::getAllocatedBytes() - this->aStartAllocatedBytes;
+	event.residentBytesDelta = Tracer::getResidentBytes() - this->aStartResidentBytes;
+	Tracer::record(event);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// SPA_TRACE_SCOPE("name") times the rest of the enclosing block. It compiles to nothing unless the build
+// defines SPA_ENABLE_TRACING (cmake -DSPA_ENABLE_TRACING=ON); the name must be a string literal.
+#ifdef SPA_ENABLE_TRACING
+#define SPA_TRACE_CONCAT_INNER(a, b) a##b
+#define SPA_TRACE_CONCAT(a, b) SPA_TRACE_CONCAT_INNER(a, b)
+#define SPA_TRACE_SCOPE(name) TraceScope SPA_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define SPA_TRACE_SCOPE(name) do {} while (0)
+#endif
+
+struct TraceEvent {
+	const char* name;
+	long long startMicros; // since the process started tracing
+	long long durationMicros;
+	size_t threadId;
+	long long residentBytesDelta;
+	long long allocationCount; // operator new calls on the thread of the scope, only counted in tracing builds
+	long long allocatedBytes;
+};
+
+// Collects the events of finished trace scopes and writes them as Chrome trace-event JSON.
+// In tracing builds, the events are also written to the file named by SPA_TRACE_FILE when the process exits.
+// Only the latest MAX_EVENT_COUNT events are kept, so a long-running server does not grow without bound.
+class Tracer {
+private:
+	static mutex aMutex;
+	static vector<TraceEvent> aEvents; // ring buffer once full
+	static size_t aOldestEvent;
+
+public:
+	static const size_t MAX_EVENT_COUNT = 1 << 16;
+
+	// whether SPA_TRACE_SCOPE records anything in this build
+	static bool isEnabled();
+
+	static void record(const TraceEvent& event);
+
+	static vector<TraceEvent> getEvents();
+
+	static void clear();
+
+	// complete ("X") events, one per scope, with the memory deltas as arguments
+	static void writeChromeTrace(ostream& out);
+
+	// @return false if the file cannot be written
+	static bool writeChromeTrace(const string& filename);
+
+	static long long getMicros();
+
+	// resident set size of the process, 0 where it cannot be read
+	static long long getResidentBytes();
+
+	static long long getAllocationCount();
+
+	static long long getAllocatedBytes();
+
+	static size_t getThreadId();
+};
+
+// records a trace event from its construction to its destruction
+class TraceScope {
+private:
+	const char* aName;
+	long long aStartMicros;
+	long long aStartResidentBytes;
+	long long aStartAllocationCount;
+	long long aStartAllocatedBytes;
+
+public:
+	TraceScope(const char* name);
+
+	TraceScope(const TraceScope&) = delete;
+
+	TraceScope& operator=(const TraceScope&) = delete;
+
+	~TraceScope();
+};
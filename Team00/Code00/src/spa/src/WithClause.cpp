@@ -1,4 +1,6 @@
 #include "WithClause.h"
+#include "Declaration.h"
+#include "MonotonicArena.h"
 
 WithClause::WithClause(shared_ptr<QueryInput> leftInput, shared_ptr<QueryInput> rightInput) {
 	this->aLeftInput = leftInput;
@@ -12,4 +14,25 @@ shared_ptr<QueryInput> WithClause::getLeftInput() {
 
 shared_ptr<QueryInput> WithClause::getRightInput() {
 	return this->aRightInput;
-}
\ No newline at end of file
+}
+
+vector<string> WithClause::getResultSynonyms() {
+	bool isLeftDeclaration = this->aLeftInput->getQueryInputType() == QueryInputType::DECLARATION;
+	bool isRightDeclaration = this->aRightInput->getQueryInputType() == QueryInputType::DECLARATION;
+	if (!isLeftDeclaration || !isRightDeclaration) {
+		return OptionalClause::getResultSynonyms();
+	}
+
+	bool isLeftAttribute = dynamic_pointer_cast<Declaration>(this->aLeftInput)->getIsAttribute();
+	bool isRightAttribute = dynamic_pointer_cast<Declaration>(this->aRightInput)->getIsAttribute();
+	if (isLeftAttribute && !isRightAttribute) { // results are keyed by the declaration
+		return { this->aRightInput->getValue(), this->aLeftInput->getValue() };
+	}
+
+	// a set result of two declarations holds values common to both
+	return { this->aLeftInput->getValue(), this->aRightInput->getValue() };
+}
+
+shared_ptr<OptionalClause> WithClause::clone() {
+	return MonotonicArena::makeShared<WithClause>(this->aLeftInput, this->aRightInput);
+}
@@ -8,4 +8,6 @@ public:
 	WithClause(shared_ptr<QueryInput> leftInput, shared_ptr<QueryInput> rightInput);
 	shared_ptr<QueryInput> getLeftInput();
 	shared_ptr<QueryInput> getRightInput();
+	vector<string> getResultSynonyms();
+	shared_ptr<OptionalClause> clone();
 };
\ No newline at end of file
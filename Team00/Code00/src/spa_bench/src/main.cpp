@@ -0,0 +1,431 @@
+// Benchmark suite: times lexing, parsing, each design extraction phase, PKB getters, ResultUtil joins,
+// whole queries and the sorted id set kernels, and writes the timings as JSON to track regressions.
+//
+// usage: spa_bench [--repeat <count>] [--output <file>] [--filter <text>] [--no-synthetic] [<source file>...]
+//
+// e.g. spa_bench ../Tests00/iteration*/*/*_source.txt --output bench.json
+// Every program is benchmarked: the given SIMPLE sources, then synthetic programs unless --no-synthetic.
+// Only benchmarks whose name contains the --filter text are run. Each entry of "benchmarks" holds the
+// benchmark name, the program it ran on, the repeat count, the minimum, median and mean milliseconds of one
+// run and the number of items it produced. Without --output, the JSON is written to stdout. Builds with
+// SPA_ENABLE_TRACING also count the operator new calls of one run on the benchmark thread as "allocations".
+// On Linux, "extract" and "handOff" also report how far one run raised the resident memory as "peakMemoryKb".
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DesignExtractor.h"
+#include "IdSetUtil.h"
+#include "MorselExecutor.h"
+#include "Parser.h"
+#include "QueryService.h"
+#include "ResultUtil.h"
+#include "SIMPLETokenStream.h"
+#include "SimpleProgramGenerator.h"
+#include "Tracer.h"
+
+using namespace std;
+
+namespace {
+	struct BenchmarkResult {
+		string name;
+		string program;
+		vector<double> milliseconds;
+		size_t itemCount = 0;
+		long long allocationCount = 0;
+		long long peakMemoryKb = -1; // only measured for loading the PKB
+	};
+
+	struct Program {
+		string name;
+		vector<string> lines;
+	};
+
+	struct BenchmarkQuery {
+		string name;
+		string text;
+	};
+
+	// queries that are valid on any program, one per kind of relationship the evaluator handles differently
+	const vector<BenchmarkQuery> QUERIES = {
+		{ "followsStar", "stmt s1, s2; Select <s1, s2> such that Follows*(s1, s2)" },
+		{ "parentStarWhile", "while w; stmt s; Select s such that Parent*(w, s)" },
+		{ "modifiesPattern", "assign a; variable v; Select <a, v> such that Modifies(a, v) pattern a(v, _)" },
+		{ "usesCalls", "procedure p, q; variable v; Select <p, v> such that Calls*(p, q) and Uses(q, v)" },
+		{ "nextStar", "prog_line n1, n2; Select <n1, n2> such that Next*(n1, n2)" },
+		{ "affectsStar", "assign a1, a2; Select <a1, a2> such that Affects*(a1, a2)" },
+		{ "nextBipStar", "prog_line n1, n2; Select BOOLEAN such that NextBip*(n1, n2)" },
+		{ "withJoin", "assign a; read r; Select a such that Uses(a, _) with a.stmt# = r.stmt#" },
+		{ "multiClause", "assign a; while w; variable v; stmt s; Select <a, v> such that Parent*(w, a) and Modifies(a, v) and Uses(w, v) and Follows*(s, a)" },
+		{ "multiClausePattern", "assign a1, a2; variable v; Select <a1, a2, v> such that Follows*(a1, a2) and Modifies(a1, v) and Uses(a2, v) pattern a2(v, _)" },
+	};
+
+	const vector<pair<RelationshipType, string>> RELATIONSHIPS = {
+		{ FOLLOWS, "Follows" }, { FOLLOWS_T, "Follows*" }, { PARENT, "Parent" }, { PARENT_T, "Parent*" },
+		{ USES, "Uses" }, { MODIFIES, "Modifies" }, { CALLS, "Calls" }, { CALLS_T, "Calls*" },
+		{ NEXT, "Next" }, { NEXT_T, "Next*" }, { AFFECTS, "Affects" }, { AFFECTS_T, "Affects*" },
+		{ NEXTBIP, "NextBip" }, { NEXTBIP_T, "NextBip*" }, { AFFECTSBIP, "AffectsBip" }, { AFFECTSBIP_T, "AffectsBip*" },
+	};
+
+	int repeat = 5;
+	string filter;
+	vector<BenchmarkResult> results;
+
+	bool isSelected(const string& name) {
+		return name.find(filter) != string::npos;
+	}
+
+	void record(const string& name, const string& program, const vector<double>& milliseconds, size_t itemCount,
+		long long allocationCount = 0, long long peakMemoryKb = -1) {
+		results.push_back({ name, program, milliseconds, itemCount, allocationCount, peakMemoryKb });
+		cerr << name << " on " << program << ": " << fixed << setprecision(3)
+			<< *min_element(milliseconds.begin(), milliseconds.end()) << " ms" << endl;
+	}
+
+	// runs the operation repeat times and records its times, the operation returns the number of items it produced
+	template <typename Operation>
+	void run(const string& name, const string& program, Operation operation) {
+		if (!isSelected(name)) {
+			return;
+		}
+		vector<double> milliseconds;
+		size_t itemCount = 0;
+		long long allocationCount = 0;
+		for (int i = 0; i < repeat; i++) {
+			long long startAllocationCount = Tracer::getAllocationCount();
+			auto start = chrono::steady_clock::now();
+			itemCount = operation();
+			milliseconds.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+			allocationCount = Tracer::getAllocationCount() - startAllocationCount;
+		}
+		record(name, program, milliseconds, itemCount, allocationCount);
+	}
+
+	// a memory field of /proc/self/status in kB, or -1 where it is not available
+	long long readMemoryKb(const string& field) {
+		ifstream status("/proc/self/status");
+		string line;
+		while (getline(status, line)) {
+			if (line.compare(0, field.size() + 1, field + ":") == 0) {
+				return atoll(line.c_str() + field.size() + 1);
+			}
+		}
+		return -1;
+	}
+
+	// returns the freed heap to the system and restarts the peak resident memory from the current one,
+	// so that the peak of the next run is not hidden by earlier runs
+	void resetPeakMemory() {
+#ifdef __GLIBC__
+		malloc_trim(0);
+#endif
+		ofstream("/proc/self/clear_refs") << "5";
+	}
+
+	vector<string> readLines(const string& filename) {
+		ifstream in(filename.c_str());
+		vector<string> lines;
+		string line;
+		while (getline(in, line)) {
+			if (line.size() > 0) {
+				lines.push_back(line);
+			}
+		}
+		return lines;
+	}
+
+	Program generateProgram(CallGraphShape shape, const string& shapeName, int statementCount) {
+		GeneratorOptions options;
+		options.statementCount = statementCount;
+		options.procedureCount = 7;
+		options.callGraphShape = shape;
+		return { "synthetic-" + shapeName + "-" + to_string(statementCount), SimpleProgramGenerator(options).generateProgram() };
+	}
+
+	shared_ptr<PKB> extract(const vector<string>& lines, vector<pair<string, double>>* phaseTimes, const bool& isHandOff = false) {
+		SIMPLETokenStream stream{ lines };
+		DesignExtractor extractor;
+		Parser parser{ extractor };
+		if (parser.parseProgram(stream).hasError()) {
+			return nullptr;
+		}
+		shared_ptr<PKB> pkb = isHandOff ? extractor.handOffToPKB() : extractor.extractToPKB();
+		pkb->init();
+		if (phaseTimes != nullptr) {
+			*phaseTimes = extractor.getPhaseTimes();
+		}
+		return pkb;
+	}
+
+	// times one extraction into milliseconds and returns how far it raised the resident memory, or -1 if unknown;
+	// the PKB is still held at the end, as it is when queries start
+	long long timeExtract(const vector<string>& lines, const bool& isHandOff, vector<pair<string, double>>* phaseTimes,
+		vector<double>& milliseconds) {
+		resetPeakMemory();
+		long long startMemoryKb = readMemoryKb("VmRSS");
+		auto start = chrono::steady_clock::now();
+		shared_ptr<PKB> pkb = extract(lines, phaseTimes, isHandOff);
+		milliseconds.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+		long long peakMemoryKb = readMemoryKb("VmHWM");
+		return startMemoryKb < 0 || peakMemoryKb < 0 ? -1 : peakMemoryKb - startMemoryKb;
+	}
+
+	void benchmarkProgram(const Program& program) {
+		shared_ptr<PKB> pkb = extract(program.lines, nullptr);
+		if (pkb == nullptr) {
+			cerr << "skipping " << program.name << ": not a valid SIMPLE program" << endl;
+			return;
+		}
+
+		run("lex", program.name, [&]() {
+			SIMPLETokenStream stream{ program.lines };
+			size_t count = 0;
+			for (; !stream.isEmpty(); stream.getToken()) {
+				count++;
+			}
+			return count;
+		});
+
+		run("parse", program.name, [&]() {
+			SIMPLETokenStream stream{ program.lines };
+			DesignExtractor extractor;
+			Parser parser{ extractor };
+			parser.parseProgram(stream);
+			return program.lines.size();
+		});
+
+		// the phases are timed inside the extractor, so one set of runs gives every phase
+		if (isSelected("extract") || filter.compare(0, 8, "extract/") == 0) {
+			vector<double> totalMilliseconds;
+			vector<pair<string, vector<double>>> phaseMilliseconds;
+			long long peakMemoryKb = -1;
+			for (int i = 0; i < repeat; i++) {
+				vector<pair<string, double>> phaseTimes;
+				peakMemoryKb = timeExtract(program.lines, false, &phaseTimes, totalMilliseconds);
+				phaseMilliseconds.resize(phaseTimes.size());
+				for (size_t j = 0; j < phaseTimes.size(); j++) {
+					phaseMilliseconds[j].first = phaseTimes[j].first;
+					phaseMilliseconds[j].second.push_back(phaseTimes[j].second * 1000);
+				}
+			}
+			if (isSelected("extract")) {
+				record("extract", program.name, totalMilliseconds, program.lines.size(), 0, peakMemoryKb);
+			}
+			for (const pair<string, vector<double>>& phase : phaseMilliseconds) {
+				if (isSelected("extract/" + phase.first)) {
+					record("extract/" + phase.first, program.name, phase.second, 0);
+				}
+			}
+		}
+
+		if (isSelected("handOff")) {
+			vector<double> milliseconds;
+			long long peakMemoryKb = -1;
+			for (int i = 0; i < repeat; i++) {
+				peakMemoryKb = timeExtract(program.lines, true, nullptr, milliseconds);
+			}
+			record("handOff", program.name, milliseconds, program.lines.size(), 0, peakMemoryKb);
+		}
+
+		for (const pair<RelationshipType, string>& relationship : RELATIONSHIPS) {
+			RelationshipType type = relationship.first;
+			EntityType leftType = type == CALLS || type == CALLS_T ? EntityType::PROC : EntityType::STMT;
+			EntityType rightType = type == USES || type == MODIFIES ? EntityType::VAR : leftType;
+			shared_ptr<QueryInput> left = make_shared<Declaration>(leftType, "x");
+			shared_ptr<QueryInput> right = make_shared<Declaration>(rightType, "y");
+			run("pkb/" + relationship.second, program.name, [&]() {
+				size_t count = 0;
+				for (auto& entry : pkb->getMapResultsOfRS(type, left, right)) {
+					count += entry.second.size();
+				}
+				return count;
+			});
+		}
+
+		// Follows*(s1, s2) joined with Parent*(s2, s3), on s2 and on both synonyms with Next*(s1, s2)
+		shared_ptr<QueryInput> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+		shared_ptr<QueryInput> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+		shared_ptr<QueryInput> s3 = make_shared<Declaration>(EntityType::STMT, "s3");
+		unordered_map<string, unordered_set<string>> followsStar = pkb->getMapResultsOfRS(FOLLOWS_T, s1, s2);
+		unordered_map<string, unordered_set<string>> parentStar = pkb->getMapResultsOfRS(PARENT_T, s2, s3);
+		unordered_map<string, unordered_set<string>> nextStar = pkb->getMapResultsOfRS(NEXT_T, s1, s2);
+		run("join/oneCommon", program.name, [&]() {
+			shared_ptr<ResultsTable> table = ResultUtil::getCartesianProductFromMap(followsStar, { "s1", "s2" },
+				make_shared<ResultsTable>());
+			table = ResultUtil::getNaturalJoinFromMap(parentStar, { "s2", "s3" }, table, { "s2" });
+			return (size_t) table->getTableSize();
+		});
+		run("join/twoCommon", program.name, [&]() {
+			shared_ptr<ResultsTable> table = ResultUtil::getCartesianProductFromMap(followsStar, { "s1", "s2" },
+				make_shared<ResultsTable>());
+			table = ResultUtil::getNaturalJoinFromMap(nextStar, { "s1", "s2" }, table, { "s1", "s2" });
+			return (size_t) table->getTableSize();
+		});
+
+		QueryService service;
+		for (const BenchmarkQuery& query : QUERIES) {
+			run("query/" + query.name, program.name, [&]() {
+				service.setPKB(pkb); // drops the cached clause results of the previous run
+				list<string> answers;
+				string errorMessage;
+				service.evaluate(query.text, answers, errorMessage);
+				return answers.size();
+			});
+		}
+	}
+
+	vector<uint32_t> getRandomIds(mt19937& generator, size_t count, uint32_t maxId) {
+		set<uint32_t> ids;
+		uniform_int_distribution<uint32_t> distribution(0, maxId);
+		while (ids.size() < count) {
+			ids.insert(distribution(generator));
+		}
+		return vector<uint32_t>(ids.begin(), ids.end());
+	}
+
+	string getKernelName(IdSetUtil::Kernel kernel) {
+		switch (kernel) {
+		case IdSetUtil::Kernel::SSE:
+			return "sse4.2";
+		case IdSetUtil::Kernel::AVX2:
+			return "avx2";
+		default:
+			return "scalar";
+		}
+	}
+
+	// every supported kernel against probing a hash set, on similar and on skewed sizes
+	void benchmarkIdSets() {
+		IdSetUtil::Kernel bestKernel = IdSetUtil::getBestKernel();
+		mt19937 generator(32);
+		vector<pair<size_t, size_t>> sizes = { { 10000, 10000 }, { 100000, 100000 }, { 100, 100000 } };
+		for (const pair<size_t, size_t>& size : sizes) {
+			uint32_t maxId = (uint32_t) (size.second * 4);
+			vector<uint32_t> values1 = getRandomIds(generator, size.first, maxId);
+			vector<uint32_t> values2 = getRandomIds(generator, size.second, maxId);
+			string program = "random-" + to_string(size.first) + "x" + to_string(size.second);
+
+			for (IdSetUtil::Kernel kernel : { IdSetUtil::Kernel::SCALAR, IdSetUtil::Kernel::SSE, IdSetUtil::Kernel::AVX2 }) {
+				if (kernel > bestKernel) {
+					continue;
+				}
+				IdSetUtil::setKernel(kernel);
+				run("idset/intersect/" + getKernelName(kernel), program, [&]() {
+					return IdSetUtil::intersect(values1, values2).size();
+				});
+				run("idset/difference/" + getKernelName(kernel), program, [&]() {
+					return IdSetUtil::difference(values1, values2).size();
+				});
+			}
+
+			unordered_set<uint32_t> hashSet(values2.begin(), values2.end());
+			run("idset/intersect/hash", program, [&]() {
+				size_t count = 0;
+				for (uint32_t value : values1) {
+					count += hashSet.count(value);
+				}
+				return count;
+			});
+		}
+		IdSetUtil::setKernel(bestKernel);
+	}
+
+	string escapeJson(const string& text) {
+		string escaped;
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	void writeJson(ostream& out) {
+		out << "{\n  \"context\": { \"repeat\": " << repeat << ", \"threads\": " << MorselExecutor::getThreadCount()
+			<< ", \"idSetKernel\": \"" << getKernelName(IdSetUtil::getBestKernel()) << "\" },\n  \"benchmarks\": [";
+		for (size_t i = 0; i < results.size(); i++) {
+			vector<double> milliseconds = results[i].milliseconds;
+			sort(milliseconds.begin(), milliseconds.end());
+			double total = 0;
+			for (double value : milliseconds) {
+				total += value;
+			}
+			out << (i == 0 ? "\n" : ",\n") << fixed << setprecision(4)
+				<< "    { \"name\": \"" << escapeJson(results[i].name) << "\", \"program\": \"" << escapeJson(results[i].program)
+				<< "\", \"repeat\": " << milliseconds.size() << ", \"minMs\": " << milliseconds.front()
+				<< ", \"medianMs\": " << milliseconds[milliseconds.size() / 2] << ", \"meanMs\": " << total / milliseconds.size()
+				<< ", \"items\": " << results[i].itemCount;
+#ifdef SPA_ENABLE_TRACING
+			out << ", \"allocations\": " << results[i].allocationCount;
+#endif
+			if (results[i].peakMemoryKb >= 0) {
+				out << ", \"peakMemoryKb\": " << results[i].peakMemoryKb;
+			}
+			out << " }";
+		}
+		out << "\n  ]\n}" << endl;
+	}
+}
+
+int main(int argc, char** argv) {
+	string outputFile;
+	bool hasSynthetic = true;
+	vector<Program> programs;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		if (argument == "--repeat" && i + 1 < argc) {
+			repeat = max(1, atoi(argv[++i]));
+		}
+		else if (argument == "--output" && i + 1 < argc) {
+			outputFile = argv[++i];
+		}
+		else if (argument == "--filter" && i + 1 < argc) {
+			filter = argv[++i];
+		}
+		else if (argument == "--no-synthetic") {
+			hasSynthetic = false;
+		}
+		else if (argument.size() > 0 && argument[0] != '-') {
+			programs.push_back({ argument, readLines(argument) });
+		}
+		else {
+			cerr << "usage: spa_bench [--repeat <count>] [--output <file>] [--filter <text>] [--no-synthetic] [<source file>...]" << endl;
+			return 1;
+		}
+	}
+	if (hasSynthetic) {
+		programs.push_back(generateProgram(CallGraphShape::CHAIN, "chain", 500));
+		programs.push_back(generateProgram(CallGraphShape::DIAMOND, "diamond", 500));
+	}
+
+	for (const Program& program : programs) {
+		benchmarkProgram(program);
+	}
+	benchmarkIdSets();
+
+	if (outputFile.empty()) {
+		writeJson(cout);
+		return 0;
+	}
+	ofstream out(outputFile.c_str());
+	if (!out) {
+		cerr << "Cannot open the File : " << outputFile << endl;
+		return 1;
+	}
+	writeJson(out);
+	return 0;
+}
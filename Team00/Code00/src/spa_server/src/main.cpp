@@ -0,0 +1,257 @@
+// Query server: loads a SIMPLE program once and answers PQL queries on a thread pool.
+//
+// usage: spa_server <source file> [--socket <path>] [--threads <count>] [--batch] [--pipelined] [--timeout <ms>]
+//                   [--query-memory <MB>] [--memory <MB>]
+//
+// Every request is one line holding one query. Every response is one line
+// "<sequence number>\t<answers separated by ", ">", or "<sequence number>\t!<error>" for syntax errors,
+// where the sequence number counts the requests of the client from 1. With --timeout, a query running longer
+// is stopped and answered "<sequence number>\t!<error>" as well, the other queries go on. So is a query whose
+// intermediate results go over --query-memory even when pipelined, or over --memory together with the other queries. Responses are written
+// as soon as their query is answered, so they may come back in a different order than the requests.
+// Without --socket, requests are read from stdin and responses are written to stdout.
+// With --batch, all queries on stdin are evaluated as one batch sharing common clauses, the responses, errors included,
+// are written in request order and the batch statistics are written to stderr.
+// With --pipelined, single queries are evaluated by pulling bindings through operators in bounded memory.
+// A query prefixed with "EXPLAIN ANALYZE " is profiled: its response has a third field, a JSON report of the time
+// and result size of each clause fetch, the join algorithm and rows of each merge, and the projection time.
+// Profiled queries are not pipelined, and the prefix is not understood in --batch mode.
+
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "QueryService.h"
+#include "ThreadPool.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+	const string EXPLAIN_PREFIX = "EXPLAIN ANALYZE ";
+
+	string formatResponse(const int& sequenceNumber, const QueryPlanStatus& status, const list<string>& results,
+		const string& errorMessage) {
+		stringstream response;
+		response << sequenceNumber << "\t";
+		if (status == QueryPlanStatus::SYNTAX_ERROR || status == QueryPlanStatus::TIMEOUT || status == QueryPlanStatus::MEMORY_LIMIT) {
+			response << "!" << errorMessage;
+		}
+		else {
+			bool isFirst = true;
+			for (const string& result : results) {
+				response << (isFirst ? "" : ", ") << result;
+				isFirst = false;
+			}
+		}
+		response << "\n";
+		return response.str();
+	}
+
+	// one client, responses of its queries are written by whichever worker answers them
+	class Client {
+	private:
+		mutex aWriteMutex;
+		int aFileDescriptor;
+
+	public:
+		// -1 writes to stdout
+		Client(int fileDescriptor) : aFileDescriptor(fileDescriptor) {}
+
+		~Client() {
+#ifndef _WIN32
+			if (this->aFileDescriptor >= 0) {
+				close(this->aFileDescriptor);
+			}
+#endif
+		}
+
+		void write(const string& response) {
+			lock_guard<mutex> lock(this->aWriteMutex);
+			if (this->aFileDescriptor < 0) {
+				cout << response << flush;
+				return;
+			}
+#ifndef _WIN32
+			size_t written = 0;
+			while (written < response.size()) {
+				ssize_t count = send(this->aFileDescriptor, response.data() + written, response.size() - written, MSG_NOSIGNAL);
+				if (count <= 0) { // client has gone away
+					return;
+				}
+				written += count;
+			}
+#endif
+		}
+	};
+
+	void submitQuery(ThreadPool& pool, QueryService& service, shared_ptr<Client> client, int sequenceNumber, string query) {
+		pool.submit([&service, client, sequenceNumber, query]() {
+			list<string> results;
+			string errorMessage;
+			bool isExplained = query.compare(0, EXPLAIN_PREFIX.size(), EXPLAIN_PREFIX) == 0;
+			shared_ptr<QueryProfile> profile = isExplained ? make_shared<QueryProfile>() : nullptr;
+			QueryPlanStatus status = service.evaluate(isExplained ? query.substr(EXPLAIN_PREFIX.size()) : query,
+				results, errorMessage, profile);
+			string response = formatResponse(sequenceNumber, status, results, errorMessage);
+			if (isExplained) {
+				stringstream report;
+				profile->writeJson(report);
+				response.insert(response.size() - 1, "\t" + report.str());
+			}
+			client->write(response);
+		});
+	}
+
+	void serveStdin(ThreadPool& pool, QueryService& service) {
+		shared_ptr<Client> client = make_shared<Client>(-1);
+		string line;
+		int sequenceNumber = 0;
+		while (getline(cin, line)) {
+			submitQuery(pool, service, client, ++sequenceNumber, line);
+		}
+		pool.waitAll();
+	}
+
+	void serveBatch(QueryService& service) {
+		vector<string> queries;
+		string line;
+		while (getline(cin, line)) {
+			queries.push_back(line);
+		}
+
+		vector<QueryResponse> responses;
+		BatchStatistics statistics = service.evaluateBatch(queries, responses);
+		for (size_t i = 0; i < responses.size(); i++) {
+			cout << formatResponse(i + 1, responses[i].status, responses[i].results, responses[i].errorMessage);
+		}
+		cerr << statistics.queryCount << " queries (" << statistics.validQueryCount << " valid) in "
+			<< statistics.elapsedSeconds << "s, " << statistics.getQueriesPerSecond() << " queries/s; "
+			<< statistics.sharedClauseCount << " shared clauses reused " << statistics.reusedClauseCount << " times, "
+			<< statistics.sharedGroupCount << " shared clause groups reused " << statistics.reusedGroupCount << " times, "
+			<< statistics.timedOutQueryCount << " queries timed out, " << statistics.overBudgetQueryCount << " over the memory budget\n";
+	}
+
+#ifndef _WIN32
+	void serveClient(ThreadPool& pool, QueryService& service, int fileDescriptor) {
+		shared_ptr<Client> client = make_shared<Client>(fileDescriptor);
+		string pending;
+		char buffer[4096];
+		int sequenceNumber = 0;
+		ssize_t count;
+		while ((count = recv(fileDescriptor, buffer, sizeof(buffer), 0)) > 0) {
+			pending.append(buffer, count);
+			size_t end;
+			while ((end = pending.find('\n')) != string::npos) {
+				submitQuery(pool, service, client, ++sequenceNumber, pending.substr(0, end));
+				pending.erase(0, end + 1);
+			}
+		}
+		if (!pending.empty()) {
+			submitQuery(pool, service, client, ++sequenceNumber, pending);
+		}
+		// the connection is closed once the last response of the client is written
+	}
+
+	int serveSocket(ThreadPool& pool, QueryService& service, const string& path) {
+		int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+		if (listener < 0 || path.size() >= sizeof(address.sun_path)) {
+			cerr << "Cannot create socket " << path << "\n";
+			return 1;
+		}
+		path.copy(address.sun_path, path.size());
+		unlink(path.c_str());
+		if (bind(listener, (sockaddr*) &address, sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0) {
+			cerr << "Cannot listen on socket " << path << "\n";
+			close(listener);
+			return 1;
+		}
+
+		while (true) {
+			int fileDescriptor = accept(listener, nullptr, nullptr);
+			if (fileDescriptor < 0) {
+				continue;
+			}
+			thread(serveClient, ref(pool), ref(service), fileDescriptor).detach();
+		}
+	}
+#endif
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		cerr << "usage: " << argv[0] << " <source file> [--socket <path>] [--threads <count>] [--batch] [--pipelined]"
+			<< " [--timeout <ms>] [--query-memory <MB>] [--memory <MB>]\n";
+		return 1;
+	}
+
+	string socketPath;
+	size_t threadCount = 0;
+	int timeoutMillis = 0;
+	size_t queryMemoryBytes = 0;
+	bool isBatch = false;
+	bool isPipelined = false;
+	for (int i = 2; i < argc; i++) {
+		string option = argv[i];
+		if (option == "--batch") {
+			isBatch = true;
+		}
+		else if (option == "--pipelined") {
+			isPipelined = true;
+		}
+		else if (option == "--socket" && i + 1 < argc) {
+			socketPath = argv[++i];
+		}
+		else if (option == "--threads" && i + 1 < argc) {
+			threadCount = stoul(argv[++i]);
+		}
+		else if (option == "--timeout" && i + 1 < argc) {
+			timeoutMillis = stoi(argv[++i]);
+		}
+		else if (option == "--query-memory" && i + 1 < argc) {
+			queryMemoryBytes = stoul(argv[++i]) << 20;
+		}
+		else if (option == "--memory" && i + 1 < argc) {
+			MemoryBudget::getProcessBudget()->setLimit(stoul(argv[++i]) << 20);
+		}
+	}
+
+	QueryService service;
+	string errorMessage;
+	if (!service.loadSource(argv[1], errorMessage)) {
+		cerr << errorMessage << "\n";
+		return 1;
+	}
+	service.setPipelined(isPipelined);
+	service.setTimeout(timeoutMillis);
+	service.setQueryMemoryBudget(queryMemoryBytes);
+
+	if (isBatch) {
+		serveBatch(service);
+		return 0;
+	}
+
+	ThreadPool pool(threadCount);
+	if (socketPath.empty()) {
+		serveStdin(pool, service);
+		return 0;
+	}
+#ifndef _WIN32
+	return serveSocket(pool, service, socketPath);
+#else
+	cerr << "--socket is not supported on this platform\n";
+	return 1;
+#endif
+}
@@ -0,0 +1,23 @@
+#include "ProgramFixture.h"
+#include "SimpleProgramGenerator.h"
+#include "DesignExtractor.h"
+#include "Parser.h"
+#include "SIMPLETokenStream.h"
+#include "catch.hpp"
+
+vector<string> generateLargeProgram() {
+	GeneratorOptions options;
+	options.statementCount = 300;
+	options.procedureCount = 3;
+	return SimpleProgramGenerator(options).generateProgram();
+}
+
+shared_ptr<PKB> extractProgram(const vector<string>& lines) {
+	SIMPLETokenStream stream{ lines };
+	DesignExtractor extractor;
+	Parser parser{ extractor };
+	REQUIRE_FALSE(parser.parseProgram(stream).hasError());
+	shared_ptr<PKB> pkb = extractor.extractToPKB();
+	pkb->init();
+	return pkb;
+}
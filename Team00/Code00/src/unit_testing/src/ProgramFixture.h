@@ -0,0 +1,13 @@
+#pragma once
+#include "PKB.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// generated program of 300 statements in 3 procedures, large enough for queries over it to run long or take much memory
+vector<string> generateLargeProgram();
+
+// parses the program and returns its extracted and initialised PKB, failing the test if the program does not parse
+shared_ptr<PKB> extractProgram(const vector<string>& lines);
@@ -0,0 +1,61 @@
+#include "BatchResults.h"
+#include "RelationshipClause.h"
+#include "Declaration.h"
+#include "StmtNum.h"
+#include "catch.hpp"
+
+TEST_CASE("BatchResults builds group keys independent of synonym names") {
+	shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	shared_ptr<Declaration> x = make_shared<Declaration>(EntityType::STMT, "x");
+	shared_ptr<Declaration> y = make_shared<Declaration>(EntityType::STMT, "y");
+	shared_ptr<Declaration> b = make_shared<Declaration>(EntityType::ASSIGN, "b");
+
+	unordered_map<string, string> names;
+	unordered_map<string, string> otherNames;
+	string key = BatchResults::getGroupKey({ make_shared<RelationshipClause>(RelationshipType::FOLLOWS, s1, s2),
+		make_shared<RelationshipClause>(RelationshipType::PARENT, s2, a) }, names, false);
+
+	// same group written with other names and in another order
+	REQUIRE(key == BatchResults::getGroupKey({ make_shared<RelationshipClause>(RelationshipType::PARENT, y, b),
+		make_shared<RelationshipClause>(RelationshipType::FOLLOWS, x, y) }, otherNames, false));
+	REQUIRE(names.at("s2") == otherNames.at("y"));
+	REQUIRE(names.at("a") == otherNames.at("b"));
+
+	// a different join between the clauses
+	REQUIRE(key != BatchResults::getGroupKey({ make_shared<RelationshipClause>(RelationshipType::FOLLOWS, s1, s2),
+		make_shared<RelationshipClause>(RelationshipType::PARENT, s1, a) }, otherNames, false));
+	REQUIRE(key != BatchResults::getGroupKey({ make_shared<RelationshipClause>(RelationshipType::FOLLOWS, s1, s2),
+		make_shared<RelationshipClause>(RelationshipType::PARENT, s2, a) }, otherNames, true));
+}
+
+TEST_CASE("BatchResults hands shared group results to other queries") {
+	shared_ptr<Query> query = make_shared<Query>();
+	shared_ptr<Declaration> s = make_shared<Declaration>(EntityType::STMT, "s");
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	query->addDeclarationToSelectClause(s);
+	query->addRelationshipClause(RelationshipType::PARENT, s, a);
+
+	shared_ptr<Query> otherQuery = make_shared<Query>();
+	shared_ptr<Declaration> w = make_shared<Declaration>(EntityType::STMT, "w");
+	shared_ptr<Declaration> b = make_shared<Declaration>(EntityType::ASSIGN, "b");
+	otherQuery->addDeclarationToSelectClause(b);
+	otherQuery->addRelationshipClause(RelationshipType::PARENT, w, b);
+
+	BatchResults batchResults;
+	batchResults.findSharedPieces({ query, otherQuery });
+	REQUIRE(batchResults.getSharedClauseCount() == 1);
+	REQUIRE(batchResults.getSharedGroupCount() == 1);
+
+	shared_ptr<ResultsTable> table = make_shared<ResultsTable>();
+	table->setTable({ { "s", 0 }, { "a", 1 } }, { { "2", "3" } });
+	batchResults.storeGroup(query->getOptionalClauses(), false, table);
+
+	shared_ptr<ResultsTable> sharedTable;
+	REQUIRE_FALSE(batchResults.lookupGroup(otherQuery->getOptionalClauses(), true, sharedTable));
+	REQUIRE(batchResults.lookupGroup(otherQuery->getOptionalClauses(), false, sharedTable));
+	REQUIRE(sharedTable->getSynonymIndexMap() == unordered_map<string, int>({ { "w", 0 }, { "b", 1 } }));
+	REQUIRE(sharedTable->getTableValues() == vector<vector<string>>({ { "2", "3" } }));
+	REQUIRE(batchResults.getReusedGroupCount() == 1);
+}
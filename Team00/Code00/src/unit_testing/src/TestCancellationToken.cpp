@@ -0,0 +1,114 @@
+#include "CancellationToken.h"
+#include "MorselExecutor.h"
+#include "QueryService.h"
+#include "ProgramFixture.h"
+#include "DesignExtractor.h"
+#include "Parser.h"
+#include "SIMPLETokenStream.h"
+#include "catch.hpp"
+#include <chrono>
+#include <thread>
+
+TEST_CASE("CancellationToken is cancelled by its deadline, its stop flag or cancel") {
+	shared_ptr<CancellationToken> token = make_shared<CancellationToken>();
+	REQUIRE_FALSE(token->isCancelled());
+	REQUIRE_NOTHROW(token->check());
+
+	SECTION("cancel") {
+		token->cancel();
+		REQUIRE(token->isCancelled());
+		REQUIRE_THROWS_AS(token->check(), QueryTimeoutException);
+	}
+
+	SECTION("deadline") {
+		token->setTimeout(1);
+		this_thread::sleep_for(chrono::milliseconds(5));
+		REQUIRE(token->isCancelled());
+	}
+
+	SECTION("stop flag") {
+		volatile bool stopFlag = false;
+		token->setStopFlag(&stopFlag);
+		REQUIRE_FALSE(token->isCancelled());
+		stopFlag = true;
+		REQUIRE(token->isCancelled());
+	}
+
+	SECTION("only the current token of the thread is checked") {
+		token->cancel();
+		REQUIRE_NOTHROW(CancellationToken::checkCurrent());
+		{
+			CancellationToken::Scope scope(token);
+			REQUIRE(CancellationToken::getCurrent() == token);
+			REQUIRE_THROWS_AS(CancellationToken::checkCurrent(), QueryTimeoutException);
+		}
+		REQUIRE(CancellationToken::getCurrent() == nullptr);
+	}
+
+	SECTION("loops run by MorselExecutor stop") {
+		token->cancel();
+		CancellationToken::Scope scope(token);
+		REQUIRE_THROWS_AS(MorselExecutor::run(1000, 1, [](size_t, size_t, vector<vector<string>>&) {}),
+			QueryTimeoutException);
+	}
+
+	SECTION("design extraction stops") {
+		token->cancel();
+		vector<string> lines = generateLargeProgram();
+		SIMPLETokenStream stream{ lines };
+		DesignExtractor extractor;
+		Parser parser{ extractor };
+		REQUIRE_FALSE(parser.parseProgram(stream).hasError());
+		CancellationToken::Scope scope(token);
+		REQUIRE_THROWS_AS(extractor.extractToPKB(), QueryTimeoutException);
+	}
+}
+
+TEST_CASE("QueryService stops queries at the timeout") {
+	QueryService service;
+	service.setPKB(extractProgram(generateLargeProgram()));
+	service.setTimeout(50);
+
+	// 300 ^ 4 combinations, far more than can be projected within the timeout
+	list<string> results = { "kept" };
+	string errorMessage;
+	auto start = chrono::steady_clock::now();
+	QueryPlanStatus status = service.evaluate("stmt s1, s2, s3, s4; Select <s1, s2, s3, s4>", results, errorMessage);
+	double elapsedMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	REQUIRE(status == QueryPlanStatus::TIMEOUT);
+	REQUIRE(results == list<string>({ "kept" }));
+	REQUIRE(errorMessage.find("stopped") != string::npos);
+	REQUIRE(elapsedMillis < 2000);
+
+	results.clear();
+	REQUIRE(service.evaluate("stmt s; Select s such that Follows(1, s)", results, errorMessage) == QueryPlanStatus::VALID);
+	REQUIRE(results.size() == 1);
+
+	SECTION("A query can be cancelled from another thread") {
+		service.setTimeout(0);
+		shared_ptr<CancellationToken> token = make_shared<CancellationToken>();
+		thread canceller([token]() {
+			this_thread::sleep_for(chrono::milliseconds(20));
+			token->cancel();
+		});
+		results.clear();
+		status = service.evaluate("stmt s1, s2, s3, s4; Select <s1, s2, s3, s4>", results, errorMessage, nullptr, token);
+		canceller.join();
+		REQUIRE(status == QueryPlanStatus::TIMEOUT);
+		REQUIRE(results.empty());
+	}
+
+	SECTION("Batches report queries stopped at the timeout and syntax errors") {
+		vector<QueryResponse> responses;
+		BatchStatistics statistics = service.evaluateBatch({ "stmt s1, s2, s3, s4; Select <s1, s2, s3, s4>",
+			"stmt s; Select s such that Follows(1, s)", "stmt s; Select s such that" }, responses);
+		REQUIRE(statistics.timedOutQueryCount == 1);
+		REQUIRE(responses[0].status == QueryPlanStatus::TIMEOUT);
+		REQUIRE(responses[0].results.empty());
+		REQUIRE(responses[0].errorMessage.find("stopped") != string::npos);
+		REQUIRE(responses[1].status == QueryPlanStatus::VALID);
+		REQUIRE(responses[1].results.size() == 1);
+		REQUIRE(responses[2].status == QueryPlanStatus::SYNTAX_ERROR);
+		REQUIRE_FALSE(responses[2].errorMessage.empty());
+	}
+}
@@ -0,0 +1,107 @@
+#include "ClauseResultCache.h"
+#include "QueryEvaluator.h"
+#include "Query.h"
+#include "RelationshipClause.h"
+#include "PatternClause.h"
+#include "WithClause.h"
+#include "Declaration.h"
+#include "StmtNum.h"
+#include "Any.h"
+#include "PKBStub.h"
+#include "catch.hpp"
+
+TEST_CASE("ClauseResultCache builds canonical clause keys") {
+	shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+	shared_ptr<Declaration> x = make_shared<Declaration>(EntityType::STMT, "x");
+	shared_ptr<Declaration> y = make_shared<Declaration>(EntityType::STMT, "y");
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+
+	string key = ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, s2));
+	REQUIRE(key == ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, x, y)));
+	REQUIRE(key != ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT, s1, s2)));
+	REQUIRE(key != ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, s1)));
+	REQUIRE(key != ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, a)));
+	REQUIRE(key != ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, make_shared<Any>("_"))));
+	REQUIRE(ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, make_shared<StmtNum>(3))) !=
+		ClauseResultCache::getClauseKey(make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, make_shared<StmtNum>(4))));
+
+	shared_ptr<Expression> expression = make_shared<Expression>("x", ExpressionType::PARTIAL);
+	string patternKey = ClauseResultCache::getClauseKey(make_shared<PatternClause>(a, make_shared<Any>("_"), expression));
+	REQUIRE(patternKey == ClauseResultCache::getClauseKey(make_shared<PatternClause>(
+		make_shared<Declaration>(EntityType::ASSIGN, "a1"), make_shared<Any>("_"), make_shared<Expression>("x", ExpressionType::PARTIAL))));
+	REQUIRE(patternKey != ClauseResultCache::getClauseKey(make_shared<PatternClause>(
+		a, make_shared<Any>("_"), make_shared<Expression>("x", ExpressionType::EXACT))));
+}
+
+TEST_CASE("ClauseResultCache stores clause results") {
+	shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+	shared_ptr<ClauseResultCache> cache = make_shared<ClauseResultCache>();
+
+	shared_ptr<OptionalClause> fetched = make_shared<RelationshipClause>(RelationshipType::AFFECTS_T, s1, s2);
+	fetched->addMapResult({ { "1", { "2", "3" } } });
+	bool hasResults = false;
+	REQUIRE_FALSE(cache->lookup(fetched, hasResults));
+	cache->store(fetched, true);
+
+	shared_ptr<OptionalClause> clause = make_shared<RelationshipClause>(RelationshipType::AFFECTS_T, s2, s1);
+	REQUIRE(cache->lookup(clause, hasResults));
+	REQUIRE(hasResults);
+	REQUIRE(clause->getClauseResultType() == ClauseResultType::MAP);
+	REQUIRE(clause->getMapResult() == fetched->getMapResult());
+	REQUIRE(clause->getResultSize() == 2);
+	REQUIRE(cache->getHitCount() == 1);
+	REQUIRE(cache->getMissCount() == 1);
+
+	SECTION("Clauses without results are cached") {
+		shared_ptr<OptionalClause> empty = make_shared<RelationshipClause>(RelationshipType::AFFECTS, s1, s2);
+		cache->store(empty, false);
+		REQUIRE(cache->lookup(make_shared<RelationshipClause>(RelationshipType::AFFECTS, s1, s2), hasResults));
+		REQUIRE_FALSE(hasResults);
+	}
+
+	SECTION("Least recently used results are evicted when over budget") {
+		size_t entryBytes = cache->getUsedBytes();
+		shared_ptr<ClauseResultCache> smallCache = make_shared<ClauseResultCache>(entryBytes * 2);
+		smallCache->store(fetched, true);
+		shared_ptr<OptionalClause> other = make_shared<RelationshipClause>(RelationshipType::NEXTBIP_T, s1, s2);
+		other->addMapResult({ { "4", { "5", "6" } } });
+		smallCache->store(other, true);
+		REQUIRE(smallCache->getSize() == 2);
+
+		shared_ptr<OptionalClause> large = make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, s2);
+		large->addMapResult({ { "7", { "8" } } });
+		REQUIRE(smallCache->lookup(clause, hasResults)); // AFFECTS_T becomes the most recently used
+		smallCache->store(large, true);
+		REQUIRE(smallCache->getSize() == 2);
+		REQUIRE(smallCache->getUsedBytes() <= entryBytes * 2);
+		REQUIRE(smallCache->lookup(clause, hasResults));
+		REQUIRE_FALSE(smallCache->lookup(make_shared<RelationshipClause>(RelationshipType::NEXTBIP_T, s1, s2), hasResults));
+	}
+}
+
+TEST_CASE("QueryEvaluator reuses cached clause results") {
+	shared_ptr<ClauseResultCache> cache = make_shared<ClauseResultCache>();
+	shared_ptr<PKBStub> pkb = make_shared<PKBStub>();
+
+	// Select a such that Affects*(a, 3)
+	shared_ptr<Query> query = make_shared<Query>();
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	query->addDeclarationToSelectClause(a);
+	query->addRelationshipClause(RelationshipType::AFFECTS_T, a, make_shared<StmtNum>(3));
+	pkb->addSetResult({ "1", "2" });
+	shared_ptr<ResultsTable> first = QueryEvaluator(query, pkb, cache).evaluate();
+	REQUIRE(cache->getMissCount() == 1);
+
+	// the PKB is not asked again, so the stub's new results are not used
+	shared_ptr<Query> sameQuery = make_shared<Query>();
+	shared_ptr<Declaration> b = make_shared<Declaration>(EntityType::ASSIGN, "b");
+	sameQuery->addDeclarationToSelectClause(b);
+	sameQuery->addRelationshipClause(RelationshipType::AFFECTS_T, b, make_shared<StmtNum>(3));
+	pkb->addSetResult({ "5" });
+	shared_ptr<ResultsTable> second = QueryEvaluator(sameQuery, pkb, cache).evaluate();
+	REQUIRE(cache->getHitCount() == 1);
+	REQUIRE(second->getTableValues().size() == 2);
+	REQUIRE(second->getSynonymIndexMap().count("b") == 1);
+}
@@ -58,6 +58,16 @@ TEST_CASE("Next BIP wiki") {
 
         REQUIRE(answer == result); 
     }
+
+    SECTION("check phase times") {
+        auto phaseTimes = extractor.getPhaseTimes();
+        REQUIRE(phaseTimes.size() == 10);
+        REQUIRE(phaseTimes.front().first == "cfg");
+        REQUIRE(phaseTimes.back().first == "affectsBip");
+        for (auto phase : phaseTimes) {
+            REQUIRE(phase.second >= 0);
+        }
+    }
 }
 
 
@@ -185,3 +195,50 @@ TEST_CASE("Test 2") {
         REQUIRE(answer == result); 
     }
 }
+
+TEST_CASE("Hand-off gives the same PKB as extraction") {
+    vector<string> codes = {
+        "procedure Bill {",
+        "x = 5;",
+        "call Mary;",
+        "y = x + 6;",
+        "while (x > 0) {",
+        "x = x - y; }",
+        "print z; }",
+        "procedure Mary {",
+        "read y;",
+        "if (y > 0) then {",
+        "z = x + y; }",
+        "else {",
+        "y = y * x; }}"
+    };
+
+    DesignExtractor extractor;
+    Parser parser{ extractor };
+    SIMPLETokenStream stream{ codes };
+    REQUIRE_FALSE(parser.parseProgram(stream).hasError());
+    auto pkb = extractor.extractToPKB();
+
+    DesignExtractor handOffExtractor;
+    Parser handOffParser{ handOffExtractor };
+    SIMPLETokenStream handOffStream{ codes };
+    REQUIRE_FALSE(handOffParser.parseProgram(handOffStream).hasError());
+    auto handOffPKB = handOffExtractor.handOffToPKB();
+
+    auto statement = make_shared<Declaration>(EntityType::STMT, "s");
+    auto otherStatement = make_shared<Declaration>(EntityType::STMT, "s2");
+    auto variable = make_shared<Declaration>(EntityType::VAR, "v");
+    for (RelationshipType type : { FOLLOWS, FOLLOWS_T, PARENT, PARENT_T, NEXT, NEXT_T, AFFECTS, AFFECTS_T,
+        NEXTBIP, NEXTBIP_T, AFFECTSBIP, AFFECTSBIP_T }) {
+        REQUIRE(handOffPKB->getMapResultsOfRS(type, statement, otherStatement) ==
+            pkb->getMapResultsOfRS(type, statement, otherStatement));
+    }
+    for (RelationshipType type : { USES, MODIFIES }) {
+        REQUIRE(handOffPKB->getMapResultsOfRS(type, statement, variable) == pkb->getMapResultsOfRS(type, statement, variable));
+    }
+    REQUIRE(handOffPKB->getEntities(EntityType::VAR) == pkb->getEntities(EntityType::VAR));
+    REQUIRE(handOffPKB->getMapResultsOfContainerPattern(EntityType::WHILE, variable) ==
+        pkb->getMapResultsOfContainerPattern(EntityType::WHILE, variable));
+    REQUIRE(handOffPKB->getNameFromStmtNum("7") == "y");
+    REQUIRE(handOffExtractor.getPhaseTimes().size() == extractor.getPhaseTimes().size());
+}
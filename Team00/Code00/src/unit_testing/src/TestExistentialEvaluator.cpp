@@ -0,0 +1,50 @@
+#include "ExistentialEvaluator.h"
+#include "RelationshipClause.h"
+#include "PatternClause.h"
+#include "WithClause.h"
+#include "Declaration.h"
+#include "StmtNum.h"
+#include "catch.hpp"
+
+TEST_CASE("ExistentialEvaluator finds a satisfying binding") {
+	shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+	shared_ptr<Declaration> s3 = make_shared<Declaration>(EntityType::STMT, "s3");
+
+	// Follows(s1, s2) and Parent(s2, s3)
+	shared_ptr<OptionalClause> follows = make_shared<RelationshipClause>(RelationshipType::FOLLOWS, s1, s2);
+	shared_ptr<OptionalClause> parent = make_shared<RelationshipClause>(RelationshipType::PARENT, s2, s3);
+	follows->addMapResult({ { "1", { "2" } }, { "2", { "3" } }, { "3", { "6" } } });
+
+	SECTION("Clauses share a satisfying value") {
+		parent->addMapResult({ { "6", { "7", "8" } } });
+		REQUIRE(ExistentialEvaluator({ follows, parent }).hasSatisfyingBinding());
+		REQUIRE(ExistentialEvaluator({ parent, follows }).hasSatisfyingBinding());
+	}
+
+	SECTION("Clauses do not share any value") {
+		parent->addMapResult({ { "4", { "5" } } });
+		REQUIRE_FALSE(ExistentialEvaluator({ follows, parent }).hasSatisfyingBinding());
+	}
+
+	SECTION("Set and boolean clauses restrict the binding") {
+		parent->addMapResult({ { "2", { "4" } }, { "6", { "7" } } });
+		shared_ptr<OptionalClause> with = make_shared<WithClause>(s1, make_shared<StmtNum>(3));
+		with->addSetResult({ "3" });
+		shared_ptr<OptionalClause> next = make_shared<RelationshipClause>(RelationshipType::NEXT, make_shared<StmtNum>(1), make_shared<StmtNum>(2));
+		next->setBoolResult(true);
+		REQUIRE(ExistentialEvaluator({ follows, parent, with, next }).hasSatisfyingBinding());
+
+		with->addSetResult({ "2" });
+		REQUIRE_FALSE(ExistentialEvaluator({ follows, parent, with, next }).hasSatisfyingBinding());
+	}
+
+	SECTION("Same synonym on both sides") {
+		shared_ptr<OptionalClause> nextStar = make_shared<RelationshipClause>(RelationshipType::NEXT_T, s1, s1);
+		nextStar->addMapResult({ { "1", { "2" } }, { "2", { "3" } } });
+		REQUIRE_FALSE(ExistentialEvaluator({ nextStar }).hasSatisfyingBinding());
+
+		nextStar->addMapResult({ { "1", { "2" } }, { "2", { "2", "3" } } });
+		REQUIRE(ExistentialEvaluator({ nextStar }).hasSatisfyingBinding());
+	}
+}
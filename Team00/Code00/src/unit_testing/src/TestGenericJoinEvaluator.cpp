@@ -0,0 +1,93 @@
+#include <set>
+
+#include "GenericJoinEvaluator.h"
+#include "DisjointClausesSet.h"
+#include "RelationshipClause.h"
+#include "WithClause.h"
+#include "Declaration.h"
+#include "StmtNum.h"
+#include "catch.hpp"
+
+namespace {
+	// rows of the table with columns in the order of the given synonyms
+	set<vector<string>> getRows(shared_ptr<ResultsTable> table, vector<string> synonyms) {
+		set<vector<string>> rows;
+		unordered_map<string, int> synonymIndex = table->getSynonymIndexMap();
+		for (vector<string> row : table->getTableValues()) {
+			vector<string> orderedRow;
+			for (string synonym : synonyms) {
+				orderedRow.push_back(row.at(synonymIndex.at(synonym)));
+			}
+			rows.insert(orderedRow);
+		}
+		return rows;
+	}
+}
+
+TEST_CASE("GenericJoinEvaluator intersect") {
+	vector<uint32_t> list1 = { 1, 3, 5, 7, 9 };
+	vector<uint32_t> list2 = { 3, 4, 5, 9 };
+	vector<uint32_t> list3 = { 0, 5, 9, 12 };
+	REQUIRE(GenericJoinEvaluator::intersect({ &list1, &list2, &list3 }) == vector<uint32_t>({ 5, 9 }));
+	REQUIRE(GenericJoinEvaluator::intersect({ &list1 }) == list1);
+
+	vector<uint32_t> empty;
+	REQUIRE(GenericJoinEvaluator::intersect({ &list1, &empty }).empty());
+}
+
+TEST_CASE("GenericJoinEvaluator joins cyclic clause groups") {
+	shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+	shared_ptr<Declaration> s3 = make_shared<Declaration>(EntityType::STMT, "s3");
+
+	// Follows*(s1, s2) and Parent*(s2, s3) and Next*(s3, s1)
+	shared_ptr<OptionalClause> follows = make_shared<RelationshipClause>(RelationshipType::FOLLOWS_T, s1, s2);
+	shared_ptr<OptionalClause> parent = make_shared<RelationshipClause>(RelationshipType::PARENT_T, s2, s3);
+	shared_ptr<OptionalClause> next = make_shared<RelationshipClause>(RelationshipType::NEXT_T, s3, s1);
+	follows->addMapResult({ { "1", { "2", "5" } }, { "2", { "5" } } });
+	parent->addMapResult({ { "2", { "3", "4" } }, { "5", { "6" } } });
+	next->addMapResult({ { "3", { "1", "4" } }, { "4", { "2" } }, { "6", { "1", "2" } } });
+
+	REQUIRE(DisjointClausesSet::isCyclic({ follows, parent, next }));
+	REQUIRE_FALSE(DisjointClausesSet::isCyclic({ follows, parent }));
+
+	SECTION("Every clause holds for each row") {
+		shared_ptr<ResultsTable> table = GenericJoinEvaluator({ follows, parent, next }).evaluate();
+		REQUIRE_FALSE(table->isNoResult());
+		REQUIRE(getRows(table, { "s1", "s2", "s3" }) == set<vector<string>>({
+			{ "1", "2", "3" }, { "1", "5", "6" }, { "2", "5", "6" } }));
+	}
+
+	SECTION("Set, boolean and same synonym clauses restrict the rows") {
+		shared_ptr<OptionalClause> with = make_shared<WithClause>(s1, make_shared<StmtNum>(1));
+		with->addSetResult({ "1" });
+		shared_ptr<OptionalClause> nextStar = make_shared<RelationshipClause>(RelationshipType::NEXT_T, s3, s3);
+		nextStar->addMapResult({ { "3", { "4" } }, { "6", { "6" } } });
+		shared_ptr<OptionalClause> isTrue = make_shared<RelationshipClause>(RelationshipType::FOLLOWS, make_shared<StmtNum>(1), make_shared<StmtNum>(2));
+		isTrue->setBoolResult(true);
+
+		shared_ptr<ResultsTable> table = GenericJoinEvaluator({ follows, parent, next, with, nextStar, isTrue }).evaluate();
+		REQUIRE(getRows(table, { "s1", "s2", "s3" }) == set<vector<string>>({ { "1", "5", "6" } }));
+
+		isTrue->setBoolResult(false);
+		REQUIRE(GenericJoinEvaluator({ follows, parent, next, isTrue }).evaluate()->isNoResult());
+	}
+
+	SECTION("No rows satisfy the cycle") {
+		next->addMapResult({ { "3", { "5" } } });
+		REQUIRE(GenericJoinEvaluator({ follows, parent, next }).evaluate()->isNoResult());
+	}
+}
+
+TEST_CASE("DisjointClausesSet isCyclic ignores clauses between the same synonyms") {
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	shared_ptr<Declaration> v = make_shared<Declaration>(EntityType::VAR, "v");
+	shared_ptr<OptionalClause> modifies = make_shared<RelationshipClause>(RelationshipType::MODIFIES, a, v);
+	shared_ptr<OptionalClause> uses = make_shared<RelationshipClause>(RelationshipType::USES, a, v);
+	shared_ptr<OptionalClause> affects = make_shared<RelationshipClause>(RelationshipType::AFFECTS, a, a);
+	modifies->addMapResult({ { "1", { "x" } } });
+	uses->addMapResult({ { "1", { "x" } } });
+	affects->addMapResult({ { "1", { "1" } } });
+
+	REQUIRE_FALSE(DisjointClausesSet::isCyclic({ modifies, uses, affects }));
+}
@@ -0,0 +1,64 @@
+#include "IdSetUtil.h"
+#include "catch.hpp"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+
+namespace {
+	vector<uint32_t> getRandomIds(mt19937& generator, size_t count, uint32_t maxId) {
+		set<uint32_t> ids;
+		uniform_int_distribution<uint32_t> distribution(0, maxId);
+		while (ids.size() < count) {
+			ids.insert(distribution(generator));
+		}
+		return vector<uint32_t>(ids.begin(), ids.end());
+	}
+}
+
+TEST_CASE("IdSetUtil gallopingSearch") {
+	vector<uint32_t> values = { 1, 3, 5, 7, 9, 11, 13 };
+	REQUIRE(IdSetUtil::gallopingSearch(values, 0, 0) == 0);
+	REQUIRE(IdSetUtil::gallopingSearch(values, 0, 7) == 3);
+	REQUIRE(IdSetUtil::gallopingSearch(values, 0, 8) == 4);
+	REQUIRE(IdSetUtil::gallopingSearch(values, 5, 3) == 5);
+	REQUIRE(IdSetUtil::gallopingSearch(values, 2, 13) == 6);
+	REQUIRE(IdSetUtil::gallopingSearch(values, 0, 14) == 7);
+	REQUIRE(IdSetUtil::gallopingSearch({}, 0, 1) == 0);
+}
+
+TEST_CASE("IdSetUtil kernels agree with the standard algorithms") {
+	IdSetUtil::Kernel bestKernel = IdSetUtil::getBestKernel();
+	mt19937 generator(32);
+
+	for (IdSetUtil::Kernel kernel : { IdSetUtil::Kernel::SCALAR, IdSetUtil::Kernel::SSE, IdSetUtil::Kernel::AVX2 }) {
+		IdSetUtil::setKernel(kernel);
+		REQUIRE(IdSetUtil::getKernel() == min(kernel, bestKernel));
+
+		// sizes around the block widths, similar sizes and skewed sizes, sparse and dense values
+		for (size_t size1 : { 0, 1, 7, 8, 9, 33, 300 }) {
+			for (size_t size2 : { 0, 3, 8, 16, 31, 250, 2000 }) {
+				for (uint32_t maxId : { 2500, 20000 }) {
+					vector<uint32_t> values1 = getRandomIds(generator, size1, maxId);
+					vector<uint32_t> values2 = getRandomIds(generator, size2, maxId);
+					INFO("kernel " << (int) kernel << ", sizes " << size1 << " and " << size2 << ", ids up to " << maxId);
+
+					vector<uint32_t> expected;
+					set_intersection(values1.begin(), values1.end(), values2.begin(), values2.end(), back_inserter(expected));
+					REQUIRE(IdSetUtil::intersect(values1, values2) == expected);
+					REQUIRE(IdSetUtil::intersect(values2, values1) == expected);
+
+					expected.clear();
+					set_difference(values1.begin(), values1.end(), values2.begin(), values2.end(), back_inserter(expected));
+					REQUIRE(IdSetUtil::difference(values1, values2) == expected);
+
+					expected.clear();
+					set_union(values1.begin(), values1.end(), values2.begin(), values2.end(), back_inserter(expected));
+					REQUIRE(IdSetUtil::mergeUnion(values1, values2) == expected);
+				}
+			}
+		}
+	}
+
+	IdSetUtil::setKernel(bestKernel);
+}
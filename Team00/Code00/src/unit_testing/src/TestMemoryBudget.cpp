@@ -0,0 +1,110 @@
+#include "MemoryBudget.h"
+#include "ResultsTable.h"
+#include "QueryService.h"
+#include "ProgramFixture.h"
+#include "catch.hpp"
+
+TEST_CASE("MemoryBudget charges its parents and refuses charges over its limit") {
+	shared_ptr<MemoryBudget> parent = make_shared<MemoryBudget>(1000);
+	shared_ptr<MemoryBudget> budget = make_shared<MemoryBudget>(600, parent);
+
+	budget->charge(500);
+	REQUIRE(budget->getUsedBytes() == 500);
+	REQUIRE(parent->getUsedBytes() == 500);
+	REQUIRE_THROWS_AS(budget->charge(200), MemoryBudgetExceededException);
+	REQUIRE(budget->getUsedBytes() == 500);
+
+	shared_ptr<MemoryBudget> sibling = make_shared<MemoryBudget>(0, parent);
+	REQUIRE_THROWS_AS(sibling->charge(600), MemoryBudgetExceededException);
+	REQUIRE(sibling->getUsedBytes() == 0);
+	REQUIRE(parent->getUsedBytes() == 500);
+
+	budget->release(500);
+	REQUIRE(budget->getUsedBytes() == 0);
+	REQUIRE(parent->getUsedBytes() == 0);
+	REQUIRE(budget->getPeakBytes() == 500);
+
+	SECTION("Tables are charged to the budget current when they are made") {
+		MemoryBudget::Scope scope(budget);
+		{
+			ResultsTable table;
+			table.populateWithSet({ "1", "2", "3" }, { "s" });
+			REQUIRE(budget->getUsedBytes() == MemoryBudget::estimateRowBytes(3, 1));
+			table.setTable({ { "s", 0 } }, { { "1" } });
+			REQUIRE(budget->getUsedBytes() == MemoryBudget::estimateRowBytes(1, 1));
+		}
+		REQUIRE(budget->getUsedBytes() == 0);
+
+		ResultsTable largeTable;
+		unordered_set<string> values;
+		for (int i = 0; i < 100; i++) {
+			values.insert(to_string(i));
+		}
+		REQUIRE_THROWS_AS(largeTable.populateWithSet(values, { "s" }), MemoryBudgetExceededException);
+	}
+
+	SECTION("Reservations outside a budget charge nothing") {
+		MemoryBudget::Reservation reservation;
+		reservation.add(1 << 30);
+		REQUIRE(reservation.getBytes() == 0);
+	}
+}
+
+TEST_CASE("QueryService keeps queries within their memory budget") {
+	QueryService service;
+	service.setPKB(extractProgram(generateLargeProgram()));
+	shared_ptr<QueryInput> left = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<QueryInput> right = make_shared<Declaration>(EntityType::STMT, "s2");
+	unordered_map<string, unordered_set<string>> pairs = service.getPKB()->getMapResultsOfRS(FOLLOWS_T, left, right);
+	size_t pairCount = 0;
+	size_t tripleCount = 0;
+	for (auto& entry : pairs) {
+		pairCount += entry.second.size();
+		for (const string& latter : entry.second) {
+			auto it = pairs.find(latter);
+			tripleCount += it == pairs.end() ? 0 : it->second.size();
+		}
+	}
+	// clause results are charged too, both clauses fit in the budget
+	REQUIRE(2 * (pairs.size() + pairCount) * MemoryBudget::estimateStringBytes(0) < 256 * 1024);
+	REQUIRE(MemoryBudget::estimateRowBytes(tripleCount, 3) > 512 * 1024);
+	size_t processBytes = MemoryBudget::getProcessBudget()->getUsedBytes();
+
+	list<string> expected;
+	string errorMessage;
+	string query = "stmt s1, s2, s3; Select s1 such that Follows*(s1, s2) and Follows*(s2, s3)";
+	REQUIRE(service.evaluate(query, expected, errorMessage) == QueryPlanStatus::VALID);
+
+	// the joined triples take more than the budget, their distinct first values do not
+	service.setQueryMemoryBudget(512 * 1024);
+	list<string> results;
+	REQUIRE(service.evaluate(query, results, errorMessage) == QueryPlanStatus::VALID);
+	results.sort();
+	expected.sort();
+	REQUIRE(results == expected);
+
+	vector<QueryResponse> responses;
+	REQUIRE(service.evaluateBatch({ query }, responses).overBudgetQueryCount == 0);
+	responses[0].results.sort();
+	REQUIRE(responses[0].results == expected);
+
+	results = { "kept" };
+	REQUIRE(service.evaluate("stmt s1, s2, s3; Select <s1, s2, s3>", results, errorMessage) == QueryPlanStatus::MEMORY_LIMIT);
+	REQUIRE(results == list<string>({ "kept" }));
+	REQUIRE(errorMessage.find("memory budget") != string::npos);
+	REQUIRE(service.evaluateBatch({ "stmt s1, s2, s3; Select <s1, s2, s3>" }, responses).overBudgetQueryCount == 1);
+	REQUIRE(responses[0].status == QueryPlanStatus::MEMORY_LIMIT);
+	REQUIRE(responses[0].errorMessage.find("memory budget") != string::npos);
+
+	SECTION("The process budget limits queries with no budget of their own") {
+		service.setQueryMemoryBudget(0);
+		MemoryBudget::getProcessBudget()->setLimit(processBytes + 64 * 1024);
+		results.clear();
+		QueryPlanStatus status = service.evaluate("stmt s1, s2, s3; Select <s1, s2, s3>", results, errorMessage);
+		MemoryBudget::getProcessBudget()->setLimit(0);
+		REQUIRE(status == QueryPlanStatus::MEMORY_LIMIT);
+		REQUIRE(results.empty());
+	}
+
+	REQUIRE(MemoryBudget::getProcessBudget()->getUsedBytes() == processBytes);
+}
@@ -0,0 +1,60 @@
+#include "MonotonicArena.h"
+#include "ResultsTable.h"
+#include "catch.hpp"
+#include <cstdint>
+#include <string>
+
+TEST_CASE("MonotonicArena hands out aligned memory from growing blocks") {
+	MonotonicArena arena(256);
+
+	void* first = arena.allocate(3, 1);
+	void* second = arena.allocate(sizeof(double), alignof(double));
+	REQUIRE((uintptr_t) second % alignof(double) == 0);
+	REQUIRE((char*) second >= (char*) first + 3);
+	REQUIRE(arena.getBlockCount() == 1);
+
+	for (int i = 0; i < 100; i++) {
+		REQUIRE((uintptr_t) arena.allocate(24, 16) % 16 == 0);
+	}
+	REQUIRE(arena.getBlockCount() > 1);
+	REQUIRE(arena.getUsedBytes() >= 3 + sizeof(double) + 2400);
+	REQUIRE(arena.getReservedBytes() >= arena.getUsedBytes());
+
+	// larger than any block so far gets a block of its own
+	size_t blockCount = arena.getBlockCount();
+	arena.allocate(MonotonicArena::MAX_BLOCK_SIZE * 2, 8);
+	REQUIRE(arena.getBlockCount() == blockCount + 1);
+}
+
+TEST_CASE("MonotonicArena makeShared allocates from the current arena") {
+	REQUIRE(MonotonicArena::getCurrent() == nullptr);
+	shared_ptr<ResultsTable> heapTable = MonotonicArena::makeShared<ResultsTable>();
+
+	weak_ptr<MonotonicArena> releasedArena;
+	shared_ptr<string> survivor;
+	{
+		shared_ptr<MonotonicArena> arena = make_shared<MonotonicArena>();
+		releasedArena = arena;
+		MonotonicArena::Scope arenaScope(arena);
+		REQUIRE(MonotonicArena::getCurrent() == arena);
+
+		shared_ptr<ResultsTable> table = MonotonicArena::makeShared<ResultsTable>();
+		table->setTable({ { "s", 0 } }, { { "1" }, { "2" } });
+		REQUIRE(table->getTableValues().size() == 2);
+		survivor = MonotonicArena::makeShared<string>("kept");
+		REQUIRE(arena->getUsedBytes() > 0);
+
+		{
+			MonotonicArena::Scope nestedScope(nullptr);
+			REQUIRE(MonotonicArena::getCurrent() == nullptr);
+		}
+		REQUIRE(MonotonicArena::getCurrent() == arena);
+	}
+	REQUIRE(MonotonicArena::getCurrent() == nullptr);
+
+	// objects still referred to keep their arena alive, the arena goes with the last of them
+	REQUIRE_FALSE(releasedArena.expired());
+	REQUIRE(*survivor == "kept");
+	survivor.reset();
+	REQUIRE(releasedArena.expired());
+}
@@ -0,0 +1,82 @@
+#include "MorselExecutor.h"
+#include "ResultUtil.h"
+#include "catch.hpp"
+#include <atomic>
+#include <stdexcept>
+
+TEST_CASE("MorselExecutor keeps the rows of each morsel in loop order") {
+	MorselExecutor::setThreadCount(4);
+	MorselExecutor::setParallelThreshold(0);
+
+	// each item costs a whole morsel, so every item is a morsel of its own
+	vector<vector<string>> rows = MorselExecutor::run(1000, MorselExecutor::MORSEL_COST,
+		[](size_t begin, size_t end, vector<vector<string>>& output) {
+		for (size_t i = begin; i < end; i++) {
+			output.push_back({ to_string(i) });
+			if (i % 2 == 0) {
+				output.push_back({ to_string(i), "even" });
+			}
+		}
+	});
+
+	REQUIRE(rows.size() == 1500);
+	size_t index = 0;
+	for (size_t i = 0; i < 1000; i++) {
+		REQUIRE(rows.at(index++) == vector<string>({ to_string(i) }));
+		if (i % 2 == 0) {
+			REQUIRE(rows.at(index++) == vector<string>({ to_string(i), "even" }));
+		}
+	}
+
+	SECTION("Errors in a morsel reach the caller") {
+		REQUIRE_THROWS_AS(MorselExecutor::run(100, MorselExecutor::MORSEL_COST,
+			[](size_t begin, size_t end, vector<vector<string>>&) {
+			if (begin <= 50 && 50 < end) {
+				throw runtime_error("morsel failed");
+			}
+		}), runtime_error);
+	}
+
+	SECTION("Tasks run once each, whatever their cost") {
+		MorselExecutor::setParallelThreshold(1 << 18);
+		vector<atomic<int>> runCounts(50);
+		vector<function<void()>> tasks;
+		for (size_t i = 0; i < runCounts.size(); i++) {
+			tasks.push_back([&runCounts, i]() { runCounts[i]++; });
+		}
+		MorselExecutor::runTasks(tasks);
+		for (atomic<int>& runCount : runCounts) {
+			REQUIRE(runCount == 1);
+		}
+
+		tasks.push_back([]() { throw runtime_error("task failed"); });
+		REQUIRE_THROWS_AS(MorselExecutor::runTasks(tasks), runtime_error);
+	}
+
+	SECTION("Joins give the same table in parallel") {
+		unordered_map<string, unordered_set<string>> PKBResults;
+		vector<vector<string>> tableValues;
+		for (int i = 0; i < 200; i++) {
+			for (int j = i; j < 200; j += 7) {
+				PKBResults[to_string(i)].insert(to_string(j));
+			}
+			tableValues.push_back({ to_string(i), to_string(i % 13) });
+		}
+		unordered_map<string, int> synonymIndex = { { "s1", 0 }, { "s2", 1 } };
+
+		vector<vector<string>> parallelRows;
+		vector<vector<string>> sequentialRows;
+		for (size_t threadCount : { 4, 1 }) {
+			MorselExecutor::setThreadCount(threadCount);
+			shared_ptr<ResultsTable> table = make_shared<ResultsTable>();
+			table->setTable(synonymIndex, tableValues);
+			table = ResultUtil::getNaturalJoinFromMap(PKBResults, { "s1", "s3" }, table, { "s1" });
+			(threadCount == 1 ? sequentialRows : parallelRows) = table->getTableValues();
+		}
+		REQUIRE(parallelRows.size() == 2958);
+		REQUIRE(parallelRows == sequentialRows);
+	}
+
+	MorselExecutor::setThreadCount(thread::hardware_concurrency());
+	MorselExecutor::setParallelThreshold(1 << 18);
+}
@@ -789,4 +789,65 @@ TEST_CASE("PKB withCaluse") {
 		REQUIRE(unordered_set<string>{ "7", "10" } == result4["1"]);
 		REQUIRE(unordered_set<string>{ } == result4["2"]);
 	}
-}
\ No newline at end of file
+
+	SECTION("attributeIndexJoin") {
+		// with s.stmt# = cn.value, probed from the constants
+		unordered_map<string, unordered_set<string>> result1 =
+			pkb.getDeclarationsMatchResults(
+				make_shared<Declaration>(EntityType::STMT, "s"),
+				make_shared<Declaration>(EntityType::CONST, "cn"));
+		REQUIRE(result1.size() == 5);
+		REQUIRE(unordered_set<string>{ "5" } == result1["5"]);
+		REQUIRE(unordered_set<string>{ "7" } == result1["7"]);
+
+		// with s.stmt# = r.varName, values of different kinds never match
+		unordered_map<string, unordered_set<string>> result2 =
+			pkb.getDeclarationMatchAttributeResults(
+				make_shared<Declaration>(EntityType::STMT, "s"), EntityType::READ);
+		REQUIRE(result2.empty());
+
+		// with a.stmt# = c.procName, ASSIGN has no secondary attribute
+		unordered_map<string, unordered_set<string>> result3 =
+			pkb.getAttributesMatchResults(EntityType::ASSIGN, EntityType::CALL);
+		REQUIRE(result3.empty());
+
+		// with v.varName = v1.varName
+		unordered_map<string, unordered_set<string>> result4 =
+			pkb.getDeclarationsMatchResults(
+				make_shared<Declaration>(EntityType::VAR, "v"),
+				make_shared<Declaration>(EntityType::VAR, "v1"));
+		REQUIRE(result4.size() == 5);
+		REQUIRE(unordered_set<string>{ "main" } == result4["main"]);
+	}
+}
+
+TEST_CASE("PKB filters statements by type") {
+	PKB pkb = PKB(6);
+	// 1 2 while 3 {4 5} 6
+	REQUIRE(pkb.setStatementType(1, EntityType::ASSIGN));
+	REQUIRE(pkb.setStatementType(2, EntityType::READ));
+	REQUIRE(pkb.setStatementType(3, EntityType::WHILE));
+	REQUIRE(pkb.setStatementType(4, EntityType::ASSIGN));
+	REQUIRE(pkb.setStatementType(5, EntityType::PRINT));
+	REQUIRE(pkb.setStatementType(6, EntityType::ASSIGN));
+	REQUIRE(pkb.insertFollow(1, 2));
+	REQUIRE(pkb.insertFollow(2, 3));
+	REQUIRE(pkb.insertFollow(3, 6));
+	REQUIRE(pkb.insertFollow(4, 5));
+	pkb.init();
+
+	shared_ptr<QueryInput> assign = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	shared_ptr<QueryInput> stmt = make_shared<Declaration>(EntityType::STMT, "s");
+	shared_ptr<QueryInput> any = make_shared<Any>("_");
+	REQUIRE(pkb.getSetResultsOfRS(FOLLOWS, assign, any) == unordered_set<string>({ "1", "4" }));
+	REQUIRE(pkb.getSetResultsOfRS(FOLLOWS, any, assign) == unordered_set<string>({ "6" }));
+	REQUIRE(pkb.getSetResultsOfRS(FOLLOWS, stmt, any) == unordered_set<string>({ "1", "2", "3", "4" }));
+	REQUIRE(pkb.getSetResultsOfRS(FOLLOWS, assign, make_shared<StmtNum>(2)) == unordered_set<string>({ "1" }));
+
+	unordered_map<string, unordered_set<string>> expected = { { "3", { "6" } } };
+	REQUIRE(pkb.getMapResultsOfRS(FOLLOWS, make_shared<Declaration>(EntityType::WHILE, "w"), assign) == expected);
+
+	REQUIRE(pkb.getEntities(EntityType::PROGLINE).size() == 6);
+	REQUIRE(pkb.getStatistics()->getEntityCount(EntityType::ASSIGN) == 3);
+	REQUIRE(pkb.getStatistics()->getEntityCount(EntityType::STMT) == 6);
+}
@@ -0,0 +1,106 @@
+#include "PKBBuilder.h"
+#include "Declaration.h"
+#include "MorselExecutor.h"
+
+#include "catch.hpp"
+using namespace std;
+
+namespace {
+	shared_ptr<PKB> makePKB() {
+		shared_ptr<PKB> pkb = make_shared<PKB>(6);
+		pkb->setStatementType(1, EntityType::ASSIGN);
+		pkb->setStatementType(2, EntityType::WHILE);
+		pkb->setStatementType(3, EntityType::ASSIGN);
+		pkb->setStatementType(4, EntityType::ASSIGN);
+		pkb->setStatementType(5, EntityType::PRINT);
+		pkb->setStatementType(6, EntityType::ASSIGN);
+		return pkb;
+	}
+
+	unordered_map<string, unordered_set<string>> getPairs(shared_ptr<PKB> pkb, const RelationshipType& type) {
+		return pkb->getMapResultsOfRS(type,
+			make_shared<Declaration>(EntityType::STMT, "s1"), make_shared<Declaration>(EntityType::STMT, "s2"));
+	}
+}
+
+TEST_CASE("PKBBuilder loads the same relationships as inserting pair by pair") {
+	// 1 2 {3 4} 5 6
+	unordered_map<int, vector<int>> parents = { { 2, { 3, 4 } }, { 5, { 4 } }, { 3, { 1 } } };
+	vector<vector<int>> follows = { {}, { 2, 3 }, { 5 }, { 4 }, {}, { 6 }, { 7 } };
+	unordered_map<int, vector<int>> nexts = { { 1, { 2 } }, { 2, { 3, 5 } }, { 3, { 4 } }, { 4, { 2 } }, { 5, { 6 } } };
+	unordered_map<int, vector<int>> affects = { { 1, { 3, 4, 2 } }, { 3, { 3, 4 } }, { 4, { 6 } } };
+	unordered_map<int, vector<string>> uses = { { 2, { "x", "y" } }, { 3, { "x" } }, { 9, { "z" } } };
+
+	shared_ptr<PKB> inserted = makePKB();
+	for (auto& entry : parents) {
+		for (int child : entry.second) {
+			inserted->insertParent(entry.first, child);
+		}
+	}
+	for (size_t former = 0; former < follows.size(); former++) {
+		for (int latter : follows[former]) {
+			inserted->insertFollow(former, latter);
+		}
+	}
+	for (auto& entry : nexts) {
+		for (int latter : entry.second) {
+			inserted->insertNext(entry.first, latter);
+		}
+	}
+	for (auto& entry : affects) {
+		for (int latter : entry.second) {
+			inserted->insertAffect(entry.first, latter);
+		}
+	}
+	for (auto& entry : uses) {
+		for (const string& variable : entry.second) {
+			inserted->insertUses(entry.first, variable);
+		}
+	}
+
+	for (size_t threadCount : { 1, 4 }) {
+		MorselExecutor::setThreadCount(threadCount);
+		shared_ptr<PKB> loaded = makePKB();
+		PKBBuilder builder(loaded);
+		builder.addRelationship(RelationshipType::PARENT, parents);
+		builder.addRelationship(RelationshipType::FOLLOWS, follows);
+		builder.addRelationship(RelationshipType::NEXT, nexts);
+		builder.addRelationship(RelationshipType::AFFECTS, affects);
+		builder.addRelationship(RelationshipType::USES, uses);
+		builder.build();
+
+		for (RelationshipType type : { RelationshipType::PARENT, RelationshipType::FOLLOWS,
+			RelationshipType::NEXT, RelationshipType::AFFECTS }) {
+			REQUIRE(getPairs(loaded, type) == getPairs(inserted, type));
+		}
+		REQUIRE(getPairs(loaded, RelationshipType::PARENT) ==
+			unordered_map<string, unordered_set<string>>({ { "2", { "3", "4" } } }));
+		REQUIRE(getPairs(loaded, RelationshipType::FOLLOWS) ==
+			unordered_map<string, unordered_set<string>>({ { "1", { "2" } }, { "2", { "5" } }, { "3", { "4" } }, { "5", { "6" } } }));
+		REQUIRE(getPairs(loaded, RelationshipType::AFFECTS) ==
+			unordered_map<string, unordered_set<string>>({ { "1", { "3", "4" } }, { "3", { "3", "4" } }, { "4", { "6" } } }));
+
+		shared_ptr<Declaration> variable = make_shared<Declaration>(EntityType::VAR, "v");
+		shared_ptr<Declaration> statement = make_shared<Declaration>(EntityType::STMT, "s");
+		REQUIRE(loaded->getMapResultsOfRS(RelationshipType::USES, statement, variable) ==
+			inserted->getMapResultsOfRS(RelationshipType::USES, statement, variable));
+		REQUIRE(loaded->getEntities(EntityType::VAR) == unordered_set<string>({ "x", "y" }));
+		REQUIRE(loaded->getMapResultsOfRS(RelationshipType::NEXT, make_shared<Declaration>(EntityType::WHILE, "w"),
+			make_shared<Declaration>(EntityType::ASSIGN, "a")) == unordered_map<string, unordered_set<string>>({ { "2", { "3" } } }));
+	}
+	MorselExecutor::setThreadCount(thread::hardware_concurrency());
+}
+
+TEST_CASE("PKB loadRelationship keeps the first follower and parent of a statement") {
+	shared_ptr<PKB> pkb = makePKB();
+	REQUIRE(pkb->insertFollow(1, 2));
+	REQUIRE(pkb->loadRelationship(RelationshipType::FOLLOWS, { { 1, 3 }, { 3, 5 }, { 3, 4 }, { 3, 4 } }) == 1);
+	REQUIRE(pkb->loadRelationship(RelationshipType::PARENT, { { 2, 4 }, { 3, 4 }, { 4, 3 } }) == 1);
+	REQUIRE(pkb->loadRelationship(RelationshipType::CALLS, { { 1, 2 } }) == 0);
+	REQUIRE(pkb->loadRelationship(RelationshipType::MODIFIES, { { 1, "x" }, { 0, "y" } }) == 1);
+
+	REQUIRE(getPairs(pkb, RelationshipType::FOLLOWS) ==
+		unordered_map<string, unordered_set<string>>({ { "1", { "2" } }, { "3", { "4" } } }));
+	REQUIRE(getPairs(pkb, RelationshipType::PARENT) ==
+		unordered_map<string, unordered_set<string>>({ { "2", { "4" } } }));
+}
@@ -0,0 +1,130 @@
+#include "PipelinedQueryEvaluator.h"
+#include "SingleRowOperator.h"
+#include "ClauseJoinOperator.h"
+#include "ProjectOperator.h"
+#include "RelationshipClause.h"
+#include "WithClause.h"
+#include "Declaration.h"
+#include "StmtNum.h"
+#include "QueryService.h"
+#include "catch.hpp"
+#include <algorithm>
+
+namespace {
+	vector<vector<string>> drain(shared_ptr<BindingOperator> pipeline, size_t batchSize) {
+		vector<vector<string>> rows;
+		vector<vector<string>> batch;
+		while (pipeline->next(batch)) {
+			REQUIRE(batch.size() <= batchSize);
+			rows.insert(rows.end(), batch.begin(), batch.end());
+		}
+		sort(rows.begin(), rows.end());
+		return rows;
+	}
+}
+
+TEST_CASE("ClauseJoinOperator joins clause results on bound synonyms") {
+	shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+	shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+	shared_ptr<Declaration> s3 = make_shared<Declaration>(EntityType::STMT, "s3");
+
+	// Follows(s1, s2) and Parent(s2, s3)
+	shared_ptr<OptionalClause> follows = make_shared<RelationshipClause>(RelationshipType::FOLLOWS, s1, s2);
+	follows->addMapResult({ { "1", { "2" } }, { "2", { "3" } }, { "3", { "6" } } });
+	shared_ptr<OptionalClause> parent = make_shared<RelationshipClause>(RelationshipType::PARENT, s2, s3);
+	parent->addMapResult({ { "3", { "4", "5" } }, { "6", { "7" } } });
+
+	SECTION("Scan and join by the left synonym") {
+		shared_ptr<BindingOperator> pipeline = make_shared<ClauseJoinOperator>(make_shared<SingleRowOperator>(), follows, 2);
+		pipeline = make_shared<ClauseJoinOperator>(pipeline, parent, 2);
+		REQUIRE(pipeline->getColumns() == vector<string>({ "s1", "s2", "s3" }));
+		REQUIRE(drain(pipeline, 2) == vector<vector<string>>({ { "2", "3", "4" }, { "2", "3", "5" }, { "3", "6", "7" } }));
+	}
+
+	SECTION("Join by the right synonym") {
+		shared_ptr<BindingOperator> pipeline = make_shared<ClauseJoinOperator>(make_shared<SingleRowOperator>(), parent, 1);
+		pipeline = make_shared<ClauseJoinOperator>(pipeline, follows, 1);
+		REQUIRE(pipeline->getColumns() == vector<string>({ "s2", "s3", "s1" }));
+		REQUIRE(drain(pipeline, 1) == vector<vector<string>>({ { "3", "4", "2" }, { "3", "5", "2" }, { "6", "7", "3" } }));
+	}
+
+	SECTION("Filter by set and boolean clauses") {
+		shared_ptr<OptionalClause> with = make_shared<WithClause>(s3, make_shared<StmtNum>(5));
+		with->addSetResult({ "5" });
+		shared_ptr<OptionalClause> next = make_shared<RelationshipClause>(RelationshipType::NEXT, make_shared<StmtNum>(1), make_shared<StmtNum>(2));
+		next->setBoolResult(true);
+
+		shared_ptr<BindingOperator> pipeline = make_shared<ClauseJoinOperator>(make_shared<SingleRowOperator>(), follows, 4);
+		pipeline = make_shared<ClauseJoinOperator>(pipeline, parent, 4);
+		pipeline = make_shared<ClauseJoinOperator>(pipeline, with, 4);
+		pipeline = make_shared<ClauseJoinOperator>(pipeline, next, 4);
+		REQUIRE(drain(pipeline, 4) == vector<vector<string>>({ { "2", "3", "5" } }));
+
+		pipeline = make_shared<ProjectOperator>(pipeline, vector<string>({ "s2", "s1", "s2" }), 4);
+		REQUIRE(pipeline->getColumns() == vector<string>({ "s2", "s1" }));
+	}
+
+	SECTION("Cartesian product of unrelated clauses and distinct projection") {
+		shared_ptr<BindingOperator> pipeline = make_shared<ClauseJoinOperator>(make_shared<SingleRowOperator>(), follows, 3);
+		pipeline = make_shared<ClauseJoinOperator>(pipeline, make_shared<RelationshipClause>(*dynamic_pointer_cast<RelationshipClause>(parent)), 3);
+		pipeline = make_shared<ProjectOperator>(pipeline, vector<string>({ "s3" }), 3);
+		REQUIRE(drain(pipeline, 3 + 3) == vector<vector<string>>({ { "4" }, { "5" }, { "7" } }));
+	}
+}
+
+TEST_CASE("PipelinedQueryEvaluator gives the same answers as QueryEvaluator") {
+	// procedure main { 1. x = y; 2. while (x) { 3. x = x + 1; 4. print x; } 5. y = x; }
+	shared_ptr<PKB> pkb = make_shared<PKB>(5);
+	pkb->insertProcedure("main");
+	pkb->insertVariable("x");
+	pkb->insertVariable("y");
+	pkb->setStatementType(1, EntityType::ASSIGN);
+	pkb->setStatementType(2, EntityType::WHILE);
+	pkb->setStatementType(3, EntityType::ASSIGN);
+	pkb->setStatementType(4, EntityType::PRINT);
+	pkb->setStatementType(5, EntityType::ASSIGN);
+	pkb->insertUsedName(4, "x");
+	pkb->insertFollow(1, 2);
+	pkb->insertFollow(2, 5);
+	pkb->insertFollow(3, 4);
+	pkb->insertParent(2, 3);
+	pkb->insertParent(2, 4);
+	pkb->insertModifies(1, "x");
+	pkb->insertModifies(2, "x");
+	pkb->insertModifies(3, "x");
+	pkb->insertModifies(5, "y");
+	pkb->insertUses(1, "y");
+	pkb->insertUses(2, "x");
+	pkb->insertUses(3, "x");
+	pkb->insertUses(4, "x");
+	pkb->insertUses(5, "x");
+	pkb->init();
+
+	vector<string> queries = {
+		"stmt s; Select s such that Follows(s, _)",
+		"stmt s1, s2; variable v; Select <s1, v> such that Parent(s1, s2) and Uses(s2, v)",
+		"assign a; variable v; Select v such that Modifies(a, v) and Uses(a, v)",
+		"stmt s; assign a; Select BOOLEAN such that Follows(s, a) and Parent(s, _)",
+		"stmt s; assign a; Select a such that Follows(s, a) and Parent(s, _)",
+		"stmt s1, s2; print p; Select p.varName such that Follows(s1, s2)",
+		"assign a; Select a such that Modifies(a, \"z\")",
+		"variable v1, v2; stmt s; Select v1 such that Uses(s, v1) and Modifies(s, v2) with v1.varName = v2.varName",
+	};
+
+	QueryService service;
+	service.setPKB(pkb);
+	QueryService pipelinedService;
+	pipelinedService.setPKB(pkb);
+	pipelinedService.setPipelined(true);
+	for (const string& query : queries) {
+		list<string> expected;
+		list<string> actual;
+		string errorMessage;
+		service.evaluate(query, expected, errorMessage);
+		pipelinedService.evaluate(query, actual, errorMessage);
+		expected.sort();
+		actual.sort();
+		INFO(query);
+		REQUIRE(actual == expected);
+	}
+}
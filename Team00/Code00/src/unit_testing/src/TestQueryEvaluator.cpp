@@ -4,6 +4,7 @@
  #include "Query.h"
  #include "TestResultsTableUtil.h"
  #include "PKBStub.h"
+ #include "PKB.h"
  #include "catch.hpp"
  #include <iostream>
 
@@ -3782,3 +3783,105 @@
  	}
 	
  }
+
+ TEST_CASE("Evaluating query in existential mode") {
+ 	shared_ptr<QueryInterface> query = dynamic_pointer_cast<QueryInterface>(make_shared<Query>());
+ 	shared_ptr<Declaration> assign = make_shared<Declaration>(EntityType::ASSIGN, "a");
+ 	shared_ptr<Declaration> stmt = make_shared<Declaration>(EntityType::STMT, "s");
+ 	shared_ptr<Declaration> stmt1 = make_shared<Declaration>(EntityType::STMT, "s1");
+ 	shared_ptr<Declaration> stmt2 = make_shared<Declaration>(EntityType::STMT, "s2");
+ 	query->addDeclarationToSelectClause(assign);
+
+ 	// Select a such that Follows(s, a) and Parent(s1, s2) and Follows(s2, s1)
+ 	query->addRelationshipClause(RelationshipType::FOLLOWS, stmt, assign);
+ 	query->addRelationshipClause(RelationshipType::PARENT, stmt1, stmt2);
+ 	query->addRelationshipClause(RelationshipType::FOLLOWS, stmt2, stmt1);
+
+ 	shared_ptr<PKBStub> pkb = make_shared<PKBStub>();
+ 	pkb->addMapResult({ { "1", {"2"} }, { "2", {"3"} } });
+ 	pkb->addMapResult({ { "4", {"5", "6"} }, { "7", {"8"} } });
+
+ 	SECTION("group without selected synonym has a witness, evaluates to projected group only") {
+ 		pkb->addMapResult({ { "6", {"4"} } });
+ 		unordered_map<string, int> expectedMap = { {"s", 0}, {"a", 1} };
+ 		vector<vector<string>> expectedTable = { {"1", "2"}, {"2", "3"} };
+
+ 		QueryEvaluator qe = QueryEvaluator(query, pkb);
+ 		qe.setExistentialMode(true);
+ 		shared_ptr<ResultsTable> resultsTable = qe.evaluate();
+ 		REQUIRE(!resultsTable->isNoResult());
+ 		TestResultsTableUtil::checkMap(resultsTable->getSynonymIndexMap(), expectedMap);
+ 		vector<vector<string>> actualTable = resultsTable->getTableValues();
+ 		sort(actualTable.begin(), actualTable.end());
+ 		REQUIRE(actualTable == expectedTable);
+ 	}
+
+ 	SECTION("group without selected synonym has no witness, evaluates to empty results") {
+ 		pkb->addMapResult({ { "5", {"7"} } });
+
+ 		QueryEvaluator qe = QueryEvaluator(query, pkb);
+ 		qe.setExistentialMode(true);
+ 		shared_ptr<ResultsTable> resultsTable = qe.evaluate();
+ 		REQUIRE(resultsTable->isNoResult());
+ 	}
+ }
+
+ namespace {
+ 	// counts the whole relations read from the PKB
+ 	class CountingPKB : public PKB {
+ 	public:
+ 		int mapResultsCount = 0;
+
+ 		CountingPKB(int n) : PKB(n) {}
+
+ 		unordered_map<string, unordered_set<string>> getMapResultsOfRS(const RelationshipType& type,
+ 			shared_ptr<QueryInput> input1, shared_ptr<QueryInput> input2) override {
+ 			mapResultsCount++;
+ 			return PKB::getMapResultsOfRS(type, input1, input2);
+ 		}
+ 	};
+ }
+
+ TEST_CASE("Evaluating query with a large relation looked up per value") {
+ 	shared_ptr<CountingPKB> pkb = make_shared<CountingPKB>(40);
+ 	for (int i = 1; i <= 40; i++) {
+ 		pkb->setStatementType(i, EntityType::ASSIGN);
+ 	}
+ 	for (int i = 1; i < 40; i++) {
+ 		pkb->insertFollow(i, i + 1);
+ 		for (int j = i + 1; j <= 40; j++) {
+ 			pkb->insertNextStar(i, j);
+ 		}
+ 	}
+ 	pkb->init();
+
+ 	shared_ptr<QueryInterface> query = dynamic_pointer_cast<QueryInterface>(make_shared<Query>());
+ 	shared_ptr<Declaration> stmt1 = make_shared<Declaration>(EntityType::STMT, "s1");
+ 	shared_ptr<Declaration> stmt2 = make_shared<Declaration>(EntityType::STMT, "s2");
+ 	query->addDeclarationToSelectClause(stmt2);
+
+ 	SECTION("few values of the joined synonym are looked up one by one") {
+ 		// Select s2 such that Follows(s1, 38) and Next*(s1, s2)
+ 		query->addRelationshipClause(RelationshipType::FOLLOWS, stmt1, make_shared<StmtNum>(38));
+ 		query->addRelationshipClause(RelationshipType::NEXT_T, stmt1, stmt2);
+ 		unordered_map<string, int> expectedMap = { {"s1", 0}, {"s2", 1} };
+ 		vector<vector<string>> expectedTable = { {"37", "38"}, {"37", "39"}, {"37", "40"} };
+
+ 		shared_ptr<ResultsTable> resultsTable = QueryEvaluator(query, pkb).evaluate();
+ 		REQUIRE(pkb->mapResultsCount == 0);
+ 		TestResultsTableUtil::checkMap(resultsTable->getSynonymIndexMap(), expectedMap);
+ 		vector<vector<string>> actualTable = resultsTable->getTableValues();
+ 		sort(actualTable.begin(), actualTable.end());
+ 		REQUIRE(actualTable == expectedTable);
+ 	}
+
+ 	SECTION("many values of the joined synonym read the whole relation") {
+ 		// Select s2 such that Follows(s1, _) and Next*(s1, s2)
+ 		query->addRelationshipClause(RelationshipType::FOLLOWS, stmt1, make_shared<Any>());
+ 		query->addRelationshipClause(RelationshipType::NEXT_T, stmt1, stmt2);
+
+ 		shared_ptr<ResultsTable> resultsTable = QueryEvaluator(query, pkb).evaluate();
+ 		REQUIRE(pkb->mapResultsCount == 1);
+ 		REQUIRE(resultsTable->getTableSize() == 780);
+ 	}
+ }
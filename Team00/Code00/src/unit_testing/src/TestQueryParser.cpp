@@ -2,6 +2,7 @@
 #include "QueryParser.h"
 #include "TokenizerStub.h"
 #include "Query.h"
+#include "SyntacticException.h"
 #include <vector>
 #include <memory>
 
@@ -392,3 +393,17 @@ TEST_CASE("Test Query with Select Tuple and With Clause")
     REQUIRE(withClRightQueryInput->getQueryInputType() == QueryInputType::IDENT);
     REQUIRE(withClRightQueryInput->getValue() == "var1");
 }
+
+// ----------------- Incomplete queries -----------------
+
+TEST_CASE("Test Query ending in the middle of a clause")
+{
+	auto query = std::make_shared<Query>();
+	std::vector<Token> tokens{ Token(TokenTypes::DesignEntity, "stmt"), Token(TokenTypes::Identifier, "s"), Token(TokenTypes::Semicolon, ";"),
+			Token(TokenTypes::Select, "Select"), Token(TokenTypes::Identifier, "s"), Token(TokenTypes::Such, "such"),
+			Token(TokenTypes::That, "that")
+	};
+	auto tokenizer = std::make_shared<TokenizerStub>(TokenizerStub(tokens));
+	QueryParser queryParser = QueryParser{ tokenizer, query };
+	REQUIRE_THROWS_AS(queryParser.parse(), SyntacticException);
+}
@@ -0,0 +1,72 @@
+#include "QueryPlanCache.h"
+#include "catch.hpp"
+
+TEST_CASE("QueryPlanCache normalizes query text") {
+	SECTION("Whitespace and synonym names do not matter") {
+		string key = QueryPlanCache::normalize("stmt s; assign a; Select s such that Follows*(s, a)");
+		REQUIRE(key == QueryPlanCache::normalize("stmt   x;assign y;\nSelect x such that Follows* ( x,y )"));
+		REQUIRE(key != QueryPlanCache::normalize("stmt s; assign a; Select a such that Follows*(s, a)"));
+		REQUIRE(key != QueryPlanCache::normalize("stmt s; assign a; Select s such that Follows(s, a)"));
+	}
+
+	SECTION("Quoted names and attribute names are kept") {
+		string key = QueryPlanCache::normalize("variable v; procedure p; Select p such that Uses(p, \"v\") with v.varName = \"x\"");
+		REQUIRE(key == QueryPlanCache::normalize("variable w; procedure q; Select q such that Uses(q, \"v\") with w.varName = \"x\""));
+		REQUIRE(key != QueryPlanCache::normalize("variable w; procedure q; Select q such that Uses(q, \"w\") with w.varName = \"x\""));
+		REQUIRE(key.find("varName") != string::npos);
+	}
+
+	SECTION("Non-ASCII text inside quotes is kept") {
+		string key = QueryPlanCache::normalize("assign a; Select a pattern a(_, \"x\xC3\xA9\")");
+		REQUIRE(key == QueryPlanCache::normalize("assign b; Select b pattern b(_, \"x\xC3\xA9\")"));
+		REQUIRE(key.find("\xC3\xA9") != string::npos);
+	}
+
+	SECTION("Synonyms named after keywords are kept") {
+		string key = QueryPlanCache::normalize("stmt Select; Select Select");
+		REQUIRE(key == "stmt Select;Select Select");
+		REQUIRE(QueryPlanCache::normalize("prog_line n; Select n") == "prog_line $0;Select $0");
+	}
+
+	SECTION("Queries that cannot be normalized are not cached") {
+		REQUIRE(QueryPlanCache::normalize("stmt $0; Select $0") == "");
+		REQUIRE(QueryPlanCache::normalize("stmt s Select s") == "");
+	}
+}
+
+TEST_CASE("QueryPlanCache reuses plans of equivalent queries") {
+	QueryPlanCache cache(2);
+
+	QueryPlan first = cache.getPlan("stmt s; Select s such that Parent(s, 3)");
+	QueryPlan second = cache.getPlan("stmt t;  Select t such that Parent(t,3)");
+	REQUIRE(first.status == QueryPlanStatus::VALID);
+	REQUIRE(second.status == QueryPlanStatus::VALID);
+	REQUIRE(cache.getHitCount() == 1);
+	REQUIRE(cache.getMissCount() == 1);
+	REQUIRE(cache.getSize() == 1);
+
+	// every plan holds its own clauses so results are never shared between evaluations
+	REQUIRE(first.query != second.query);
+	REQUIRE(first.query->getOptionalClauses().size() == 1);
+	REQUIRE(first.query->getOptionalClauses().at(0) != second.query->getOptionalClauses().at(0));
+
+	SECTION("Errors are cached") {
+		QueryPlan syntaxError = cache.getPlan("stmt s; Select s such that Parent(s, 3");
+		REQUIRE(syntaxError.status == QueryPlanStatus::SYNTAX_ERROR);
+		QueryPlan semanticError = cache.getPlan("stmt s; Select BOOLEAN such that Parent(s, v)");
+		REQUIRE(semanticError.status == QueryPlanStatus::SEMANTIC_ERROR);
+		REQUIRE(semanticError.isBooleanQuery);
+		REQUIRE(cache.getSize() == 2);
+		REQUIRE(cache.getPlan("stmt s; Select BOOLEAN such that Parent(s, v)").status == QueryPlanStatus::SEMANTIC_ERROR);
+		REQUIRE(cache.getHitCount() == 2);
+	}
+
+	SECTION("Least recently used plan is evicted") {
+		cache.getPlan("assign a; Select a");
+		cache.getPlan("while w; Select w");
+		REQUIRE(cache.getSize() == 2);
+		cache.getPlan("stmt s; Select s such that Parent(s, 3)");
+		REQUIRE(cache.getHitCount() == 1);
+		REQUIRE(cache.getMissCount() == 4);
+	}
+}
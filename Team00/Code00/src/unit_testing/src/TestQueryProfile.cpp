@@ -0,0 +1,88 @@
+#include "QueryProfile.h"
+#include "QueryService.h"
+#include "ProgramFixture.h"
+#include "catch.hpp"
+#include <sstream>
+
+namespace {
+	const vector<string> PROFILED_PROGRAM = {
+		"procedure main {",
+		"	x = 1;",
+		"	y = x + 2;",
+		"	while (x > 0) {",
+		"		x = x - 1;",
+		"		print y;",
+		"	}",
+		"	call other;",
+		"}",
+		"procedure other {",
+		"	read z;",
+		"}",
+	};
+}
+
+TEST_CASE("QueryProfile records the fetch and merge of each clause") {
+	QueryService service;
+	service.setPKB(extractProgram(PROFILED_PROGRAM));
+
+	list<string> results;
+	string errorMessage;
+	shared_ptr<QueryProfile> profile = make_shared<QueryProfile>();
+	QueryPlanStatus status = service.evaluate("assign a; variable v; stmt s; Select a such that Follows(s, a) pattern a(v, _\"x\"_)",
+		results, errorMessage, profile);
+	REQUIRE(status == QueryPlanStatus::VALID);
+	REQUIRE(results == list<string>({ "2" }));
+
+	const vector<ClauseProfile>& clauses = profile->getClauses();
+	REQUIRE(clauses.size() == 2);
+	vector<string> descriptions = { clauses[0].clause, clauses[1].clause };
+	REQUIRE(find(descriptions.begin(), descriptions.end(), "Follows(s, a)") != descriptions.end());
+	REQUIRE(find(descriptions.begin(), descriptions.end(), "pattern a(v, _\"x\"_)") != descriptions.end());
+
+	int scanCount = 0;
+	for (const ClauseProfile& clause : clauses) {
+		REQUIRE(clause.source == "pkb");
+		REQUIRE(clause.resultSize > 0);
+		REQUIRE(clause.fetchMillis >= 0);
+		if (clause.joinAlgorithm == "scan") {
+			scanCount++;
+			REQUIRE(clause.inputRows == 0);
+			REQUIRE(clause.outputRows == clause.resultSize);
+		}
+		else {
+			REQUIRE(clause.joinAlgorithm == "nested-loop join on a");
+			REQUIRE(clause.outputRows == 1);
+		}
+	}
+	REQUIRE(scanCount == 1);
+	REQUIRE(profile->getResultCount() == 1);
+	REQUIRE(profile->getTotalMillis() >= profile->getProjectionMillis());
+
+	ostringstream json;
+	profile->writeJson(json);
+	REQUIRE(json.str().find("{\"clauses\":[{\"clause\":") == 0);
+	REQUIRE(json.str().find("\"joinAlgorithm\":\"nested-loop join on a\"") != string::npos);
+	REQUIRE(json.str().find("\\\"x\\\"") != string::npos);
+
+	ostringstream text;
+	profile->writeText(text);
+	REQUIRE(text.str().find("Follows(s, a)  (pkb ") != string::npos);
+	REQUIRE(text.str().find("projection  (1 results ") != string::npos);
+
+	SECTION("Clauses answered from the cache and groups checked for a witness") {
+		results.clear();
+		profile = make_shared<QueryProfile>();
+		service.evaluate("stmt s; assign a; call c; Select BOOLEAN such that Follows(s, a) with c.procName = \"other\"",
+			results, errorMessage, profile);
+		REQUIRE(results == list<string>({ "TRUE" }));
+		REQUIRE(profile->getClauses().size() == 2);
+		for (const ClauseProfile& clause : profile->getClauses()) {
+			REQUIRE(clause.source == (clause.clause == "Follows(s, a)" ? "cache" : "pkb"));
+			REQUIRE(clause.joinAlgorithm.empty());
+		}
+		REQUIRE(profile->getClauses()[1].clause == "with c.procName = \"other\"");
+		REQUIRE(profile->getGroups().size() == 2);
+		REQUIRE(profile->getGroups()[0].step == "existential check");
+		REQUIRE(profile->getGroups()[0].outputRows == 1);
+	}
+}
@@ -0,0 +1,67 @@
+#include "Query.h"
+#include "QueryRewriter.h"
+#include "StmtNum.h"
+#include "Ident.h"
+#include "Any.h"
+#include "catch.hpp"
+
+TEST_CASE("QueryRewriter propagates with clause constants") {
+	shared_ptr<Query> query = make_shared<Query>();
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	shared_ptr<Declaration> s = make_shared<Declaration>(EntityType::STMT, "s");
+	shared_ptr<Declaration> v = make_shared<Declaration>(EntityType::VAR, "v");
+	shared_ptr<Declaration> p = make_shared<Declaration>(EntityType::PROC, "p");
+	query->addDeclarationToSelectClause(a);
+
+	SECTION("Statement synonym becomes a statement number") {
+		// Select a such that Affects*(a, s) with s.stmt# = 12
+		query->addRelationshipClause(RelationshipType::AFFECTS_T, a, s);
+		query->addWithClause(s, make_shared<StmtNum>(12));
+		QueryRewriter::propagateConstants(query);
+
+		vector<shared_ptr<OptionalClause>> clauses = query->getOptionalClauses();
+		REQUIRE(clauses.size() == 2);
+		shared_ptr<RelationshipClause> relationshipClause = dynamic_pointer_cast<RelationshipClause>(clauses.at(0));
+		REQUIRE(relationshipClause->getRelationshipType() == RelationshipType::AFFECTS_T);
+		REQUIRE(relationshipClause->getLeftInput() == a);
+		REQUIRE(relationshipClause->getRightInput()->getQueryInputType() == QueryInputType::STMT_NUM);
+		REQUIRE(relationshipClause->getRightInput()->getValue() == "12");
+		REQUIRE(clauses.at(1)->getClauseType() == ClauseType::WITH);
+	}
+
+	SECTION("Procedure and variable synonyms become identifiers") {
+		// Select a such that Modifies(p, v) pattern a(v, _) with "main" = p.procName and v.varName = "x"
+		query->addRelationshipClause(RelationshipType::MODIFIES, p, v);
+		query->addAssignPatternClause(a, v, make_shared<Expression>("_"));
+		query->addWithClause(make_shared<Ident>("main"), p);
+		query->addWithClause(v, make_shared<Ident>("x"));
+		QueryRewriter::propagateConstants(query);
+
+		vector<shared_ptr<OptionalClause>> clauses = query->getOptionalClauses();
+		REQUIRE(clauses.size() == 4);
+		REQUIRE(clauses.at(0)->getLeftInput()->getQueryInputType() == QueryInputType::IDENT);
+		REQUIRE(clauses.at(0)->getLeftInput()->getValue() == "main");
+		REQUIRE(clauses.at(0)->getRightInput()->getQueryInputType() == QueryInputType::IDENT);
+		REQUIRE(clauses.at(0)->getRightInput()->getValue() == "x");
+
+		shared_ptr<PatternClause> patternClause = dynamic_pointer_cast<PatternClause>(clauses.at(1));
+		REQUIRE(patternClause->getSynonym() == a);
+		REQUIRE(patternClause->getQueryInput()->getValue() == "x");
+		REQUIRE(patternClause->getExpression() != nullptr);
+	}
+
+	SECTION("Attributes and conflicting constants are not propagated") {
+		shared_ptr<Declaration> c = make_shared<Declaration>(EntityType::CALL, "c");
+		c->setIsAttribute();
+		query->addRelationshipClause(RelationshipType::FOLLOWS, c, s);
+		query->addWithClause(c, make_shared<Ident>("main"));
+		query->addWithClause(s, make_shared<StmtNum>(3));
+		query->addWithClause(s, make_shared<StmtNum>(4));
+		QueryRewriter::propagateConstants(query);
+
+		vector<shared_ptr<OptionalClause>> clauses = query->getOptionalClauses();
+		REQUIRE(clauses.size() == 4);
+		REQUIRE(clauses.at(0)->getLeftInput() == c);
+		REQUIRE(clauses.at(0)->getRightInput() == s);
+	}
+}
@@ -0,0 +1,140 @@
+#include "QueryService.h"
+#include "ThreadPool.h"
+#include "catch.hpp"
+
+namespace {
+	// procedure main { 1. x = y; 2. while (x) { 3. print x; } 4. read y; }
+	shared_ptr<PKB> buildPKB() {
+		shared_ptr<PKB> pkb = make_shared<PKB>(4);
+		pkb->insertProcedure("main");
+		pkb->insertVariable("x");
+		pkb->insertVariable("y");
+		pkb->setStatementType(1, EntityType::ASSIGN);
+		pkb->setStatementType(2, EntityType::WHILE);
+		pkb->setStatementType(3, EntityType::PRINT);
+		pkb->setStatementType(4, EntityType::READ);
+		pkb->insertUsedName(3, "x");
+		pkb->insertUsedName(4, "y");
+		pkb->insertFollow(1, 2);
+		pkb->insertFollow(2, 4);
+		pkb->insertFollowStar(1, 2);
+		pkb->insertFollowStar(1, 4);
+		pkb->insertFollowStar(2, 4);
+		pkb->insertParent(2, 3);
+		pkb->insertParentStar(2, 3);
+		pkb->insertModifies(1, "x");
+		pkb->insertModifies(4, "y");
+		pkb->insertUses(1, "y");
+		pkb->insertUses(2, "x");
+		pkb->insertUses(3, "x");
+		pkb->init();
+		return pkb;
+	}
+}
+
+TEST_CASE("QueryService answers queries on the loaded program") {
+	QueryService service;
+	service.setPKB(buildPKB());
+	list<string> results;
+	string errorMessage;
+
+	SECTION("Valid query") {
+		REQUIRE(service.evaluate("stmt s; Select s such that Follows*(1, s)", results, errorMessage) == QueryPlanStatus::VALID);
+		results.sort();
+		REQUIRE(results == list<string>({ "2", "4" }));
+	}
+
+	SECTION("Invalid queries") {
+		REQUIRE(service.evaluate("stmt s; Select s such that", results, errorMessage) == QueryPlanStatus::SYNTAX_ERROR);
+		REQUIRE(results.empty());
+		REQUIRE(service.evaluate("stmt s; Select BOOLEAN such that Follows(s, v)", results, errorMessage) == QueryPlanStatus::SEMANTIC_ERROR);
+		REQUIRE(results == list<string>({ "FALSE" }));
+	}
+
+	SECTION("Missing source file") {
+		REQUIRE_FALSE(service.loadSource("missing_source_file.txt", errorMessage));
+		REQUIRE(errorMessage.find("missing_source_file.txt") != string::npos);
+	}
+}
+
+TEST_CASE("QueryService answers queries concurrently") {
+	QueryService service;
+	service.setPKB(buildPKB());
+	vector<string> queries = {
+		"stmt s; Select s such that Follows*(1, s)",
+		"stmt s; variable v; Select <s, v> such that Uses(s, v)",
+		"while w; stmt s; Select s such that Parent(w, s)",
+		"read r; Select r.varName",
+		"assign a; Select BOOLEAN such that Modifies(a, \"x\")",
+	};
+
+	vector<list<string>> expected(queries.size());
+	string errorMessage;
+	for (size_t i = 0; i < queries.size(); i++) {
+		service.evaluate(queries[i], expected[i], errorMessage);
+		expected[i].sort();
+	}
+
+	vector<list<string>> actual(queries.size() * 20);
+	{
+		ThreadPool pool(4);
+		for (size_t i = 0; i < actual.size(); i++) {
+			pool.submit([&service, &queries, &actual, i]() {
+				string error;
+				service.evaluate(queries[i % queries.size()], actual[i], error);
+				actual[i].sort();
+			});
+		}
+		pool.waitAll();
+	}
+
+	for (size_t i = 0; i < actual.size(); i++) {
+		REQUIRE(actual[i] == expected[i % queries.size()]);
+	}
+	REQUIRE(service.getPlanCache().getSize() == queries.size());
+}
+
+TEST_CASE("QueryService evaluates a batch of queries") {
+	QueryService service;
+	service.setPKB(buildPKB());
+	vector<string> queries = {
+		"stmt s; variable v; Select s such that Uses(s, v)",
+		"stmt s1; variable v1; Select v1 such that Uses(s1, v1)",
+		"stmt s; Select s such that Follows*(1, s)",
+		"stmt s2; variable x; Select BOOLEAN such that Uses(s2, x)",
+		"stmt s; Select s such that",
+		"stmt s; Select BOOLEAN such that Follows(s, v)",
+		"stmt s; variable v; Select s such that Uses(s, v)",
+	};
+
+	vector<QueryResponse> expected(queries.size());
+	for (size_t i = 0; i < queries.size(); i++) {
+		QueryService singleService;
+		singleService.setPKB(service.getPKB());
+		expected[i].status = singleService.evaluate(queries[i], expected[i].results, expected[i].errorMessage);
+		expected[i].results.sort();
+	}
+
+	vector<QueryResponse> responses;
+	BatchStatistics statistics = service.evaluateBatch(queries, responses);
+	REQUIRE(responses.size() == queries.size());
+	for (size_t i = 0; i < queries.size(); i++) {
+		responses[i].results.sort();
+		REQUIRE(responses[i].results == expected[i].results);
+		REQUIRE(responses[i].status == expected[i].status);
+		REQUIRE(responses[i].errorMessage == expected[i].errorMessage);
+	}
+	REQUIRE(responses[4].status == QueryPlanStatus::SYNTAX_ERROR);
+	REQUIRE_FALSE(responses[4].errorMessage.empty());
+	REQUIRE(responses[5].status == QueryPlanStatus::SEMANTIC_ERROR);
+	REQUIRE(responses[5].results == list<string>({ "FALSE" }));
+
+	REQUIRE(statistics.queryCount == 7);
+	REQUIRE(statistics.validQueryCount == 5);
+	REQUIRE(statistics.clauseCount == 5);
+	REQUIRE(statistics.sharedClauseCount == 1); // Uses(s, v)
+	REQUIRE(statistics.reusedClauseCount == 3);
+	REQUIRE(statistics.sharedGroupCount == 1); // the group of Uses(s, v), selected in three queries
+	REQUIRE(statistics.reusedGroupCount == 2);
+	REQUIRE(statistics.getQueriesPerSecond() >= 0);
+}
@@ -634,3 +634,22 @@
 		TestResultsTableUtil::checkTable(actualTable, expectedTable);
  	}
  }
+
+ TEST_CASE("Projecting a results table to selected synonyms") {
+ 	shared_ptr<ResultsTable> resultsTable = make_shared<ResultsTable>();
+ 	resultsTable->setTable({ {"s", 0}, {"v", 1}, {"a", 2} }, { {"1", "x", "3"}, {"1", "y", "3"}, {"2", "x", "4"} });
+
+ 	SECTION("Projecting to a subset of columns removes duplicate rows") {
+ 		shared_ptr<ResultsTable> projectedTable = ResultUtil::getProjectedTable(resultsTable, { "a", "w", "s", "a" });
+ 		unordered_map<string, int> expectedIndexMap = { {"a", 0}, {"s", 1} };
+ 		vector<vector<string>> expectedTable = { {"3", "1"}, {"4", "2"} };
+ 		TestResultsTableUtil::checkMap(projectedTable->getSynonymIndexMap(), expectedIndexMap);
+ 		REQUIRE(projectedTable->getTableValues() == expectedTable);
+ 	}
+
+ 	SECTION("Projecting to no column keeps no synonym") {
+ 		shared_ptr<ResultsTable> projectedTable = ResultUtil::getProjectedTable(resultsTable, { "w" });
+ 		REQUIRE(projectedTable->getSynonyms().empty());
+ 		REQUIRE(projectedTable->getTableSize() == 1);
+ 	}
+ }
@@ -714,4 +714,59 @@ TEST_CASE("Projecting list of final results from select clause without optonal c
 		ResultsProjector::projectResults(resultsTable, selectClause, pkb, actualList);
 		TestResultsTableUtil::checkList(actualList, expectedList);
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Projecting list of final results from independent group results") {
+	string stmtSynonym = "s";
+	string assignSynonym = "a";
+	string printSynonym = "pn";
+	string varSynonym = "v";
+
+	shared_ptr<PKBStub> pkb = make_shared<PKBStub>();
+	shared_ptr<SelectClause> selectClause = make_shared<SelectClause>();
+	shared_ptr<Declaration> stmtDeclaration = make_shared<Declaration>(EntityType::STMT, stmtSynonym);
+	shared_ptr<Declaration> assignDeclaration = make_shared<Declaration>(EntityType::ASSIGN, assignSynonym);
+	shared_ptr<Declaration> printDeclaration = make_shared<Declaration>(EntityType::PRINT, printSynonym);
+	printDeclaration->setIsAttribute();
+
+	shared_ptr<ResultsTable> stmtGroup = make_shared<ResultsTable>();
+	stmtGroup->setTable({ {stmtSynonym, 0} }, { {"1"}, {"2"} });
+	shared_ptr<ResultsTable> assignGroup = make_shared<ResultsTable>();
+	assignGroup->setTable({ {varSynonym, 0}, {assignSynonym, 1} }, { {"x", "3"}, {"y", "4"}, {"z", "4"} });
+
+	// Select BOOLEAN
+	SECTION("Select BOOLEAN with a group without results") {
+		shared_ptr<ResultsTable> noResults = make_shared<ResultsTable>();
+		noResults->setIsNoResult();
+		list<string> actualList;
+		ResultsProjector::projectResults({ stmtGroup, noResults }, selectClause, pkb, actualList);
+		REQUIRE(actualList == list<string>{ "FALSE" });
+	}
+
+	// Select <s, a>
+	SECTION("Select tuple across groups") {
+		selectClause->addDeclaration(stmtDeclaration);
+		selectClause->addDeclaration(assignDeclaration);
+
+		list<string> expectedList = { "1 3", "1 4", "2 3", "2 4" };
+		list<string> actualList;
+		ResultsProjector::projectResults({ stmtGroup, assignGroup }, selectClause, pkb, actualList);
+		REQUIRE(actualList.size() == expectedList.size());
+		TestResultsTableUtil::checkList(actualList, expectedList);
+	}
+
+	// Select <a, pn.varName, s>
+	SECTION("Select tuple with synonym in no group") {
+		selectClause->addDeclaration(assignDeclaration);
+		selectClause->addDeclaration(printDeclaration);
+		selectClause->addDeclaration(stmtDeclaration);
+		pkb->addSetResult({ "5" });
+		pkb->addEntityType(EntityType::PRINT);
+		pkb->addStringResult("x");
+
+		list<string> expectedList = { "3 x 1", "3 x 2", "4 x 1", "4 x 2" };
+		list<string> actualList;
+		ResultsProjector::projectResults({ stmtGroup, assignGroup }, selectClause, pkb, actualList);
+		REQUIRE(actualList.size() == expectedList.size());
+		TestResultsTableUtil::checkList(actualList, expectedList);
+	}
+}
@@ -1,4 +1,6 @@
 #include "ResultsTable.h"
+#include "RelationshipClause.h"
+#include "Declaration.h"
 #include "TestResultsTableUtil.h"
 #include "catch.hpp"
 
@@ -54,3 +56,27 @@ string assignSynonym = "a";
  	}
  }
 
+TEST_CASE("Results are moved through the evaluation pipeline instead of copied") {
+	SECTION("A results table takes the rows it is given and hands them out by reference") {
+		vector<vector<string>> values = { { "1", "a" }, { "2", "b" } };
+		const vector<string>* firstRow = values.data();
+
+		ResultsTable resultsTable;
+		resultsTable.setTable({ { "s", 0 }, { "v", 1 } }, move(values));
+		REQUIRE(resultsTable.getTableValues().data() == firstRow);
+		REQUIRE(&resultsTable.getTableValues() == &resultsTable.getTableValues());
+	}
+
+	SECTION("A clause gives up its results once they are taken") {
+		shared_ptr<Declaration> s1 = make_shared<Declaration>(EntityType::STMT, "s1");
+		shared_ptr<Declaration> s2 = make_shared<Declaration>(EntityType::STMT, "s2");
+		shared_ptr<OptionalClause> clause = make_shared<RelationshipClause>(RelationshipType::FOLLOWS, s1, s2);
+		clause->addMapResult({ { "1", { "2" } }, { "2", { "3" } } });
+
+		unordered_map<string, unordered_set<string>> expected = { { "1", { "2" } }, { "2", { "3" } } };
+		REQUIRE(clause->takeMapResult() == expected);
+		REQUIRE(clause->getMapResult().empty());
+		REQUIRE(clause->getResultSize() == 2);
+		REQUIRE(clause->getClauseResultType() == ClauseResultType::MAP);
+	}
+}
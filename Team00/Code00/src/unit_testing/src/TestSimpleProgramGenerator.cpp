@@ -0,0 +1,76 @@
+#include "SimpleProgramGenerator.h"
+#include "ProgramFixture.h"
+#include "QueryService.h"
+#include "catch.hpp"
+#include <sstream>
+
+TEST_CASE("SimpleProgramGenerator writes valid programs of the requested shape") {
+	GeneratorOptions options;
+	options.statementCount = 300;
+	options.procedureCount = 7;
+	options.loopDensity = 0.15;
+	options.branchDensity = 0.15;
+
+	for (CallGraphShape shape : { CallGraphShape::CHAIN, CallGraphShape::FAN_OUT, CallGraphShape::DIAMOND }) {
+		options.callGraphShape = shape;
+		SimpleProgramGenerator generator(options);
+		shared_ptr<PKB> pkb = extractProgram(generator.generateProgram());
+		REQUIRE(generator.getStatementCount() == 300);
+		REQUIRE(pkb->getEntities(EntityType::STMT).size() == 300);
+		REQUIRE(pkb->getEntities(EntityType::PROC).size() == 7);
+
+		unordered_map<string, unordered_set<string>> expectedCalls;
+		for (int procedure = 0; procedure < 7; procedure++) {
+			for (int callee : SimpleProgramGenerator::getCallees(shape, procedure, 7)) {
+				expectedCalls[SimpleProgramGenerator::getProcedureName(procedure)].insert(SimpleProgramGenerator::getProcedureName(callee));
+			}
+		}
+		shared_ptr<QueryInput> caller = make_shared<Declaration>(EntityType::PROC, "p");
+		shared_ptr<QueryInput> callee = make_shared<Declaration>(EntityType::PROC, "q");
+		REQUIRE(pkb->getMapResultsOfRS(CALLS, caller, callee) == expectedCalls);
+	}
+
+	SECTION("The same options give the same program") {
+		REQUIRE(SimpleProgramGenerator(options).generateProgram() == SimpleProgramGenerator(options).generateProgram());
+		GeneratorOptions otherOptions = options;
+		otherOptions.seed = 2;
+		REQUIRE(SimpleProgramGenerator(options).generateProgram() != SimpleProgramGenerator(otherOptions).generateProgram());
+	}
+
+	SECTION("Nesting stops at the maximum depth") {
+		options.maxNestingDepth = 1;
+		options.loopDensity = 0.5;
+		for (const string& line : SimpleProgramGenerator(options).generateProgram()) {
+			REQUIRE(line.compare(0, 3, "\t\t\t") != 0);
+		}
+	}
+}
+
+TEST_CASE("SimpleProgramGenerator writes valid stress queries") {
+	GeneratorOptions options;
+	options.statementCount = 60;
+	options.procedureCount = 3;
+	options.queryCount = 12;
+	SimpleProgramGenerator generator(options);
+
+	QueryService service;
+	service.setPKB(extractProgram(generator.generateProgram()));
+	ostringstream out;
+	generator.writeQueries(out, generator.getStatementCount());
+
+	istringstream in(out.str());
+	vector<string> lines;
+	string line;
+	while (getline(in, line)) {
+		lines.push_back(line);
+	}
+	REQUIRE(lines.size() == 12 * 5);
+	for (size_t i = 0; i < lines.size(); i += 5) {
+		list<string> results;
+		string errorMessage;
+		INFO(lines[i + 1] + " " + lines[i + 2]);
+		QueryPlanStatus status = service.evaluate(lines[i + 1] + " " + lines[i + 2], results, errorMessage);
+		INFO(errorMessage);
+		REQUIRE(status == QueryPlanStatus::VALID);
+	}
+}
@@ -0,0 +1,35 @@
+#include "StatementBitmap.h"
+#include "catch.hpp"
+
+TEST_CASE("StatementBitmap holds statement numbers as bits") {
+	StatementBitmap bitmap(100);
+	REQUIRE(bitmap.isEmpty());
+	bitmap.insert(1);
+	bitmap.insert(64);
+	bitmap.insert(99);
+	bitmap.insert(1);
+
+	REQUIRE(bitmap.contains(1));
+	REQUIRE(bitmap.contains(64));
+	REQUIRE_FALSE(bitmap.contains(2));
+	REQUIRE_FALSE(bitmap.contains(-1));
+	REQUIRE_FALSE(bitmap.contains(1000));
+	REQUIRE(bitmap.count() == 3);
+	REQUIRE(bitmap.toStrings() == unordered_set<string>({ "1", "64", "99" }));
+
+	SECTION("Statement numbers past the size grow the bitmap") {
+		bitmap.insert(200);
+		REQUIRE(bitmap.contains(200));
+		REQUIRE(bitmap.count() == 4);
+	}
+
+	SECTION("Intersecting keeps the statement numbers of both") {
+		StatementBitmap other;
+		other.insert(64);
+		other.insert(65);
+		other.insert(150);
+		StatementBitmap intersection = bitmap.intersect(other);
+		REQUIRE(intersection.toStrings() == unordered_set<string>({ "64" }));
+		REQUIRE(other.intersect(StatementBitmap()).isEmpty());
+	}
+}
@@ -0,0 +1,76 @@
+#include "PKB.h"
+#include "StatisticsCatalog.h"
+#include "StmtNum.h"
+#include "Ident.h"
+#include "Any.h"
+
+#include "catch.hpp"
+using namespace std;
+
+TEST_CASE("StatisticsCatalog computeStatistics") {
+	unordered_map<string, unordered_set<string>> relation = {
+		{"1", {"2", "3", "4"}}, {"2", {"3"}}, {"5", {}}
+	};
+	unordered_map<string, unordered_set<string>> relationBy = {
+		{"2", {"1"}}, {"3", {"1", "2"}}, {"4", {"1"}}
+	};
+
+	RelationStatistics statistics = StatisticsCatalog::computeStatistics(relation, relationBy);
+	REQUIRE(statistics.pairCount == 4);
+	REQUIRE(statistics.distinctLeftCount == 2);
+	REQUIRE(statistics.distinctRightCount == 3);
+	REQUIRE(statistics.outDegreeHistogram == map<int, int>({ {1, 1}, {3, 1} }));
+	REQUIRE(statistics.inDegreeHistogram == map<int, int>({ {1, 2}, {2, 1} }));
+	REQUIRE(statistics.getAverageOutDegree() == 2);
+}
+
+TEST_CASE("StatisticsCatalog collectedByPKB") {
+	PKB pkb = PKB(6);
+	pkb.insertProcedure("main");
+	pkb.setStatementType(1, EntityType::ASSIGN);
+	pkb.setStatementType(2, EntityType::WHILE);
+	pkb.setStatementType(3, EntityType::ASSIGN);
+	pkb.setStatementType(4, EntityType::ASSIGN);
+	pkb.setStatementType(5, EntityType::PRINT);
+	pkb.setStatementType(6, EntityType::READ);
+	pkb.insertFollow(1, 2);
+	pkb.insertFollow(2, 5);
+	pkb.insertFollow(5, 6);
+	pkb.insertParent(2, 3);
+	pkb.insertParent(2, 4);
+	pkb.insertUses(1, "x");
+	pkb.insertUses(3, "x");
+	pkb.insertUses(5, "y");
+	pkb.insertProcUses("main", "x");
+	pkb.insertProcUses("main", "y");
+	pkb.init();
+
+	shared_ptr<StatisticsCatalog> statistics = pkb.getStatistics();
+	REQUIRE(statistics->getEntityCount(EntityType::STMT) == 6);
+	REQUIRE(statistics->getEntityCount(EntityType::ASSIGN) == 3);
+	REQUIRE(statistics->getEntityCount(EntityType::VAR) == 2);
+	REQUIRE(statistics->getEntityCount(EntityType::CALL) == 0);
+
+	const RelationStatistics& parent = statistics->getRelationStatistics(RelationshipType::PARENT);
+	REQUIRE(parent.pairCount == 2);
+	REQUIRE(parent.distinctLeftCount == 1);
+	REQUIRE(parent.distinctRightCount == 2);
+	REQUIRE(parent.outDegreeHistogram == map<int, int>({ {2, 1} }));
+
+	REQUIRE(statistics->getRelationStatistics(RelationshipType::FOLLOWS).pairCount == 3);
+	REQUIRE(statistics->getRelationStatistics(RelationshipType::USES).pairCount == 3);
+	REQUIRE(statistics->getProcRelationStatistics(RelationshipType::USES).pairCount == 2);
+	REQUIRE(statistics->getRelationStatistics(RelationshipType::AFFECTS).pairCount == 0);
+
+	shared_ptr<Declaration> s = make_shared<Declaration>(EntityType::STMT, "s");
+	shared_ptr<Declaration> a = make_shared<Declaration>(EntityType::ASSIGN, "a");
+	shared_ptr<Declaration> v = make_shared<Declaration>(EntityType::VAR, "v");
+	shared_ptr<Declaration> p = make_shared<Declaration>(EntityType::PROC, "p");
+
+	REQUIRE(statistics->estimateResultSize(RelationshipType::PARENT, s, s) == 2);
+	REQUIRE(statistics->estimateResultSize(RelationshipType::USES, a, v) == 1.5);
+	REQUIRE(statistics->estimateResultSize(RelationshipType::USES, p, v) == 2);
+	REQUIRE(statistics->estimateResultSize(RelationshipType::PARENT, make_shared<StmtNum>(2), s) == 2);
+	REQUIRE(statistics->estimateResultSize(RelationshipType::PARENT, make_shared<Any>(), s) == 2);
+	REQUIRE(statistics->estimateResultSize(RelationshipType::AFFECTS, make_shared<Any>(), make_shared<Any>()) == 0);
+}
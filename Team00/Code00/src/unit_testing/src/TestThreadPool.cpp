@@ -0,0 +1,20 @@
+#include "ThreadPool.h"
+#include "catch.hpp"
+#include <atomic>
+
+TEST_CASE("ThreadPool runs every submitted task") {
+	ThreadPool pool(4);
+	REQUIRE(pool.getThreadCount() == 4);
+
+	atomic<int> sum(0);
+	for (int i = 1; i <= 100; i++) {
+		pool.submit([&sum, i]() { sum += i; });
+	}
+	pool.waitAll();
+	REQUIRE(sum == 5050);
+
+	// the pool can be reused after waiting
+	pool.submit([&sum]() { sum = 0; });
+	pool.waitAll();
+	REQUIRE(sum == 0);
+}
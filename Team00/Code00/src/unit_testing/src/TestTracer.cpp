@@ -0,0 +1,63 @@
+#include "Tracer.h"
+#include "catch.hpp"
+#include <sstream>
+#include <thread>
+
+TEST_CASE("Tracer records scopes as Chrome trace events") {
+	Tracer::clear();
+	{
+		TraceScope outer("outer");
+		{
+			TraceScope inner("inner");
+			vector<int> values(1 << 16, 1);
+			this_thread::sleep_for(chrono::milliseconds(2));
+		}
+	}
+
+	vector<TraceEvent> events = Tracer::getEvents();
+	REQUIRE(events.size() == 2);
+	REQUIRE(string(events[0].name) == "inner"); // recorded when the scope ends
+	REQUIRE(string(events[1].name) == "outer");
+	REQUIRE(events[0].durationMicros >= 2000);
+	REQUIRE(events[1].startMicros <= events[0].startMicros);
+	REQUIRE(events[1].durationMicros >= events[0].durationMicros);
+	if (Tracer::isEnabled()) {
+		REQUIRE(events[0].allocationCount >= 1);
+		REQUIRE(events[0].allocatedBytes >= (long long) ((1 << 16) * sizeof(int)));
+	}
+
+	ostringstream out;
+	Tracer::writeChromeTrace(out);
+	string trace = out.str();
+	REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+	REQUIRE(trace.find("\"name\":\"inner\",\"cat\":\"spa\",\"ph\":\"X\"") != string::npos);
+	REQUIRE(trace.find("\"name\":\"outer\"") != string::npos);
+	REQUIRE(trace.find("\"allocatedBytes\":") != string::npos);
+
+	SECTION("The scope macro only records in tracing builds") {
+		Tracer::clear();
+		{
+			SPA_TRACE_SCOPE("macro");
+		}
+		REQUIRE(Tracer::getEvents().size() == (Tracer::isEnabled() ? 1 : 0));
+	}
+
+	Tracer::clear();
+}
+
+TEST_CASE("Tracer keeps only the latest events") {
+	Tracer::clear();
+	const char* names[] = { "first", "second", "third", "fourth" };
+	for (size_t i = 0; i < Tracer::MAX_EVENT_COUNT + 3; i++) {
+		Tracer::record({ names[i % 4], (long long) i, 0, 0, 0, 0, 0 });
+	}
+
+	vector<TraceEvent> events = Tracer::getEvents();
+	REQUIRE(events.size() == Tracer::MAX_EVENT_COUNT);
+	REQUIRE(events.front().startMicros == 3);
+	REQUIRE(string(events.front().name) == "fourth");
+	REQUIRE(events.back().startMicros == (long long) Tracer::MAX_EVENT_COUNT + 2);
+
+	Tracer::clear();
+	REQUIRE(Tracer::getEvents().empty());
+}